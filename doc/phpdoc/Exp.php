@@ -0,0 +1,171 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Exp builds filter expressions, which the server evaluates on each
+ * record before a command applies to it. Pass one as \Aerospike::OPT_FILTER_EXP in
+ * the options of a get, put, operate, remove, batch, scan or query.
+ *
+ * ```php
+ * use Aerospike\Exp;
+ *
+ * $adults = Exp::and(Exp::ge(Exp::intBin('age'), 18), Exp::binExists('email'));
+ * $client->scan('test', 'users', function ($record) { ... }, [], [Aerospike::OPT_FILTER_EXP => $adults]);
+ * ```
+ *
+ * Expressions are immutable. PHP integers, floats, strings, booleans and NULL
+ * may be given wherever an expression is expected, as the matching value. An
+ * expression is compiled the first time it is used, later commands reuse it.
+ * Invalid operands raise a warning and return NULL.
+ *
+ * Expressions cannot be constructed with new, cloned or serialized.
+ */
+final class Exp
+{
+    const REGEX_NONE = 0;
+    const REGEX_EXTENDED = 1;
+    const REGEX_ICASE = 2;
+    const REGEX_NOSUB = 4;
+    const REGEX_NEWLINE = 8;
+
+    private function __construct() {}
+
+    /** @return Exp */
+    public static function int(int $value) {}
+    /** @return Exp */
+    public static function float(float $value) {}
+    /** @return Exp */
+    public static function str(string $value) {}
+    /** @return Exp */
+    public static function bool(bool $value) {}
+    /**
+     * A blob value, to compare with blobBin()
+     * @return Exp
+     */
+    public static function bytes(string $value) {}
+    /** @return Exp */
+    public static function nil() {}
+
+    /**
+     * The value of a bin. The record is rejected if the bin does not hold that type.
+     * @return Exp
+     */
+    public static function intBin(string $bin) {}
+    /** @return Exp */
+    public static function floatBin(string $bin) {}
+    /** @return Exp */
+    public static function strBin(string $bin) {}
+    /** @return Exp */
+    public static function blobBin(string $bin) {}
+    /** @return Exp */
+    public static function listBin(string $bin) {}
+    /** @return Exp */
+    public static function mapBin(string $bin) {}
+    /** @return Exp */
+    public static function geoBin(string $bin) {}
+    /** @return Exp */
+    public static function hllBin(string $bin) {}
+    /** @return Exp */
+    public static function binExists(string $bin) {}
+    /**
+     * The particle type of the bin, 0 if the record has no such bin
+     * @return Exp
+     */
+    public static function binType(string $bin) {}
+
+    /**
+     * The key of the record, only there if it was stored with \Aerospike::POLICY_KEY_SEND
+     * @return Exp
+     */
+    public static function keyInt() {}
+    /** @return Exp */
+    public static function keyStr() {}
+    /** @return Exp */
+    public static function keyBlob() {}
+    /** @return Exp */
+    public static function keyExists() {}
+    /** @return Exp */
+    public static function setName() {}
+    /** @return Exp */
+    public static function deviceSize() {}
+    /**
+     * Time of the last update, in nanoseconds since the Unix epoch
+     * @return Exp
+     */
+    public static function lastUpdate() {}
+    /**
+     * Milliseconds since the last update
+     * @return Exp
+     */
+    public static function sinceUpdate() {}
+    /** @return Exp */
+    public static function voidTime() {}
+    /** @return Exp */
+    public static function ttl() {}
+    /** @return Exp */
+    public static function isTombstone() {}
+    /**
+     * The digest of the key modulo *modulo*, to sample a fraction of the records
+     * @return Exp
+     */
+    public static function digestModulo(int $modulo) {}
+
+    /** @return Exp */
+    public static function eq($left, $right) {}
+    /** @return Exp */
+    public static function ne($left, $right) {}
+    /** @return Exp */
+    public static function gt($left, $right) {}
+    /** @return Exp */
+    public static function ge($left, $right) {}
+    /** @return Exp */
+    public static function lt($left, $right) {}
+    /** @return Exp */
+    public static function le($left, $right) {}
+    /**
+     * True if the string expression matches *regex*
+     * @param string $regex
+     * @param Exp|string $exp
+     * @param int $flags a combination of the Exp::REGEX_* flags
+     * @return Exp
+     */
+    public static function regex(string $regex, $exp, int $flags = self::REGEX_NONE) {}
+    /**
+     * True if the GeoJSON regions or points intersect
+     * @return Exp
+     */
+    public static function geoCompare($left, $right) {}
+
+    /** @return Exp */
+    public static function not($exp) {}
+    /** @return Exp */
+    public static function and(...$exps) {}
+    /** @return Exp */
+    public static function or(...$exps) {}
+    /**
+     * True if exactly one of the expressions is
+     * @return Exp
+     */
+    public static function exclusive(...$exps) {}
+}
@@ -0,0 +1,76 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Future is the pending result of an asynchronous command such as
+ * Aerospike::getAsync(). It cannot be constructed, cloned or serialized.
+ *
+ * Dropping a future before it completes is safe, the command runs to its end
+ * and its result is discarded.
+ *
+ * @see \Aerospike::getAsync()
+ * @see \Aerospike::awaitAll()
+ */
+final class Future
+{
+    private function __construct() {}
+
+    /**
+     * Whether the command has completed. Never blocks.
+     *
+     * @return bool
+     */
+    public function isReady() {}
+
+    /**
+     * Wait for the command to complete.
+     *
+     * *$result* is an array of `['key', 'metadata', 'bins', 'result']` as described
+     * in \Aerospike::awaitAll(). It is built once, later calls return the same value.
+     *
+     * @param array $result a pass-by-reference variable which will hold the result
+     * @param int $timeout_ms maximum time to wait in milliseconds, 0 waits until completion
+     * @return int The status of the command, or \Aerospike::ERR_TIMEOUT if the timeout passed first,
+     * in which case *$result* is NULL and the future may be waited for again.
+     */
+    public function wait(&$result, $timeout_ms = 0) {}
+
+    /**
+     * Register a callback to be run by \Aerospike::poll() once the command completed.
+     *
+     * The future is kept alive until the callback has run, so it does not need to be stored.
+     * Registering again replaces the callback, and once it has run a new registration runs it
+     * on the next poll(). Callbacks which did not run by the end of the request are dropped.
+     *
+     * ```php
+     * $client->getAsync($key)->onComplete(function (array $result, $status) {
+     *     // $result is the same array as returned by wait()
+     * });
+     * ```
+     * @param callable $callback function (array $result, int $status)
+     * @see \Aerospike::completionStream()
+     * @return int \Aerospike::OK, or \Aerospike::ERR_PARAM if *$callback* is not callable
+     */
+    public function onComplete($callback) {}
+}
@@ -0,0 +1,70 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Operations is a list of operations, in the format of
+ * \Aerospike::operate(), validated and converted once. operate(), operateOrdered()
+ * and \Aerospike\Pipeline::operate() accept one in place of the array.
+ *
+ * An operation may take its *val* from a value bound on each call: give it a
+ * *param* entry, the position of the value in the array passed to bind().
+ *
+ * ```php
+ * use Aerospike\Operations;
+ *
+ * $hit = Operations::compile([
+ *     ["op" => Aerospike::OPERATOR_INCR, "bin" => "hits", "param" => 0],
+ *     ["op" => Aerospike::OPERATOR_WRITE, "bin" => "last_seen", "param" => 1],
+ *     ["op" => Aerospike::OP_LIST_SIZE, "bin" => "pages"],
+ *     ["op" => Aerospike::OPERATOR_READ, "bin" => "hits"],
+ * ]);
+ * $client->operate($key, $hit->bind([1, time()]), $returned);
+ * ```
+ *
+ * Operations without a param are converted, and packed for the list, map, bit
+ * and HyperLogLog operations, by compile(). Calls share them. Operations with a
+ * param are converted on each call, with their bound value.
+ *
+ * Operations are immutable and cannot be constructed with new, cloned or serialized.
+ */
+final class Operations
+{
+    private function __construct() {}
+
+    /**
+     * Compile the operations. The values of the operations without a param are
+     * serialized with the Aerospike::OPT_SERIALIZER of the options, if given.
+     * Returns null with a warning if an operation is invalid.
+     * @return Operations
+     */
+    public static function compile(array $operations, array $options = []) {}
+
+    /**
+     * The operations with the values of their params. The values of bound
+     * operations may be replaced by binding them again. Returns null with a
+     * warning if a value is missing, an invalid value fails the command.
+     * @return Operations
+     */
+    public function bind(array $params) {}
+}
@@ -0,0 +1,95 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Pipeline sends single record commands back to back on pipelined
+ * connections, and returns their results in order on flush(). It is created by
+ * \Aerospike::pipeline() and cannot be constructed, cloned or serialized.
+ *
+ * Every command method sends the command immediately and returns
+ * \Aerospike::OK, or the error which prevented it from being sent, in which case
+ * it is not part of the results and the error is also set on the client.
+ * The outcome of each command is only known after flush().
+ *
+ * @see \Aerospike::pipeline()
+ */
+final class Pipeline
+{
+    private function __construct() {}
+
+    /**
+     * Send a write, as \Aerospike::put()
+     *
+     * @param array $key
+     * @param array $bins
+     * @param int $ttl
+     * @param array $options
+     * @return int
+     */
+    public function put(array $key, array $bins, $ttl = 0, array $options = []) {}
+
+    /**
+     * Send a read, as \Aerospike::get()
+     *
+     * @param array $key
+     * @param array $select only these bins out of the record (optional)
+     * @param array $options
+     * @return int
+     */
+    public function get(array $key, array $select = null, array $options = []) {}
+
+    /**
+     * Send an operate, as \Aerospike::operate(). The returned bins are in the
+     * *bins* of its result.
+     *
+     * @param array $key
+     * @param array|\Aerospike\Operations $operations
+     * @param array $options
+     * @return int
+     */
+    public function operate(array $key, $operations, array $options = []) {}
+
+    /**
+     * Send a remove, as \Aerospike::remove()
+     *
+     * @param array $key
+     * @param array $options
+     * @return int
+     */
+    public function remove(array $key, array $options = []) {}
+
+    /**
+     * Wait for every command sent since the last flush.
+     *
+     * *$results* is a list in the order the commands were issued, each entry an array
+     * of `['key', 'metadata', 'bins', 'result']` as described in \Aerospike::awaitAll().
+     * The pipeline is empty afterwards.
+     *
+     * @param array $results a pass-by-reference variable which will hold the results
+     * @param int $timeout_ms maximum time to wait in milliseconds, 0 waits until all complete.
+     * Commands still pending at the deadline get *result* \Aerospike::ERR_TIMEOUT and their outcome is dropped.
+     * @return int \Aerospike::OK, or \Aerospike::ERR_TIMEOUT if the timeout passed first
+     */
+    public function flush(&$results, $timeout_ms = 0) {}
+}
@@ -0,0 +1,77 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Policy is an options array prepared for reuse. Every method of
+ * \Aerospike taking an array of options accepts a policy in its place.
+ *
+ * ```php
+ * use Aerospike\Policy;
+ *
+ * $fast_read = Policy::create([Aerospike::OPT_TOTAL_TIMEOUT => 50, Aerospike::OPT_MAX_RETRIES => 0]);
+ * foreach ($keys as $key) {
+ *     $client->get($key, $record, [], $fast_read);
+ * }
+ * ```
+ *
+ * An options array is parsed and merged with the client defaults on each call.
+ * A policy is merged once for each kind of command and each set of defaults it
+ * is used with, those of a client or of one of its OPT_POLICY_PROFILES, later
+ * calls copy the result. The results are kept for the last 4 clients using the
+ * policy. Its OPT_SERIALIZER, OPT_POLICY_GEN generation and OPT_TTL are
+ * read when it is created.
+ *
+ * Policies are immutable and cannot be constructed with new, cloned or serialized.
+ */
+final class Policy
+{
+    private function __construct() {}
+
+    /**
+     * A policy holding the options, null if the serializer, generation or ttl
+     * option has an invalid value, with Policy::errorno() set to
+     * Aerospike::ERR_PARAM. Other invalid options are reported by the commands
+     * using the policy, as with an array.
+     * @return Policy
+     */
+    public static function create(array $options) {}
+
+    /**
+     * The options the policy was created from
+     * @return array
+     */
+    public function options() {}
+
+    /**
+     * The error message of the last call to create(), empty if it succeeded
+     * @return string
+     */
+    public static function error() {}
+
+    /**
+     * The status code of the last call to create(), Aerospike::OK if it succeeded
+     * @return int
+     */
+    public static function errorno() {}
+}
@@ -0,0 +1,67 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Query is a query prepared by \Aerospike::prepareQuery(), to run repeatedly
+ * with a new value for its *where* predicate each time. It cannot be constructed, cloned or
+ * serialized.
+ *
+ * The query runs with the client which prepared it, and its errors are set on that client.
+ *
+ * @see \Aerospike::prepareQuery()
+ * @see \Aerospike::query()
+ */
+final class Query
+{
+    private function __construct() {}
+
+    /**
+     * Run the query, passing each matching record to the callback as \Aerospike::query() does
+     *
+     * ```php
+     * $query = $client->prepareQuery('test', 'users', Aerospike::predicateEquals('age', 0),
+     *     [], [Aerospike::OPT_MAX_RECORDS => 100]);
+     * $cursor = null;
+     * do {
+     *     $status = $query->execute(function ($record) {
+     *         var_dump($record['bins']);
+     *     }, 30, $cursor);
+     * } while ($status === Aerospike::OK && $cursor !== null);
+     * ```
+     * @param callable $record_cb A callback function invoked for each record streaming back from the cluster
+     * @param mixed    $val the value of the predicate, in the form its *val* entry takes.
+     *                      NULL for the value the query was prepared with.
+     * @param string   $cursor the page to return, NULL for the first one. Set to the next page, NULL after the last one.
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function execute(callable $record_cb, $val = null, &$cursor = null) {}
+
+    /**
+     * Iterate over the records matching the predicate, as \Aerospike::queryIterator() does
+     *
+     * @param mixed $val the value of the predicate, NULL for the value the query was prepared with
+     * @return \Aerospike\RecordIterator|null NULL if the query could not be set up
+     */
+    public function iterator($val = null) {}
+}
@@ -0,0 +1,76 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\RecordIterator walks the records of a scan or query, as returned by
+ * \Aerospike::scanIterator() and \Aerospike::queryIterator(). It cannot be constructed,
+ * cloned or serialized, and can only be iterated once.
+ *
+ * Dropping the iterator, or leaving a foreach over it, stops the scan or query.
+ * The client must stay open while iterating.
+ *
+ * @see \Aerospike::scanIterator()
+ * @see \Aerospike::queryIterator()
+ */
+final class RecordIterator implements \Iterator
+{
+    private function __construct() {}
+
+    /**
+     * Start the scan or query and wait for its first record. Later calls do nothing.
+     *
+     * @return void
+     */
+    public function rewind() {}
+
+    /**
+     * Whether there is a current record. Once false, any error of the scan or query is
+     * set on the client.
+     *
+     * @return bool
+     */
+    public function valid() {}
+
+    /**
+     * The current record, an array of `['key', 'metadata', 'bins']` like those passed to the
+     * callback of \Aerospike::scan()
+     *
+     * @return array|null
+     */
+    public function current() {}
+
+    /**
+     * The position of the current record, starting at 0
+     *
+     * @return int|null
+     */
+    public function key() {}
+
+    /**
+     * Move to the next record, waiting for the cluster if none is buffered yet
+     *
+     * @return void
+     */
+    public function next() {}
+}
@@ -0,0 +1,71 @@
+<?php
+/**
+ * Copyright 2013-2016 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @category   Database
+ * @copyright  Copyright 2013-2016 Aerospike, Inc.
+ * @license    http://www.apache.org/licenses/LICENSE-2.0 Apache License, Version 2
+ * @filesource
+ */
+
+namespace Aerospike;
+
+/**
+ * \Aerospike\Scan is a scan prepared by \Aerospike::prepareScan(), to run repeatedly.
+ * It cannot be constructed, cloned or serialized.
+ *
+ * The scan runs with the client which prepared it, and its errors are set on that client.
+ *
+ * @see \Aerospike::prepareScan()
+ * @see \Aerospike::scan()
+ */
+final class Scan
+{
+    private function __construct() {}
+
+    /**
+     * Run the scan, passing each record of the set to the callback as \Aerospike::scan() does
+     *
+     * @param callable $record_cb A callback function invoked for each record streaming back from the cluster
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function execute(callable $record_cb) {}
+
+    /**
+     * Run the scan over some partitions, as \Aerospike::scanPartitions() does
+     *
+     * ```php
+     * $scan = $client->prepareScan('test', 'users');
+     * $cursor = load_checkpoint($worker_id); // null on the first run
+     * $status = $scan->partitions(0, 4096, function ($record) {
+     *     process($record);
+     * }, $cursor);
+     * save_checkpoint($worker_id, $cursor);
+     * ```
+     * @param int      $begin the first partition, from 0 to 4095
+     * @param int      $count the number of partitions
+     * @param callable $record_cb A callback function invoked for each record streaming back from the cluster
+     * @param string   $cursor the progress to resume from, null to start over. Set to the progress of the scan.
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function partitions(int $begin, int $count, callable $record_cb, &$cursor = null) {}
+
+    /**
+     * Iterate over the records of the set, as \Aerospike::scanIterator() does
+     *
+     * @return \Aerospike\RecordIterator|null NULL if the scan could not be set up
+     */
+    public function iterator() {}
+}
@@ -63,9 +63,18 @@
  * aerospike.compression_threshold = 0;
  * // Max size of the synchronous connection pool for each server node
  * aerospike.max_threads = 300;
+ * // Connections opened to each server node as soon as the client finds it, and kept
+ * // open by the cluster tender. Set proto-fd-idle-ms of the server to 0 with it.
+ * aerospike.min_conns_per_node = 0;
+ * // Seconds after which the connection of a persistent client no object uses any
+ * // more is closed, checked when a persistent client is created. 0 never closes them.
+ * aerospike.persistent.max_idle = 0;
  * // Number of threads stored in underlying thread pool that is used in
- * // batch/scan/query commands. In ZTS builds, this is always 0.
+ * // batch/scan/query commands.
  * aerospike.thread_pool_size = 16;
+ * // Number of C client event loops created for the async commands such as getAsync().
+ * // 0 disables them. The C client must be built with an event library (libev, libuv or libevent).
+ * aerospike.async.event_loops = 0;
  * // When turning on the optional logging in the client, this is the path to the log file.
  * aerospike.log_path = NULL;
  * aerospike.log_level = NULL;
@@ -118,6 +127,9 @@ class Aerospike {
      * * _port_ the port of the node
      * * _user_ **required** for the Enterprise Edition
      * * _pass_ **required** for the Enterprise Edition
+     * * _auth\_mode_ how the user is authenticated, one of Aerospike::AUTH\_INTERNAL (default),
+     *       Aerospike::AUTH\_EXTERNAL or Aerospike::AUTH\_EXTERNAL\_INSECURE
+     * * _login\_timeout_ milliseconds to wait for a login to a node (default: 5000)
      * * _shm_ optional. Shared-memory cluster tending is enabled if an array
      *     (even an empty one) is provided. Disabled by default.
      * * _shm\_key_ explicitly sets the shm key for the cluster. It is
@@ -129,7 +141,10 @@ class Aerospike {
      * * _shm\_takeover\_threshold\_sec_ take over tending if the cluster
      *       hasn't been checked for this many seconds (default: 30)
      * * _max\_threads_ (default: 300)
-     * * _thread\_pool\_size_ should be at least the number of nodes in the cluster (default: 16) In ZTS builds this is set to 0
+     * * _min\_conns\_per\_node_ connections opened to each node as soon as the
+     *       client connects, then kept open by the cluster tender in the
+     *       background. Server proto-fd-idle-ms should be 0 when set. (default: 0)
+     * * _thread\_pool\_size_ should be at least the number of nodes in the cluster (default: 16)
      * * _compression\_threshold_ client will compress records larger than this value for transport (default: 0)
      * * _tender\_interval_ polling interval in milliseconds for cluster tender (default: 1000)
      * * _cluster\_name_ if specified, only server nodes matching this name will be used when determining the cluster
@@ -182,6 +197,7 @@ class Aerospike {
      * * Aerospike::OPT_QUERY_DEFAULT_POL An array of default policies for query operations.
      * * Aerospike::OPT_SCAN_DEFAULT_POL An array of default policies for scan operations.
      * * Aerospike::OPT_APPLY_DEFAULT_POL An array of default policies for apply operations.
+     * * Aerospike::OPT_POLICY_PROFILES Defaults of the records of a namespace or set, overriding the ones above.
      * @see Aerospike::OPT_CONNECT_TIMEOUT Aerospike::OPT_CONNECT_TIMEOUT options
      * @see Aerospike::OPT_READ_TIMEOUT Aerospike::OPT_READ_TIMEOUT options
      * @see Aerospike::OPT_WRITE_TIMEOUT Aerospike::OPT_WRITE_TIMEOUT options
@@ -267,6 +283,63 @@ class Aerospike {
      */
     public function shmKey() {}
 
+    /**
+     * Describe the persistent cluster connections held by this process
+     *
+     * Persistent clients share a cluster connection when every setting of
+     * their config, options and INI is the same, so clients constructed with
+     * different options get connections of their own.
+     * ```php
+     * $client = new Aerospike($config, true);
+     * var_dump(Aerospike::persistentStats());
+     * ```
+     * ```
+     * array(1) {
+     *   [0]=>
+     *   array(7) {
+     *     ["hosts"]=>
+     *     string(14) "127.0.0.1:3000"
+     *     ["user"]=>
+     *     string(0) ""
+     *     ["is_connected"]=>
+     *     bool(true)
+     *     ["ref_cnt"]=>
+     *     int(1)
+     *     ["conn_cnt"]=>
+     *     int(4)
+     *     ["age"]=>
+     *     int(120)
+     *     ["last_used"]=>
+     *     int(1760000000)
+     *     ["min_conns_per_node"]=>
+     *     int(8)
+     *     ["max_conns_per_node"]=>
+     *     int(300)
+     *     ["nodes"]=>
+     *     array(1) {
+     *       [0]=>
+     *       array(3) {
+     *         ["name"]=>
+     *         string(15) "BB9020011AC4202"
+     *         ["in_pool"]=>
+     *         int(7)
+     *         ["in_use"]=>
+     *         int(1)
+     *       }
+     *     }
+     *   }
+     * }
+     * ```
+     * `ref_cnt` is the number of clients using the connection now, `conn_cnt`
+     * the number of clients which used it since it was opened `age` seconds
+     * ago, and `last_used` the time a client last started or stopped using it.
+     * `nodes` holds the fill level of the connection pool of each node of a
+     * connected cluster, its idle connections and the ones in use.
+     * @see Aerospike::__construct() __construct()
+     * @return array
+     */
+    public static function persistentStats() {}
+
     /**
      * Return the error message associated with the last operation.
      *
@@ -1089,12 +1162,12 @@ class Aerospike {
      * @link https://www.aerospike.com/docs/client/c/usage/kvs/write.html#change-record-time-to-live-ttl Time-to-live
      * @link https://www.aerospike.com/docs/guide/glossary.html Glossary
      * @param array $key The key identifying the record. An array with keys `['ns','set','key']` or `['ns','set','digest']`
-     * @param array $operations The array of of one or more per-bin operations conforming to the following structure:
+     * @param array|\Aerospike\Operations $operations The array of of one or more per-bin operations, or a template of them compiled by \Aerospike\Operations::compile(), conforming to the following structure:
      * ```
      * Write Operation:
      *   op => Aerospike::OPERATOR_WRITE
      *   bin => bin name (cannot be longer than 14 characters)
-     *   val => the value to store in the bin
+     *   val => the value to store in the bin, null removes the bin
      *
      * Increment Operation:
      *   op => Aerospike::OPERATOR_INCR
@@ -1199,6 +1272,40 @@ class Aerospike {
      *   op => Aerospike::OP_LIST_SIZE, # returns a value
      *   bin =>  "events" # gets the size of a list contained in the bin
      *
+     * List write operations (append, merge, insert, insert items, set) may take a list policy:
+     *   list_policy => [Aerospike::OPT_LIST_ORDER => Aerospike::AS_LIST_ORDERED,
+     *                   Aerospike::OPT_LIST_WRITE_FLAGS => Aerospike::AS_LIST_WRITE_ADD_UNIQUE]
+     *
+     * List Set Order operation
+     *   op => Aerospike::OP_LIST_SET_ORDER,
+     *   bin => "scores",
+     *   list_policy => [Aerospike::OPT_LIST_ORDER => Aerospike::AS_LIST_ORDERED]
+     *
+     * List Sort operation
+     *   op => Aerospike::OP_LIST_SORT,
+     *   bin => "scores",
+     *   sort_flags => Aerospike::AS_LIST_SORT_DROP_DUPLICATES # optional
+     *
+     * List Increment operation
+     *   op => Aerospike::OP_LIST_INCREMENT,
+     *   bin => "scores",
+     *   index => 2,
+     *   val => 10
+     *
+     * List Get/Remove by Index, Index Range, Rank and Rank Range operations
+     *   op => Aerospike::OP_LIST_GET_BY_RANK_RANGE, # or OP_LIST_REMOVE_BY_RANK_RANGE, ...
+     *   bin => "scores",
+     *   rank => -10, # or index => 0 for the index operations
+     *   count => 10, # the range operations only
+     *   return_type => Aerospike::LIST_RETURN_VALUE # the top 10 scores
+     *
+     * List Get/Remove by Value, Value List and Value Range operations
+     *   op => Aerospike::OP_LIST_REMOVE_BY_VALUE_RANGE, # or OP_LIST_GET_BY_VALUE, ...
+     *   bin => "scores",
+     *   val => 0, # a list of values for the value list operations
+     *   range_end => 50, # optional for the value range operations, the largest value if absent
+     *   return_type => Aerospike::LIST_RETURN_COUNT
+     *
      *
      * Map operations
      *
@@ -1294,6 +1401,18 @@ class Aerospike {
      *   bin => "bin_name",
      *   return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
      *
+     * Map Get by Key list operation
+     *   op => AEROSPIKE::OP_MAP_GET_BY_KEY_LIST ,
+     *   bin => "bin_name",
+     *   key => ["key1", 2, "key3"],
+     *   return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
+     *
+     * Map Get by Value list operation
+     *   op => AEROSPIKE::OP_MAP_GET_BY_VALUE_LIST ,
+     *   bin => "bin_name",
+     *   val => ["value1", 2, "value3"],
+     *   return_type => AEROSPIKE::MAP_RETURN_KEY
+     *
      * Map Put operation
      *   op => AEROSPIKE::OP_MAP_PUT ,
      *   bin => "bin_name",
@@ -1384,6 +1503,75 @@ class Aerospike {
      *   rank => -1,
      *   count => return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
      *
+     * Bit operations, on bytes bins. Offsets and sizes are in bits, negative offsets count from the end
+     *   bit_policy => [Aerospike::OPT_BIT_WRITE_FLAGS => Aerospike::AS_BIT_WRITE_UPDATE_ONLY] # optional
+     *
+     * Bit Set, Or, Xor and And operations
+     *   op => Aerospike::OP_BIT_OR, # or OP_BIT_SET, OP_BIT_XOR, OP_BIT_AND
+     *   bin => "flags",
+     *   bit_offset => 12,
+     *   bit_size => 1,
+     *   val => new Aerospike\Bytes("\x80") # the bits to apply, from the first one
+     *
+     * Bit Not, Get and Count operations
+     *   op => Aerospike::OP_BIT_COUNT, # or OP_BIT_NOT, OP_BIT_GET
+     *   bin => "flags",
+     *   bit_offset => 0,
+     *   bit_size => 64
+     *
+     * Bit Lscan and Rscan operations, the position of the first bit set to val
+     *   op => Aerospike::OP_BIT_LSCAN,
+     *   bin => "flags",
+     *   bit_offset => 0,
+     *   bit_size => 64,
+     *   val => true
+     *
+     * Bit Add, Subtract, Set Int, Get Int, Lshift and Rshift operations
+     *   op => Aerospike::OP_BIT_ADD, # or OP_BIT_SUBTRACT, OP_BIT_SET_INT, OP_BIT_GET_INT, OP_BIT_LSHIFT, OP_BIT_RSHIFT
+     *   bin => "counters",
+     *   bit_offset => 8,
+     *   bit_size => 16,
+     *   val => 1, # the shift of OP_BIT_LSHIFT and OP_BIT_RSHIFT, none for OP_BIT_GET_INT
+     *   signed => false, # add, subtract and get int
+     *   overflow_action => Aerospike::AS_BIT_OVERFLOW_SATURATE # add and subtract
+     *
+     * Bit Resize, Insert and Remove operations, on whole bytes
+     *   op => Aerospike::OP_BIT_INSERT, # or OP_BIT_RESIZE, OP_BIT_REMOVE
+     *   bin => "flags",
+     *   byte_offset => 0, # insert and remove
+     *   byte_size => 4, # resize and remove
+     *   val => new Aerospike\Bytes("\x00\x00"), # insert
+     *   resize_flags => Aerospike::AS_BIT_RESIZE_FROM_FRONT # resize
+     *
+     * HyperLogLog operations, on HLL bins estimating the number of distinct values added to them
+     *   hll_policy => [Aerospike::OPT_HLL_WRITE_FLAGS => Aerospike::AS_HLL_WRITE_CREATE_ONLY] # optional
+     *
+     * HLL Init and Add operations, add creates the bin if needed
+     *   op => Aerospike::OP_HLL_ADD, # or OP_HLL_INIT
+     *   bin => "visitors",
+     *   val => ["user1", "user2"], # add
+     *   index_bit_count => 12, # 4 to 16, -1 keeps that of an existing bin
+     *   minhash_bit_count => 0 # optional, needed by OP_HLL_GET_SIMILARITY and OP_HLL_GET_INTERSECT_COUNT
+     *
+     * HLL Get Count, Refresh Count, Describe and Fold operations
+     *   op => Aerospike::OP_HLL_GET_COUNT, # or OP_HLL_REFRESH_COUNT, OP_HLL_DESCRIBE, OP_HLL_FOLD
+     *   bin => "visitors",
+     *   index_bit_count => 8 # fold
+     *
+     * HLL Get Union, Get Union Count, Get Intersect Count, Get Similarity and Set Union operations
+     *   op => Aerospike::OP_HLL_GET_UNION_COUNT, # or OP_HLL_GET_UNION, OP_HLL_GET_INTERSECT_COUNT, OP_HLL_GET_SIMILARITY, OP_HLL_SET_UNION
+     *   bin => "visitors",
+     *   val => [$hll] # Aerospike\Bytes HLLs, as read from HLL bins or returned by OP_HLL_GET_UNION
+     *
+     * Any list, map, bit or HLL operation may take a ctx, the path from the bin down to the nested
+     * element it works on. Each step is a pair of a CDT_CTX_* type and its value.
+     * The element is read or written in place on the server.
+     *   op => AEROSPIKE::OP_LIST_SET,
+     *   bin => "profile",
+     *   ctx => [[AEROSPIKE::CDT_CTX_MAP_KEY, "settings"], [AEROSPIKE::CDT_CTX_MAP_KEY, "notifications"]],
+     *   index => 3,
+     *   val => "off"
+     *
      *
      *
      * ```
@@ -1424,7 +1612,7 @@ class Aerospike {
      * @see Aerospike::OPERATOR_WRITE Aerospike::OPERATOR_WRITE and other operators
      * @return int The status code of the operation. Compare to the Aerospike class status constants.
      */
-    public function operate(array $key, array $operations, &$returned, array $options = []) {}
+    public function operate(array $key, $operations, &$returned, array $options = []) {}
 
     /**
      *  Perform multiple bin operations on a record with a given key, with write operations happening before read ones.
@@ -1468,12 +1656,12 @@ class Aerospike {
      * @link https://www.aerospike.com/docs/client/c/usage/kvs/write.html#change-record-time-to-live-ttl Time-to-live
      * @link https://www.aerospike.com/docs/guide/glossary.html Glossary
      * @param array $key The key identifying the record. An array with keys `['ns','set','key']` or `['ns','set','digest']`
-     * @param array $operations The array of of one or more per-bin operations conforming to the following structure:
+     * @param array|\Aerospike\Operations $operations The array of of one or more per-bin operations, or a template of them compiled by \Aerospike\Operations::compile(), conforming to the following structure:
      * ```
      * Write Operation:
      *   op => Aerospike::OPERATOR_WRITE
      *   bin => bin name (cannot be longer than 14 characters)
-     *   val => the value to store in the bin
+     *   val => the value to store in the bin, null removes the bin
      *
      * Increment Operation:
      *   op => Aerospike::OPERATOR_INCR
@@ -1578,6 +1766,40 @@ class Aerospike {
      *   op => Aerospike::OP_LIST_SIZE, # returns a value
      *   bin =>  "events" # gets the size of a list contained in the bin
      *
+     * List write operations (append, merge, insert, insert items, set) may take a list policy:
+     *   list_policy => [Aerospike::OPT_LIST_ORDER => Aerospike::AS_LIST_ORDERED,
+     *                   Aerospike::OPT_LIST_WRITE_FLAGS => Aerospike::AS_LIST_WRITE_ADD_UNIQUE]
+     *
+     * List Set Order operation
+     *   op => Aerospike::OP_LIST_SET_ORDER,
+     *   bin => "scores",
+     *   list_policy => [Aerospike::OPT_LIST_ORDER => Aerospike::AS_LIST_ORDERED]
+     *
+     * List Sort operation
+     *   op => Aerospike::OP_LIST_SORT,
+     *   bin => "scores",
+     *   sort_flags => Aerospike::AS_LIST_SORT_DROP_DUPLICATES # optional
+     *
+     * List Increment operation
+     *   op => Aerospike::OP_LIST_INCREMENT,
+     *   bin => "scores",
+     *   index => 2,
+     *   val => 10
+     *
+     * List Get/Remove by Index, Index Range, Rank and Rank Range operations
+     *   op => Aerospike::OP_LIST_GET_BY_RANK_RANGE, # or OP_LIST_REMOVE_BY_RANK_RANGE, ...
+     *   bin => "scores",
+     *   rank => -10, # or index => 0 for the index operations
+     *   count => 10, # the range operations only
+     *   return_type => Aerospike::LIST_RETURN_VALUE # the top 10 scores
+     *
+     * List Get/Remove by Value, Value List and Value Range operations
+     *   op => Aerospike::OP_LIST_REMOVE_BY_VALUE_RANGE, # or OP_LIST_GET_BY_VALUE, ...
+     *   bin => "scores",
+     *   val => 0, # a list of values for the value list operations
+     *   range_end => 50, # optional for the value range operations, the largest value if absent
+     *   return_type => Aerospike::LIST_RETURN_COUNT
+     *
      *
      * Map operations
      *
@@ -1673,6 +1895,18 @@ class Aerospike {
      *   bin => "bin_name",
      *   return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
      *
+     * Map Get by Key list operation
+     *   op => AEROSPIKE::OP_MAP_GET_BY_KEY_LIST ,
+     *   bin => "bin_name",
+     *   key => ["key1", 2, "key3"],
+     *   return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
+     *
+     * Map Get by Value list operation
+     *   op => AEROSPIKE::OP_MAP_GET_BY_VALUE_LIST ,
+     *   bin => "bin_name",
+     *   val => ["value1", 2, "value3"],
+     *   return_type => AEROSPIKE::MAP_RETURN_KEY
+     *
      * Map Put operation
      *   op => AEROSPIKE::OP_MAP_PUT ,
      *   bin => "bin_name",
@@ -1763,6 +1997,75 @@ class Aerospike {
      *   rank => -1,
      *   count => return_type => AEROSPIKE::MAP_RETURN_KEY_VALUE
      *
+     * Bit operations, on bytes bins. Offsets and sizes are in bits, negative offsets count from the end
+     *   bit_policy => [Aerospike::OPT_BIT_WRITE_FLAGS => Aerospike::AS_BIT_WRITE_UPDATE_ONLY] # optional
+     *
+     * Bit Set, Or, Xor and And operations
+     *   op => Aerospike::OP_BIT_OR, # or OP_BIT_SET, OP_BIT_XOR, OP_BIT_AND
+     *   bin => "flags",
+     *   bit_offset => 12,
+     *   bit_size => 1,
+     *   val => new Aerospike\Bytes("\x80") # the bits to apply, from the first one
+     *
+     * Bit Not, Get and Count operations
+     *   op => Aerospike::OP_BIT_COUNT, # or OP_BIT_NOT, OP_BIT_GET
+     *   bin => "flags",
+     *   bit_offset => 0,
+     *   bit_size => 64
+     *
+     * Bit Lscan and Rscan operations, the position of the first bit set to val
+     *   op => Aerospike::OP_BIT_LSCAN,
+     *   bin => "flags",
+     *   bit_offset => 0,
+     *   bit_size => 64,
+     *   val => true
+     *
+     * Bit Add, Subtract, Set Int, Get Int, Lshift and Rshift operations
+     *   op => Aerospike::OP_BIT_ADD, # or OP_BIT_SUBTRACT, OP_BIT_SET_INT, OP_BIT_GET_INT, OP_BIT_LSHIFT, OP_BIT_RSHIFT
+     *   bin => "counters",
+     *   bit_offset => 8,
+     *   bit_size => 16,
+     *   val => 1, # the shift of OP_BIT_LSHIFT and OP_BIT_RSHIFT, none for OP_BIT_GET_INT
+     *   signed => false, # add, subtract and get int
+     *   overflow_action => Aerospike::AS_BIT_OVERFLOW_SATURATE # add and subtract
+     *
+     * Bit Resize, Insert and Remove operations, on whole bytes
+     *   op => Aerospike::OP_BIT_INSERT, # or OP_BIT_RESIZE, OP_BIT_REMOVE
+     *   bin => "flags",
+     *   byte_offset => 0, # insert and remove
+     *   byte_size => 4, # resize and remove
+     *   val => new Aerospike\Bytes("\x00\x00"), # insert
+     *   resize_flags => Aerospike::AS_BIT_RESIZE_FROM_FRONT # resize
+     *
+     * HyperLogLog operations, on HLL bins estimating the number of distinct values added to them
+     *   hll_policy => [Aerospike::OPT_HLL_WRITE_FLAGS => Aerospike::AS_HLL_WRITE_CREATE_ONLY] # optional
+     *
+     * HLL Init and Add operations, add creates the bin if needed
+     *   op => Aerospike::OP_HLL_ADD, # or OP_HLL_INIT
+     *   bin => "visitors",
+     *   val => ["user1", "user2"], # add
+     *   index_bit_count => 12, # 4 to 16, -1 keeps that of an existing bin
+     *   minhash_bit_count => 0 # optional, needed by OP_HLL_GET_SIMILARITY and OP_HLL_GET_INTERSECT_COUNT
+     *
+     * HLL Get Count, Refresh Count, Describe and Fold operations
+     *   op => Aerospike::OP_HLL_GET_COUNT, # or OP_HLL_REFRESH_COUNT, OP_HLL_DESCRIBE, OP_HLL_FOLD
+     *   bin => "visitors",
+     *   index_bit_count => 8 # fold
+     *
+     * HLL Get Union, Get Union Count, Get Intersect Count, Get Similarity and Set Union operations
+     *   op => Aerospike::OP_HLL_GET_UNION_COUNT, # or OP_HLL_GET_UNION, OP_HLL_GET_INTERSECT_COUNT, OP_HLL_GET_SIMILARITY, OP_HLL_SET_UNION
+     *   bin => "visitors",
+     *   val => [$hll] # Aerospike\Bytes HLLs, as read from HLL bins or returned by OP_HLL_GET_UNION
+     *
+     * Any list, map, bit or HLL operation may take a ctx, the path from the bin down to the nested
+     * element it works on. Each step is a pair of a CDT_CTX_* type and its value.
+     * The element is read or written in place on the server.
+     *   op => AEROSPIKE::OP_LIST_SET,
+     *   bin => "profile",
+     *   ctx => [[AEROSPIKE::CDT_CTX_MAP_KEY, "settings"], [AEROSPIKE::CDT_CTX_MAP_KEY, "notifications"]],
+     *   index => 3,
+     *   val => "off"
+     *
      *
      *
      * ```
@@ -1803,7 +2106,7 @@ class Aerospike {
      * @see Aerospike::OPERATOR_WRITE Aerospike::OPERATOR_WRITE and other operators
      * @return int The status code of the operation. Compare to the Aerospike class status constants.
      */
-    public function operateOrdered(array $key, array $operations, &$returned, array $options = []) {}
+    public function operateOrdered(array $key, $operations, &$returned, array $options = []) {}
 
     /**
      * Count the number of elements in a list type bin
@@ -2295,10 +2598,19 @@ class Aerospike {
     /**
      * Read a batch of records from a list of given keys, and fill $records with the resulting indexed array
      *
-     * Each record is an array consisting of *key*, *metadata* and *bins* (see: {@see Aerospike::get() get()}).
-     * Non-existent records will have `NULL` for their *metadata* and *bins* fields.
+     * Each record is an array consisting of *key*, *metadata*, *bins* (see: {@see Aerospike::get() get()}).
+     * With `Aerospike::OPT_BATCH_RESULTS` set to true it also holds *result*, the status code of that key.
+     * Non-existent records will have `NULL` for their *metadata* and *bins* fields, and
+     * `Aerospike::ERR_RECORD_NOT_FOUND` as their *result*.
      * The bins returned can be filtered by passing an array of bin names.
      *
+     * By default a timeout or failure of any node fails the whole call. With
+     * `Aerospike::OPT_BATCH_RETRY_FAILED_KEYS` only the keys of the failed
+     * sub-batches are sent again, up to the given number of extra rounds. If some
+     * keys are still unresolved after that, the error is returned together with
+     * the records which were read. The unresolved keys have `NULL` *bins*, and carry
+     * the error in *result* when `Aerospike::OPT_BATCH_RESULTS` is set.
+     *
      * **Note** that the protocol getMany() will use (batch-direct or batch-index)
      * is configurable through the config parameter `Aerospike::USE_BATCH_DIRECT`
      * or `php.ini` config parameter `aerospike.use_batch_direct`.
@@ -2484,7 +2796,7 @@ class Aerospike {
      * }
      * ```
      * @param array $keys an array of initialized keys, each key an array with keys `['ns','set','key']` or `['ns','set','digest']`
-     * @param array $records a pass-by-reference variable which will hold an array of record values, each record an array of `['key', 'metadata', 'bins']`
+     * @param array $records a pass-by-reference variable which will hold an array of record values, each record an array of `['key', 'metadata', 'bins', 'result']`
      * @param array $select only these bins out of the record (optional)
      * @param array $options an optional array of read policy options, whose keys include
      * * Aerospike::OPT_READ_TIMEOUT
@@ -2496,6 +2808,8 @@ class Aerospike {
      * * Aerospike::OPT_BATCH_CONCURRENT
      * * Aerospike::OPT_SEND_SET_NAME
      * * Aerospike::OPT_ALLOW_INLINE
+     * * Aerospike::OPT_BATCH_RETRY_FAILED_KEYS
+     * * Aerospike::OPT_BATCH_RESULTS
      * @see Aerospike::USE_BATCH_DIRECT Aerospike::USE_BATCH_DIRECT options
      * @see Aerospike::OPT_SLEEP_BETWEEN_RETRIES Aerospike::OPT_SLEEP_BETWEEN_RETRIES options
      * @see Aerospike::OPT_TOTAL_TIMEOUT Aerospike::OPT_TOTAL_TIMEOUT options
@@ -2509,6 +2823,153 @@ class Aerospike {
      */
     public function getMany ( array $keys, &$records, array $select = [], array $options = []) {}
 
+    /**
+     * Estimate the number of distinct values added to the HLL bins of several records
+     *
+     * The bin of every key is fetched with one batch read, then the server of the first record
+     * holding an HLL counts the union of it with the others. Keys whose record or bin does not
+     * exist are left out, the count is 0 if none of them has one.
+     *
+     * ```php
+     * $keys = [$client->initKey("test", "pages", "home"), $client->initKey("test", "pages", "about")];
+     * $status = $client->hllGetUnionCount($keys, "visitors", $count);
+     * if ($status == Aerospike::OK) {
+     *     echo "About $count distinct visitors\n";
+     * }
+     * ```
+     * @param array $keys an array of initialized keys, each key an array with keys `['ns','set','key']` or `['ns','set','digest']`
+     * @param string $bin the name of the HLL bin
+     * @param int $count a pass-by-reference variable which will hold the estimated count
+     * @param array $options an optional array of batch and operate policy options, whose keys include
+     * * Aerospike::OPT_READ_TIMEOUT
+     * * Aerospike::OPT_TOTAL_TIMEOUT
+     * * Aerospike::OPT_MAX_RETRIES
+     * * Aerospike::OPT_SOCKET_TIMEOUT
+     * @see Aerospike::OP_HLL_GET_UNION_COUNT Aerospike::OP_HLL_GET_UNION_COUNT
+     * @see Aerospike::error() error()
+     * @see Aerospike::errorno() errorno()
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function hllGetUnionCount ( array $keys, string $bin, &$count, array $options = []) {}
+
+    /**
+     * Merge the HLL bins of several records into a single HLL
+     *
+     * Works like hllGetUnionCount(), the union is returned as an \Aerospike\Bytes which may be
+     * written to a bin, or passed to the OP_HLL_* operations of operate(). It is null if none
+     * of the records has the bin.
+     *
+     * @param array $keys an array of initialized keys, each key an array with keys `['ns','set','key']` or `['ns','set','digest']`
+     * @param string $bin the name of the HLL bin
+     * @param \Aerospike\Bytes $hll a pass-by-reference variable which will hold the union
+     * @param array $options an optional array of batch and operate policy options, as for hllGetUnionCount()
+     * @see Aerospike::hllGetUnionCount() hllGetUnionCount()
+     * @see Aerospike::OP_HLL_GET_UNION Aerospike::OP_HLL_GET_UNION
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function hllGetUnion ( array $keys, string $bin, &$hll, array $options = []) {}
+
+    /**
+     * Start reading a record without waiting for the server
+     *
+     * The read is sent on the C client event loops and an \Aerospike\Future is returned
+     * immediately, so independent reads overlap instead of paying one round trip each.
+     * The record is converted into PHP values on the calling thread when the future is
+     * waited for, with Aerospike\Future::wait() or Aerospike::awaitAll().
+     * Async commands require the `aerospike.async.event_loops` INI setting.
+     *
+     * If the command cannot be sent, the error is set on the client as for any other method
+     * and the returned future is already completed with it.
+     *
+     * ```php
+     * $futures = [];
+     * foreach ([1234, 1235, 1236] as $id) {
+     *     $futures[$id] = $client->getAsync($client->initKey("test", "users", $id));
+     * }
+     * Aerospike::awaitAll($futures, $results, 1000);
+     * foreach ($results as $id => $result) {
+     *     if ($result["result"] == Aerospike::OK) {
+     *         var_dump($result["bins"]);
+     *     }
+     * }
+     * ```
+     * @param array $key The key identifying the record. An array with keys `['ns','set','key']` or `['ns','set','digest']`
+     * @param array $select only these bins out of the record (optional)
+     * @param array $options an optional array of read policy options, as for {@see Aerospike::get() get()}
+     * @see Aerospike::awaitAll() awaitAll()
+     * @see \Aerospike\Future::wait() Future::wait()
+     * @return \Aerospike\Future the pending result of the read
+     */
+    public function getAsync ( array $key, array $select = null, array $options = []) {}
+
+    /**
+     * Wait for a set of futures
+     *
+     * *$results* gets the same keys as *$futures*. Each entry is an array of
+     * `['key', 'metadata', 'bins', 'result']`, with *result* the status of that command,
+     * an *error* message when it failed, and `NULL` *metadata* and *bins* if there is no record.
+     * @param array $futures an array of \Aerospike\Future
+     * @param array $results a pass-by-reference variable which will hold the results
+     * @param int $timeout_ms maximum time to wait in milliseconds, 0 waits until all complete.
+     * Futures still pending at the deadline get *result* `Aerospike::ERR_TIMEOUT` and can be awaited again.
+     * @see Aerospike::getAsync() getAsync()
+     * @return int Aerospike::OK once every future completed, Aerospike::ERR_TIMEOUT if the timeout
+     * passed first, Aerospike::ERR_PARAM if an entry is not a future.
+     */
+    public static function awaitAll ( array $futures, &$results, $timeout_ms = 0) {}
+
+    /**
+     * Create a pipeline for long runs of single record commands
+     *
+     * Commands issued on the returned \Aerospike\Pipeline are sent right away on the
+     * pipelined connections of one event loop, so those going to the same node are
+     * written back to back without waiting for each answer.
+     * Aerospike\Pipeline::flush() returns their results in the order they were issued.
+     * Pipelines require the `aerospike.async.event_loops` INI setting.
+     *
+     * ```php
+     * $pipeline = $client->pipeline();
+     * foreach ($rows as $id => $bins) {
+     *     $pipeline->put($client->initKey("test", "cache", $id), $bins);
+     * }
+     * $pipeline->flush($results);
+     * ```
+     * @see \Aerospike\Pipeline Pipeline
+     * @return \Aerospike\Pipeline|null NULL if the client is not connected or the event loops are not available.
+     */
+    public function pipeline () {}
+
+    /**
+     * Get a stream which becomes readable when commands with a completion callback complete
+     *
+     * It lets an application event loop (Swoole, ReactPHP, libev, ...) wait for the async commands
+     * alongside its own I/O. Once the stream is readable, call Aerospike::poll(), which reads it.
+     * Every call returns a new stream on the same completion queue, closing it has no other effect.
+     *
+     * ```php
+     * $loop->addReadStream(Aerospike::completionStream(), function () {
+     *     Aerospike::poll();
+     * });
+     * $client->getAsync($key)->onComplete(function ($result, $status) {
+     *     echo $result["bins"]["name"], "\n";
+     * });
+     * ```
+     * @see \Aerospike\Future::onComplete()
+     * @return resource|null NULL if the completion queue could not be created
+     */
+    public static function completionStream () {}
+
+    /**
+     * Run the callbacks of the commands which completed so far
+     *
+     * Never blocks. Callbacks run in completion order, if one of them throws the exception is
+     * propagated and the remaining callbacks are left for the next call.
+     *
+     * @see \Aerospike\Future::onComplete()
+     * @return int the number of callbacks which were run
+     */
+    public static function poll () {}
+
 
     /**
      * Check if a batch of records exists in the database and fill $metdata with the results
@@ -2633,6 +3094,49 @@ class Aerospike {
      */
     public function existsMany ( array $keys, array &$metadata, array $options = []) {}
 
+    /**
+     * Check whether a batch of keys exists, without building a metadata array per key
+     *
+     * The records are read with a batch-index request which asks the server for no bins,
+     * and the answer is packed into a single value. By default *$exists* is a bitmap string
+     * of `ceil(count($keys) / 8)` bytes, in which bit `i & 7` of byte `i >> 3` is set when
+     * `$keys[i]` exists. With `Aerospike::OPT_EXISTS_FORMAT => Aerospike::EXISTS_FORMAT_BOOL`
+     * it is a packed array of booleans in the order of *$keys*.
+     *
+     * ```php
+     * $keys = [$client->initKey("test", "users", 1234),
+     *          $client->initKey("test", "users", 1235)];
+     * $status = $client->existsManyCompact($keys, $exists, [], $generations);
+     * if ($status == Aerospike::OK) {
+     *     for ($i = 0; $i < count($keys); $i++) {
+     *         if (ord($exists[$i >> 3]) & (1 << ($i & 7))) {
+     *             echo "Key $i exists with generation {$generations[$i]}\n";
+     *         }
+     *     }
+     * }
+     * ```
+     * @param array $keys an array of initialized keys, each key an array with keys `['ns','set','key']` or `['ns','set','digest']`
+     * @param string|array $exists a pass-by-reference variable which will hold the bitmap string, or the array of booleans
+     * @param array $options an optional array of read policy options, whose keys include
+     * * Aerospike::OPT_EXISTS_FORMAT
+     * * Aerospike::OPT_READ_TIMEOUT
+     * * Aerospike::OPT_SLEEP_BETWEEN_RETRIES
+     * * Aerospike::OPT_TOTAL_TIMEOUT
+     * * Aerospike::OPT_MAX_RETRIES
+     * * Aerospike::OPT_SOCKET_TIMEOUT
+     * * Aerospike::OPT_BATCH_CONCURRENT
+     * * Aerospike::OPT_SEND_SET_NAME
+     * * Aerospike::OPT_ALLOW_INLINE
+     * @param array $generations if passed, a pass-by-reference array filled with the generation of each record, 0 for non-existent ones
+     * @see Aerospike::OPT_EXISTS_FORMAT Aerospike::OPT_EXISTS_FORMAT options
+     * @see Aerospike::OK Aerospike::OK and error status codes
+     * @see Aerospike::error() error()
+     * @see Aerospike::errorno() errorno()
+     * @see Aerospike::existsMany() existsMany()
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function existsManyCompact ( array $keys, &$exists, array $options = [], array &$generations = null) {}
+
     // Scan and Query
 
     /**
@@ -2644,8 +3148,12 @@ class Aerospike {
      * Optionally select the bins to be returned. Non-existent bins in this list will appear in the
      * record with a NULL value.
      *
+     * The callback runs one record at a time, as the C client hands each record over. With
+     * Aerospike::OPT_SCAN_CONCURRENTLY in ZTS builds, the node threads instead queue the records for
+     * the calling thread, so the nodes are read in parallel there as well.
+     *
      * ```php
-     * $options = [Aerospike::OPT_SCAN_PRIORITY => Aerospike::SCAN_PRIORITY_MEDIUM];
+     * $options = [Aerospike::OPT_SCAN_CONCURRENTLY => true];
      * $processed = 0;
      * $status = $client->scan('test', 'users', function ($record) use (&$processed) {
      *     if (!is_null($record['bins']['email'])) echo $record['bins']['email']."\n";
@@ -2670,16 +3178,80 @@ class Aerospike {
      * @param array    $options an optional array of policy options, whose keys include
      * * Aerospike::OPT_READ_TIMEOUT
      * * Aerospike::OPT_SOCKET_TIMEOUT maximum socket idle time in milliseconds (0 means do not apply a socket idle timeout)
-     * * Aerospike::OPT_SCAN_PRIORITY
-     * * Aerospike::OPT_SCAN_PERCENTAGE of the records in the set to return
      * * Aerospike::OPT_SCAN_CONCURRENTLY whether to run the scan in parallel
      * * Aerospike::OPT_SCAN_NOBINS whether to not retrieve bins for the records
      * * Aerospike::OPT_SCAN_RPS_LIMIT limit the scan to process OPT_SCAN_RPS_LIMIT per second.
+     * * Aerospike::OPT_READ_OPERATIONS read operations whose results are returned instead of the bins
      *
      * @return int The status code of the operation. Compare to the Aerospike class status constants.
      */
     public function scan(string $ns, string $set, callable $record_cb, array $select = [], array $options = []) {}
 
+    /**
+     * Scan a range of the partitions of a namespace or set, resuming from a cursor
+     *
+     * Works like scan(), but only returns the records of the partitions *begin* to
+     * *begin* + *count* - 1, out of the 4096 partitions of a namespace. Several processes can
+     * therefore split a scan by giving each a disjoint partition range.
+     *
+     * When *cursor* is passed, it is set to the progress of the scan on return, including when the
+     * callback stopped it by returning false or when the scan failed part way. Passing it back with
+     * the same range resumes the scan after the last record handed to the callback. The cursor is an
+     * opaque binary string, store it as such (or base64 encoded) to checkpoint a long scan. The cursor of
+     * a finished scan returns no records. A resumed scan reads each partition it had started on its
+     * own, and the partitions it had not started in ranges, so resuming costs a few more commands.
+     *
+     * ```php
+     * $cursor = load_checkpoint($worker_id); // null on the first run
+     * do {
+     *     $seen = 0;
+     *     $status = $client->scanPartitions('test', 'users', $worker_id * 64, 64, function ($record) use (&$seen) {
+     *         process($record);
+     *         if (++$seen == 10000) return false; // checkpoint every 10000 records
+     *     }, [], [], $cursor);
+     *     save_checkpoint($worker_id, $cursor);
+     * } while ($status === Aerospike::OK && $seen == 10000);
+     * ```
+     * @param string   $ns the namespace
+     * @param string   $set the set within the given namespace
+     * @param int      $begin the first partition to scan, from 0 to 4095
+     * @param int      $count the number of partitions to scan
+     * @param callable $record_cb A callback function invoked for each record streaming back from the cluster
+     * @param array    $select An array of bin names which are the subset to be returned
+     * @param array    $options an optional array of policy options, as for scan()
+     * @param string   $cursor the progress to resume from, null to start over. Set to the progress of the scan.
+     * @see Aerospike::scan() scan()
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function scanPartitions(string $ns, string $set, int $begin, int $count, callable $record_cb, array $select = [], array $options = [], &$cursor = null) {}
+
+    /**
+     * Iterate over the records of a namespace or set
+     *
+     * The scan starts when the iteration does, and records are read from the cluster as they are
+     * consumed. The node threads buffer up to Aerospike::OPT_ITERATOR_QUEUE_SIZE records for
+     * the application, and wait while that buffer is full. Leaving the loop early stops the scan.
+     *
+     * The records have the same form as those passed to the callback of scan(). Errors are set on
+     * the client once the iteration ends, check them with errorno().
+     *
+     * ```php
+     * foreach ($client->scanIterator('test', 'users', ['email']) as $record) {
+     *     if ($record['bins']['email'] === 'foo@example.com') break;
+     * }
+     * if ($client->errorno() !== Aerospike::OK) echo $client->error();
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $select An array of bin names which are the subset to be returned
+     * @param array  $options an optional array of policy options, the ones of scan() and
+     * * Aerospike::OPT_ITERATOR_QUEUE_SIZE
+     * @see Aerospike::scan() scan()
+     * @see \Aerospike\RecordIterator RecordIterator
+     * @return \Aerospike\RecordIterator|null NULL if the scan could not be set up
+     */
+    public function scanIterator(string $ns, string $set, array $select = [], array $options = []) {}
+
     /**
      * Query a secondary index on a namespace or set
      *
@@ -2689,6 +3261,20 @@ class Aerospike {
      * Optionally select the bins to be returned. Non-existent bins in this list will appear in the
      * record with a NULL value.
      *
+     * Passing a *cursor*, even a NULL one, pages through the results. Each call returns about
+     * Aerospike::OPT_MAX_RECORDS records following the cursor, then sets it to where the next page
+     * starts, or to NULL after the last page. The cursor is an opaque binary string which can be
+     * handed to a later request. A page stopped by the callback returning false, or by an error,
+     * leaves the cursor as it was. Paginated queries need Aerospike server 6.0 or later.
+     *
+     * ```php
+     * $cursor = $_GET['cursor'] ? base64_decode($_GET['cursor']) : null;
+     * $client->query('test', 'users', Aerospike::predicateBetween('age', 30, 39), function ($record) use (&$page) {
+     *     $page[] = $record['bins'];
+     * }, ['email'], [Aerospike::OPT_MAX_RECORDS => 50], $cursor);
+     * $next = is_null($cursor) ? null : base64_encode($cursor);
+     * ```
+     *
      * ```php
      * $result = [];
      * $where = Aerospike::predicateBetween("age", 30, 39);
@@ -2739,6 +3325,9 @@ class Aerospike {
      * * Aerospike::OPT_MAX_RETRIES
      * * Aerospike::OPT_SOCKET_TIMEOUT
      * * Aerospike::OPT_QUERY_NOBINS
+     * * Aerospike::OPT_MAX_RECORDS
+     * * Aerospike::OPT_READ_OPERATIONS read operations whose results are returned instead of the bins
+     * @param string   $cursor the page to return, NULL for the first one. Set to the next page, NULL after the last one.
      * @see Aerospike::predicateEquals()
      * @see Aerospike::predicateBetween()
      * @see Aerospike::predicateContains()
@@ -2749,7 +3338,78 @@ class Aerospike {
      * @see Aerospike::predicateGeoWithinRadius()
      * @return int The status code of the operation. Compare to the Aerospike class status constants.
      */
-    public function query(string $ns, string $set, array $where, callable $record_cb, array $select = [], array $options = []) {}
+    public function query(string $ns, string $set, array $where, callable $record_cb, array $select = [], array $options = [], &$cursor = null) {}
+
+    /**
+     * Iterate over the records matching a secondary index predicate
+     *
+     * The query counterpart of scanIterator(), with a *where* predicate as for query().
+     *
+     * ```php
+     * $where = Aerospike::predicateBetween("age", 30, 39);
+     * foreach ($client->queryIterator('test', 'users', $where, ['email']) as $record) {
+     *     echo $record['bins']['email'], "\n";
+     * }
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $where the predicate for the query, usually created by the predicate helper methods.
+     * @param array  $select An array of bin names which are the subset to be returned
+     * @param array  $options an optional array of policy options, the ones of query() and
+     * * Aerospike::OPT_ITERATOR_QUEUE_SIZE
+     * @see Aerospike::query() query()
+     * @see Aerospike::scanIterator() scanIterator()
+     * @return \Aerospike\RecordIterator|null NULL if the query could not be set up
+     */
+    public function queryIterator(string $ns, string $set, array $where, array $select = [], array $options = []) {}
+
+    /**
+     * Prepare a scan to run repeatedly
+     *
+     * The bins, read operations and options are parsed once, running the
+     * \Aerospike\Scan only copies the prepared scan.
+     *
+     * ```php
+     * $scan = $client->prepareScan('test', 'users', ['email']);
+     * $status = $scan->execute(function ($record) {
+     *     echo $record['bins']['email'], "\n";
+     * });
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $select An array of bin names which are the subset to be returned
+     * @param array  $options an optional array of policy options, the ones of scan() and
+     * * Aerospike::OPT_ITERATOR_QUEUE_SIZE
+     * @see Aerospike::scan() scan()
+     * @return \Aerospike\Scan|null NULL if the scan could not be set up
+     */
+    public function prepareScan(string $ns, string $set, array $select = [], array $options = []) {}
+
+    /**
+     * Prepare a query to run repeatedly, with a new value for its predicate on each run
+     *
+     * The predicate, bins, read operations and options are parsed once. Running the
+     * \Aerospike\Query only copies the prepared query and binds the value of the predicate.
+     * The *val* entry of the predicate may be left out, a value must then be passed on each run.
+     *
+     * ```php
+     * $query = $client->prepareQuery('test', 'users', ['bin' => 'age', 'op' => Aerospike::OP_EQ], ['email']);
+     * foreach ([30, 40, 50] as $age) {
+     *     $query->execute(function ($record) {
+     *         echo $record['bins']['email'], "\n";
+     *     }, $age);
+     * }
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $where the predicate for the query, usually created by the predicate helper methods.
+     * @param array  $select An array of bin names which are the subset to be returned
+     * @param array  $options an optional array of policy options, the ones of query() and
+     * * Aerospike::OPT_ITERATOR_QUEUE_SIZE
+     * @see Aerospike::query() query()
+     * @return \Aerospike\Query|null NULL if the query could not be set up
+     */
+    public function prepareQuery(string $ns, string $set, array $where, array $select = [], array $options = []) {}
 
     /**
      * Helper method for creating an EQUALS predicate
@@ -3176,7 +3836,6 @@ class Aerospike {
      * * Aerospike::OPT_TOTAL_TIMEOUT
      * * Aerospike::OPT_MAX_RETRIES
      * * Aerospike::OPT_SOCKET_TIMEOUT
-     * * Aerospike::OPT_FAIL_ON_CLUSTER_CHANGE
      * * Aerospike::OPT_SCAN_RPS_LIMIT
      * @see Aerospike::OPT_WRITE_TIMEOUT Aerospike::OPT_WRITE_TIMEOUT options
      * @see Aerospike::OPT_POLICY_DURABLE_DELETE Aerospike::OPT_POLICY_DURABLE_DELETE options
@@ -3186,6 +3845,43 @@ class Aerospike {
      */
     public function scanApply(string $ns, string $set, string $module, string $function, array $args, int &$job_id, array $options = []) {}
 
+    /**
+     * Apply write operations to each record in a scan
+     *
+     * Scan the *ns.set* in the background and apply the operations to each of its
+     * records on the server, without a UDF. Only write operations are accepted, such as
+     * touch, increment, writing a bin to null to delete it, and the list, map, bit and HLL
+     * modify operations, in the format of operate().
+     *
+     * The method returns as soon as the scan is started, its progress is reported by jobInfo().
+     * ```php
+     * // extend the expiration of every record in the set by 30 days
+     * $operations = [["op" => Aerospike::OPERATOR_TOUCH, "ttl" => 30 * 86400]];
+     * $status = $client->scanOperate("test", "users", $operations, $job_id);
+     * if ($status === Aerospike::OK) {
+     *     do {
+     *         sleep(1);
+     *         $client->jobInfo($job_id, Aerospike::JOB_SCAN, $info);
+     *     } while ($info["status"] !== Aerospike::JOB_STATUS_COMPLETED);
+     * }
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $operations the write operations, as for operate()
+     * @param int    $job_id pass-by-reference filled by the job ID of the scan
+     * @param array  $options an optional array of policy options, whose keys include
+     * * Aerospike::OPT_TTL
+     * * Aerospike::OPT_FILTER_EXP
+     * * Aerospike::OPT_TOTAL_TIMEOUT
+     * * Aerospike::OPT_SOCKET_TIMEOUT
+     * * Aerospike::OPT_POLICY_DURABLE_DELETE
+     * * Aerospike::OPT_SCAN_RPS_LIMIT
+     * @see Aerospike::operate() operate()
+     * @see Aerospike::jobInfo()
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function scanOperate(string $ns, string $set, array $operations, int &$job_id, array $options = []) {}
+
     /**
      * Apply a UDF to each record in a query
      *
@@ -3255,6 +3951,43 @@ class Aerospike {
      */
     public function queryApply(string $ns, string $set, array $where, string $module, string $function, array $args, int &$job_id, array $options = []) {}
 
+    /**
+     * Apply write operations to each record in a query
+     *
+     * Query the *ns.set* with a predicate in the background, and apply the operations to
+     * each of the matched records on the server, without a UDF. Only write operations are
+     * accepted, in the format of operate().
+     *
+     * The method returns as soon as the query is started, its progress is reported by jobInfo().
+     * ```php
+     * $where = Aerospike::predicateBetween("age", 30, 39);
+     * $operations = [
+     *     ["op" => Aerospike::OPERATOR_INCR, "bin" => "visits", "val" => 1],
+     *     ["op" => Aerospike::OPERATOR_WRITE, "bin" => "legacy", "val" => null] // removes the bin
+     * ];
+     * $status = $client->queryOperate("test", "users", $where, $operations, $job_id);
+     * if ($status === Aerospike::OK) {
+     *     var_dump("Job ID is $job_id");
+     * }
+     * ```
+     * @param string $ns the namespace
+     * @param string $set the set within the given namespace
+     * @param array  $where the predicate for the query, as for queryApply(), or an empty array() for no predicate
+     * @param array  $operations the write operations, as for operate()
+     * @param int    $job_id pass-by-reference filled by the job ID of the query
+     * @param array  $options an optional array of policy options, whose keys include
+     * * Aerospike::OPT_TTL
+     * * Aerospike::OPT_FILTER_EXP
+     * * Aerospike::OPT_WRITE_TIMEOUT
+     * * Aerospike::OPT_TOTAL_TIMEOUT
+     * * Aerospike::OPT_SOCKET_TIMEOUT
+     * * Aerospike::OPT_POLICY_DURABLE_DELETE
+     * @see Aerospike::operate() operate()
+     * @see Aerospike::jobInfo()
+     * @return int The status code of the operation. Compare to the Aerospike class status constants.
+     */
+    public function queryOperate(string $ns, string $set, array $where, array $operations, int &$job_id, array $options = []) {}
+
     /**
      * Apply a stream UDF to a scan or secondary index query
      *
@@ -3274,9 +4007,6 @@ class Aerospike {
      * iteration is run locally on the client, after reducing on all the nodes
      * of the cluster.
      *
-     * **Note** aggregate is currently unsupported in PHP built with ZTS enabled.
-     * Attempting to use it in that environment will fail.
-     *
      * Currently the only UDF language supported is Lua.
      *
      * **Example Stream UDF**
@@ -3575,6 +4305,13 @@ class Aerospike {
      *
      * Registers a callback method that will be triggered whenever a logging event above the declared log threshold occurs.
      *
+     * The client logs from its own threads, so the events are queued and the handler runs on the
+     * calling thread, once the commands of the client (connecting, get, put, exists, remove, touch,
+     * increment, append, prepend, operate, getMany, existsMany, apply and info) return, and
+     * between the callbacks of a scan or query. Events still queued when the request ends are
+     * handed to the handler then. The process keeps the latest 1024 events, in ZTS builds they go
+     * to the handler of whichever request delivers first.
+     *
      * ```php
      * $config = ["hosts" => [["addr"=>"localhost", "port"=>3000]], "shm"=>[]];
      * $client = new Aerospike($config, true);
@@ -3793,6 +4530,23 @@ class Aerospike {
      * @const OPT_POLICY_KEY Key storage policy option (digest-only or send key)
      */
     const OPT_POLICY_KEY = "OPT_POLICY_KEY";
+    /**
+     * Authenticate the user with the server's internal users (default)
+     * @const AUTH_INTERNAL
+     */
+    const AUTH_INTERNAL = 0;
+    /**
+     * Authenticate the user with an external method, such as LDAP. Requires TLS.
+     * @const AUTH_EXTERNAL
+     */
+    const AUTH_EXTERNAL = 1;
+    /**
+     * Authenticate the user with an external method, sending the password in the clear
+     * without TLS. Only for testing.
+     * @const AUTH_EXTERNAL_INSECURE
+     */
+    const AUTH_EXTERNAL_INSECURE = 2;
+
     /**
      * Do not store the primary key with the record (default)
      * @const POLICY_KEY_DIGEST digest only
@@ -4076,33 +4830,135 @@ class Aerospike {
       */
     const OPT_SEND_SET_NAME = "OPT_SEND_SET_NAME";
 
+     /**
+      * Number of extra rounds in which getMany() re-sends only the keys whose sub-batch
+      * timed out or whose node failed. Keys answered by healthy nodes are not read again.
+      * When set, a failure which outlives the retries returns the partial results, with
+      * the status of each key under *result* if Aerospike::OPT_BATCH_RESULTS is set.
+      * Default: not set, any node failure fails the whole batch
+      */
+    const OPT_BATCH_RETRY_FAILED_KEYS = "OPT_BATCH_RETRY_FAILED_KEYS";
+
+     /**
+      * Boolean, whether each record getMany() returns holds the status code of its key
+      * under *result*.
+      * Default: false
+      */
+    const OPT_BATCH_RESULTS = "OPT_BATCH_RESULTS";
+
+     /**
+      * Format of the result of existsManyCompact(), one of
+      * Aerospike::EXISTS_FORMAT_BITMAP or Aerospike::EXISTS_FORMAT_BOOL
+      * Default: Aerospike::EXISTS_FORMAT_BITMAP
+      */
+    const OPT_EXISTS_FORMAT = "OPT_EXISTS_FORMAT";
+
+     /**
+      * Number of records scanIterator() and queryIterator() buffer between the cluster and
+      * the application. The node threads wait while the buffer is full.
+      * Default: 256
+      */
+    const OPT_ITERATOR_QUEUE_SIZE = "OPT_ITERATOR_QUEUE_SIZE";
+
+     /**
+      * Approximate number of records a query returns, 0 for all of them. For a paginated query, the
+      * page size.
+      * Default: 0
+      */
+    const OPT_MAX_RECORDS = "OPT_MAX_RECORDS";
+
+     /**
+      * An \Aerospike\Exp the server evaluates on each record before the command applies to it.
+      * Accepted by the options of every record, batch, scan and query command.
+      * @see \Aerospike\Exp
+      */
+    const OPT_FILTER_EXP = "OPT_FILTER_EXP";
+
+     /**
+      * The path to the nested list a list* method works on, given as the ctx of a list operation
+      * of operate(), for instance [[Aerospike::CDT_CTX_MAP_KEY, "settings"]].
+      * Accepted by the options of the list* methods.
+      */
+    const OPT_CDT_CTX = "OPT_CDT_CTX";
+
+     /**
+      * Read operations, in the format of operate(), applied by a scan or query to each record. Each
+      * record comes back with their results as its bins, so only the parts of large list and map bins
+      * the operations select cross the network. Can not be combined with selected bins.
+      * ```php
+      * $options = [Aerospike::OPT_READ_OPERATIONS => [
+      *     ["op" => Aerospike::OP_MAP_GET_BY_KEY_LIST, "bin" => "profile", "key" => ["email", "country"],
+      *      "return_type" => Aerospike::MAP_RETURN_KEY_VALUE],
+      *     ["op" => Aerospike::OP_MAP_SIZE, "bin" => "events"]]];
+      * $client->scan("test", "users", function ($record) { var_dump($record["bins"]); }, [], $options);
+      * ```
+      * Accepted by the options of the scan and query methods.
+      */
+    const OPT_READ_OPERATIONS = "OPT_READ_OPERATIONS";
+
+     /**
+      * Key of the constructor options holding an array of namespace => options. The options of a
+      * namespace, in the format of the constructor options, override the client defaults for the
+      * records of the namespace. Their "sets" entry holds set => options overriding the namespace
+      * ones for the records of a set. The profiles are resolved once, by the constructor.
+      * ```php
+      * $options = [Aerospike::OPT_POLICY_PROFILES => [
+      *     "cache" => [Aerospike::OPT_TOTAL_TIMEOUT => 5, Aerospike::OPT_MAX_RETRIES => 0],
+      *     "ssd" => [Aerospike::OPT_TOTAL_TIMEOUT => 50, Aerospike::OPT_MAX_RETRIES => 2,
+      *         "sets" => ["audit" => [Aerospike::OPT_POLICY_KEY => Aerospike::POLICY_KEY_SEND]]]]];
+      * $client = new Aerospike($config, true, $options);
+      * ```
+      * Applies to the single record commands, to pipelines, and to the scans and queries of the
+      * namespace or set. A batch command uses the profile all of its keys share, and the client
+      * defaults when its keys span several profiles.
+      */
+    const OPT_POLICY_PROFILES = "OPT_POLICY_PROFILES";
+    /**
+     * existsManyCompact() returns a string with one bit per key
+     * @const EXISTS_FORMAT_BITMAP
+     */
+    const EXISTS_FORMAT_BITMAP = 0;
+    /**
+     * existsManyCompact() returns a packed array of booleans
+     * @const EXISTS_FORMAT_BOOL
+     */
+    const EXISTS_FORMAT_BOOL = 1;
+
     /**
      * Abort the scan if the cluster is not in a stable state. Default false
+     *
+     * @deprecated ignored since the extension builds against the C client 6.x
      */
     const OPT_FAIL_ON_CLUSTER_CHANGE = "OPT_FAIL_ON_CLUSTER_CHANGE";
     /**
      * Accepts one of the SCAN_PRIORITY_* values.
      *
+     * @deprecated the C client 6.x has no scan priority. Only SCAN_PRIORITY_AUTO is accepted,
+     * any other value fails the scan with Aerospike::ERR_PARAM
      * @const OPT_SCAN_PRIORITY The priority of the scan
      */
     const OPT_SCAN_PRIORITY = "OPT_SCAN_PRIORITY";
     /**
      * The cluster will auto-adjust the priority of the scan.
+     * @deprecated see Aerospike::OPT_SCAN_PRIORITY
      * @const SCAN_PRIORITY_AUTO auto-adjust the scan priority (default)
      */
     const SCAN_PRIORITY_AUTO = "SCAN_PRIORITY_AUTO";
     /**
      * Set the scan as having low priority.
+     * @deprecated see Aerospike::OPT_SCAN_PRIORITY
      * @const SCAN_PRIORITY_LOW low priority scan
      */
     const SCAN_PRIORITY_LOW = "SCAN_PRIORITY_LOW";
     /**
      * Set the scan as having medium priority.
+     * @deprecated see Aerospike::OPT_SCAN_PRIORITY
      * @const SCAN_PRIORITY_MEDIUM medium priority scan
      */
     const SCAN_PRIORITY_MEDIUM = "SCAN_PRIORITY_MEDIUM";
     /**
      * Set the scan as having high priority.
+     * @deprecated see Aerospike::OPT_SCAN_PRIORITY
      * @const SCAN_PRIORITY_HIGH high priority scan
      */
     const SCAN_PRIORITY_HIGH = "SCAN_PRIORITY_HIGH";
@@ -4117,6 +4973,8 @@ class Aerospike {
     /**
      * Set the scan to run over a given percentage of the possible records.
      *
+     * @deprecated the C client 6.x always scans the whole set. Only 100 is accepted,
+     * any other value fails the scan with Aerospike::ERR_PARAM
      * @const OPT_SCAN_PERCENTAGE integer value from 1-100 (default: 100)
      */
     const OPT_SCAN_PERCENTAGE = "OPT_SCAN_PERCENTAGE";
@@ -4314,6 +5172,259 @@ class Aerospike {
      */
     const MAP_RETURN_KEY_VALUE = "AS_MAP_RETURN_KEY_VALUE";
 
+    /**
+     * List policy ordering of the list created by a list write operation
+     * @see Aerospike::AS_LIST_UNORDERED
+     * @see Aerospike::AS_LIST_ORDERED
+     * @const OPT_LIST_ORDER
+     */
+    const OPT_LIST_ORDER = "OPT_LIST_ORDER";
+
+    /**
+     * Default. Elements keep their insertion order.
+     * @const AS_LIST_UNORDERED
+     */
+    const AS_LIST_UNORDERED = "AS_LIST_UNORDERED";
+
+    /**
+     * Elements are kept sorted by value.
+     * @const AS_LIST_ORDERED
+     */
+    const AS_LIST_ORDERED = "AS_LIST_ORDERED";
+
+    /**
+     * List policy flags declaring the behavior of list write operations, or-ed together
+     * @see Aerospike::AS_LIST_WRITE_DEFAULT
+     * @see Aerospike::AS_LIST_WRITE_ADD_UNIQUE
+     * @see Aerospike::AS_LIST_WRITE_INSERT_BOUNDED
+     * @see Aerospike::AS_LIST_WRITE_NO_FAIL
+     * @see Aerospike::AS_LIST_WRITE_PARTIAL
+     * @const OPT_LIST_WRITE_FLAGS
+     */
+    const OPT_LIST_WRITE_FLAGS = "OPT_LIST_WRITE_FLAGS";
+
+    /**
+     * Default. Allow duplicate values and inserts at any index.
+     * @const AS_LIST_WRITE_DEFAULT
+     */
+    const AS_LIST_WRITE_DEFAULT = "AS_LIST_WRITE_DEFAULT";
+
+    /**
+     * Only add values not already in the list.
+     * @const AS_LIST_WRITE_ADD_UNIQUE
+     */
+    const AS_LIST_WRITE_ADD_UNIQUE = "AS_LIST_WRITE_ADD_UNIQUE";
+
+    /**
+     * Refuse inserts past the end of the list.
+     * @const AS_LIST_WRITE_INSERT_BOUNDED
+     */
+    const AS_LIST_WRITE_INSERT_BOUNDED = "AS_LIST_WRITE_INSERT_BOUNDED";
+
+    /**
+     * Do not raise an error if a list item is denied due to write flag constraints.
+     * @const AS_LIST_WRITE_NO_FAIL
+     */
+    const AS_LIST_WRITE_NO_FAIL = "AS_LIST_WRITE_NO_FAIL";
+
+    /**
+     * Allow other valid list items to be committed if a list item is denied due to write flag constraints.
+     * @const AS_LIST_WRITE_PARTIAL
+     */
+    const AS_LIST_WRITE_PARTIAL = "AS_LIST_WRITE_PARTIAL";
+
+    /**
+     * Default sort_flags of OP_LIST_SORT, keep duplicate values.
+     * @const AS_LIST_SORT_DEFAULT
+     */
+    const AS_LIST_SORT_DEFAULT = "AS_LIST_SORT_DEFAULT";
+
+    /**
+     * sort_flags of OP_LIST_SORT removing duplicate values.
+     * @const AS_LIST_SORT_DROP_DUPLICATES
+     */
+    const AS_LIST_SORT_DROP_DUPLICATES = "AS_LIST_SORT_DROP_DUPLICATES";
+
+    /**
+     * Do not return a result for the list operation
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_NONE
+     */
+    const LIST_RETURN_NONE = "AS_LIST_RETURN_NONE";
+
+    /**
+     * Return the index of the elements
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_INDEX
+     */
+    const LIST_RETURN_INDEX = "AS_LIST_RETURN_INDEX";
+
+    /**
+     * Return the index of the elements counted from the end
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_REVERSE_INDEX
+     */
+    const LIST_RETURN_REVERSE_INDEX = "AS_LIST_RETURN_REVERSE_INDEX";
+
+    /**
+     * Return the value rank of the elements
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_RANK
+     */
+    const LIST_RETURN_RANK = "AS_LIST_RETURN_RANK";
+
+    /**
+     * Return the value rank of the elements counted from the largest
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_REVERSE_RANK
+     */
+    const LIST_RETURN_REVERSE_RANK = "AS_LIST_RETURN_REVERSE_RANK";
+
+    /**
+     * Return the number of elements
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_COUNT
+     */
+    const LIST_RETURN_COUNT = "AS_LIST_RETURN_COUNT";
+
+    /**
+     * Return the value of the elements
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_VALUE
+     */
+    const LIST_RETURN_VALUE = "AS_LIST_RETURN_VALUE";
+
+    /**
+     * Or-ed with a return type, apply the operation to the elements outside of the selection
+     * @link https://www.aerospike.com/docs/guide/cdt-list.html List Result Types
+     * @const LIST_RETURN_INVERTED
+     */
+    const LIST_RETURN_INVERTED = "AS_LIST_RETURN_INVERTED";
+
+    /**
+     * Bit policy flags declaring the behavior of bit write operations
+     * @see Aerospike::AS_BIT_WRITE_DEFAULT
+     * @see Aerospike::AS_BIT_WRITE_CREATE_ONLY
+     * @see Aerospike::AS_BIT_WRITE_UPDATE_ONLY
+     * @see Aerospike::AS_BIT_WRITE_NO_FAIL
+     * @see Aerospike::AS_BIT_WRITE_PARTIAL
+     * @const OPT_BIT_WRITE_FLAGS
+     */
+    const OPT_BIT_WRITE_FLAGS = "OPT_BIT_WRITE_FLAGS";
+
+    /**
+     * Default. Allow create or update.
+     * @const AS_BIT_WRITE_DEFAULT
+     */
+    const AS_BIT_WRITE_DEFAULT = "AS_BIT_WRITE_DEFAULT";
+
+    /**
+     * Only create the bytes bin, fail if it exists.
+     * @const AS_BIT_WRITE_CREATE_ONLY
+     */
+    const AS_BIT_WRITE_CREATE_ONLY = "AS_BIT_WRITE_CREATE_ONLY";
+
+    /**
+     * Only update the bytes bin, fail if it does not exist.
+     * @const AS_BIT_WRITE_UPDATE_ONLY
+     */
+    const AS_BIT_WRITE_UPDATE_ONLY = "AS_BIT_WRITE_UPDATE_ONLY";
+
+    /**
+     * Do not raise an error if the operation is denied due to write flag constraints.
+     * @const AS_BIT_WRITE_NO_FAIL
+     */
+    const AS_BIT_WRITE_NO_FAIL = "AS_BIT_WRITE_NO_FAIL";
+
+    /**
+     * Allow other valid operations to be committed if this one is denied due to write flag constraints.
+     * @const AS_BIT_WRITE_PARTIAL
+     */
+    const AS_BIT_WRITE_PARTIAL = "AS_BIT_WRITE_PARTIAL";
+
+    /**
+     * Default resize_flags of OP_BIT_RESIZE, grow or shrink at the end.
+     * @const AS_BIT_RESIZE_DEFAULT
+     */
+    const AS_BIT_RESIZE_DEFAULT = "AS_BIT_RESIZE_DEFAULT";
+
+    /**
+     * resize_flags adding or removing bytes at the front.
+     * @const AS_BIT_RESIZE_FROM_FRONT
+     */
+    const AS_BIT_RESIZE_FROM_FRONT = "AS_BIT_RESIZE_FROM_FRONT";
+
+    /**
+     * resize_flags only allowing the bytes to grow.
+     * @const AS_BIT_RESIZE_GROW_ONLY
+     */
+    const AS_BIT_RESIZE_GROW_ONLY = "AS_BIT_RESIZE_GROW_ONLY";
+
+    /**
+     * resize_flags only allowing the bytes to shrink.
+     * @const AS_BIT_RESIZE_SHRINK_ONLY
+     */
+    const AS_BIT_RESIZE_SHRINK_ONLY = "AS_BIT_RESIZE_SHRINK_ONLY";
+
+    /**
+     * Default overflow_action of OP_BIT_ADD and OP_BIT_SUBTRACT, fail the operation.
+     * @const AS_BIT_OVERFLOW_FAIL
+     */
+    const AS_BIT_OVERFLOW_FAIL = "AS_BIT_OVERFLOW_FAIL";
+
+    /**
+     * overflow_action keeping the minimum or maximum value.
+     * @const AS_BIT_OVERFLOW_SATURATE
+     */
+    const AS_BIT_OVERFLOW_SATURATE = "AS_BIT_OVERFLOW_SATURATE";
+
+    /**
+     * overflow_action wrapping the value around.
+     * @const AS_BIT_OVERFLOW_WRAP
+     */
+    const AS_BIT_OVERFLOW_WRAP = "AS_BIT_OVERFLOW_WRAP";
+
+    /**
+     * HLL policy flags declaring the behavior of HLL write operations
+     * @see Aerospike::AS_HLL_WRITE_DEFAULT
+     * @see Aerospike::AS_HLL_WRITE_CREATE_ONLY
+     * @see Aerospike::AS_HLL_WRITE_UPDATE_ONLY
+     * @see Aerospike::AS_HLL_WRITE_NO_FAIL
+     * @see Aerospike::AS_HLL_WRITE_ALLOW_FOLD
+     * @const OPT_HLL_WRITE_FLAGS
+     */
+    const OPT_HLL_WRITE_FLAGS = "OPT_HLL_WRITE_FLAGS";
+
+    /**
+     * Default. Allow create or update.
+     * @const AS_HLL_WRITE_DEFAULT
+     */
+    const AS_HLL_WRITE_DEFAULT = "AS_HLL_WRITE_DEFAULT";
+
+    /**
+     * Only create the HLL bin, fail if it exists.
+     * @const AS_HLL_WRITE_CREATE_ONLY
+     */
+    const AS_HLL_WRITE_CREATE_ONLY = "AS_HLL_WRITE_CREATE_ONLY";
+
+    /**
+     * Only update the HLL bin, fail if it does not exist.
+     * @const AS_HLL_WRITE_UPDATE_ONLY
+     */
+    const AS_HLL_WRITE_UPDATE_ONLY = "AS_HLL_WRITE_UPDATE_ONLY";
+
+    /**
+     * Do not raise an error if the operation is denied due to write flag constraints.
+     * @const AS_HLL_WRITE_NO_FAIL
+     */
+    const AS_HLL_WRITE_NO_FAIL = "AS_HLL_WRITE_NO_FAIL";
+
+    /**
+     * Allow the resulting HLL of a set union to be folded to the smallest index_bit_count of its sources.
+     * @const AS_HLL_WRITE_ALLOW_FOLD
+     */
+    const AS_HLL_WRITE_ALLOW_FOLD = "AS_HLL_WRITE_ALLOW_FOLD";
+
 
     /**
      * @const LOG_LEVEL_OFF
@@ -4381,6 +5492,12 @@ class Aerospike {
      * @const ERR_ASYNC_CONNECTION
      */
     const ERR_ASYNC_CONNECTION = "AEROSPIKE_ERR_ASYNC_CONNECTION";
+
+    /**
+     * No response was received for the key, its node failed before answering
+     * @const ERR_NO_RESPONSE
+     */
+    const ERR_NO_RESPONSE = "AEROSPIKE_NO_RESPONSE";
     /**
      * Query or scan was aborted in user's callback
      * @const ERR_CLIENT_ABORT
@@ -4550,6 +5667,11 @@ class Aerospike {
      * @const ERR_FAIL_ELEMENT_EXISTS
      */
     const ERR_FAIL_ELEMENT_EXISTS = "AEROSPIKE_ERR_FAIL_ELEMENT_EXISTS";
+    /**
+     * The record was rejected by the OPT_FILTER_EXP of the command
+     * @const ERR_FILTERED_OUT
+     */
+    const ERR_FILTERED_OUT = "AEROSPIKE_FILTERED_OUT";
 
     // 50-89 - Security Specific Errors
 
@@ -4854,6 +5976,91 @@ class Aerospike {
      * @const OP_LIST_SIZE
      */
     const OP_LIST_SIZE = "OP_LIST_SIZE";
+    /**
+     * list-set-order operator for the operate() method
+     * @const OP_LIST_SET_ORDER
+     */
+    const OP_LIST_SET_ORDER = "OP_LIST_SET_ORDER";
+    /**
+     * list-sort operator for the operate() method
+     * @const OP_LIST_SORT
+     */
+    const OP_LIST_SORT = "OP_LIST_SORT";
+    /**
+     * list-increment operator for the operate() method
+     * @const OP_LIST_INCREMENT
+     */
+    const OP_LIST_INCREMENT = "OP_LIST_INCREMENT";
+    /**
+     * list-get-by-index operator for the operate() method
+     * @const OP_LIST_GET_BY_INDEX
+     */
+    const OP_LIST_GET_BY_INDEX = "OP_LIST_GET_BY_INDEX";
+    /**
+     * list-get-by-index-range operator for the operate() method
+     * @const OP_LIST_GET_BY_INDEX_RANGE
+     */
+    const OP_LIST_GET_BY_INDEX_RANGE = "OP_LIST_GET_BY_INDEX_RANGE";
+    /**
+     * list-get-by-rank operator for the operate() method
+     * @const OP_LIST_GET_BY_RANK
+     */
+    const OP_LIST_GET_BY_RANK = "OP_LIST_GET_BY_RANK";
+    /**
+     * list-get-by-rank-range operator for the operate() method
+     * @const OP_LIST_GET_BY_RANK_RANGE
+     */
+    const OP_LIST_GET_BY_RANK_RANGE = "OP_LIST_GET_BY_RANK_RANGE";
+    /**
+     * list-get-by-value operator for the operate() method
+     * @const OP_LIST_GET_BY_VALUE
+     */
+    const OP_LIST_GET_BY_VALUE = "OP_LIST_GET_BY_VALUE";
+    /**
+     * list-get-by-value-list operator for the operate() method
+     * @const OP_LIST_GET_BY_VALUE_LIST
+     */
+    const OP_LIST_GET_BY_VALUE_LIST = "OP_LIST_GET_BY_VALUE_LIST";
+    /**
+     * list-get-by-value-range operator for the operate() method
+     * @const OP_LIST_GET_BY_VALUE_RANGE
+     */
+    const OP_LIST_GET_BY_VALUE_RANGE = "OP_LIST_GET_BY_VALUE_RANGE";
+    /**
+     * list-remove-by-index operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_INDEX
+     */
+    const OP_LIST_REMOVE_BY_INDEX = "OP_LIST_REMOVE_BY_INDEX";
+    /**
+     * list-remove-by-index-range operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_INDEX_RANGE
+     */
+    const OP_LIST_REMOVE_BY_INDEX_RANGE = "OP_LIST_REMOVE_BY_INDEX_RANGE";
+    /**
+     * list-remove-by-rank operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_RANK
+     */
+    const OP_LIST_REMOVE_BY_RANK = "OP_LIST_REMOVE_BY_RANK";
+    /**
+     * list-remove-by-rank-range operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_RANK_RANGE
+     */
+    const OP_LIST_REMOVE_BY_RANK_RANGE = "OP_LIST_REMOVE_BY_RANK_RANGE";
+    /**
+     * list-remove-by-value operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_VALUE
+     */
+    const OP_LIST_REMOVE_BY_VALUE = "OP_LIST_REMOVE_BY_VALUE";
+    /**
+     * list-remove-by-value-list operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_VALUE_LIST
+     */
+    const OP_LIST_REMOVE_BY_VALUE_LIST = "OP_LIST_REMOVE_BY_VALUE_LIST";
+    /**
+     * list-remove-by-value-range operator for the operate() method
+     * @const OP_LIST_REMOVE_BY_VALUE_RANGE
+     */
+    const OP_LIST_REMOVE_BY_VALUE_RANGE = "OP_LIST_REMOVE_BY_VALUE_RANGE";
 
     // Map operation constants
 
@@ -4912,6 +6119,16 @@ class Aerospike {
      * @const OP_MAP_GET_BY_RANK_RANGE
      */
     const OP_MAP_GET_BY_RANK_RANGE = "OP_MAP_GET_BY_RANK_RANGE";
+    /**
+     * map-get-by-key-list operator for the operate() method
+     * @const OP_MAP_GET_BY_KEY_LIST
+     */
+    const OP_MAP_GET_BY_KEY_LIST = "OP_MAP_GET_BY_KEY_LIST";
+    /**
+     * map-get-by-value-list operator for the operate() method
+     * @const OP_MAP_GET_BY_VALUE_LIST
+     */
+    const OP_MAP_GET_BY_VALUE_LIST = "OP_MAP_GET_BY_VALUE_LIST";
     /**
      * map-put  operator for the operate() method
      * @const OP_MAP_PUT
@@ -4982,6 +6199,187 @@ class Aerospike {
      * @const OP_MAP_REMOVE_BY_RANK_RANGE
      */
     const OP_MAP_REMOVE_BY_RANK_RANGE = "OP_MAP_REMOVE_BY_RANK_RANGE";
+    // Bit operation constants
+    /**
+     * bit-resize operator for the operate() method
+     * @const OP_BIT_RESIZE
+     */
+    const OP_BIT_RESIZE = "OP_BIT_RESIZE";
+    /**
+     * bit-insert operator for the operate() method
+     * @const OP_BIT_INSERT
+     */
+    const OP_BIT_INSERT = "OP_BIT_INSERT";
+    /**
+     * bit-remove operator for the operate() method
+     * @const OP_BIT_REMOVE
+     */
+    const OP_BIT_REMOVE = "OP_BIT_REMOVE";
+    /**
+     * bit-set operator for the operate() method
+     * @const OP_BIT_SET
+     */
+    const OP_BIT_SET = "OP_BIT_SET";
+    /**
+     * bit-or operator for the operate() method
+     * @const OP_BIT_OR
+     */
+    const OP_BIT_OR = "OP_BIT_OR";
+    /**
+     * bit-xor operator for the operate() method
+     * @const OP_BIT_XOR
+     */
+    const OP_BIT_XOR = "OP_BIT_XOR";
+    /**
+     * bit-and operator for the operate() method
+     * @const OP_BIT_AND
+     */
+    const OP_BIT_AND = "OP_BIT_AND";
+    /**
+     * bit-not operator for the operate() method
+     * @const OP_BIT_NOT
+     */
+    const OP_BIT_NOT = "OP_BIT_NOT";
+    /**
+     * bit-lshift operator for the operate() method
+     * @const OP_BIT_LSHIFT
+     */
+    const OP_BIT_LSHIFT = "OP_BIT_LSHIFT";
+    /**
+     * bit-rshift operator for the operate() method
+     * @const OP_BIT_RSHIFT
+     */
+    const OP_BIT_RSHIFT = "OP_BIT_RSHIFT";
+    /**
+     * bit-add operator for the operate() method
+     * @const OP_BIT_ADD
+     */
+    const OP_BIT_ADD = "OP_BIT_ADD";
+    /**
+     * bit-subtract operator for the operate() method
+     * @const OP_BIT_SUBTRACT
+     */
+    const OP_BIT_SUBTRACT = "OP_BIT_SUBTRACT";
+    /**
+     * bit-set-int operator for the operate() method
+     * @const OP_BIT_SET_INT
+     */
+    const OP_BIT_SET_INT = "OP_BIT_SET_INT";
+    /**
+     * bit-get operator for the operate() method
+     * @const OP_BIT_GET
+     */
+    const OP_BIT_GET = "OP_BIT_GET";
+    /**
+     * bit-count operator for the operate() method
+     * @const OP_BIT_COUNT
+     */
+    const OP_BIT_COUNT = "OP_BIT_COUNT";
+    /**
+     * bit-lscan operator for the operate() method
+     * @const OP_BIT_LSCAN
+     */
+    const OP_BIT_LSCAN = "OP_BIT_LSCAN";
+    /**
+     * bit-rscan operator for the operate() method
+     * @const OP_BIT_RSCAN
+     */
+    const OP_BIT_RSCAN = "OP_BIT_RSCAN";
+    /**
+     * bit-get-int operator for the operate() method
+     * @const OP_BIT_GET_INT
+     */
+    const OP_BIT_GET_INT = "OP_BIT_GET_INT";
+    /**
+     * hll-init operator for the operate() method
+     * @const OP_HLL_INIT
+     */
+    const OP_HLL_INIT = "OP_HLL_INIT";
+    /**
+     * hll-add operator for the operate() method
+     * @const OP_HLL_ADD
+     */
+    const OP_HLL_ADD = "OP_HLL_ADD";
+    /**
+     * hll-set-union operator for the operate() method
+     * @const OP_HLL_SET_UNION
+     */
+    const OP_HLL_SET_UNION = "OP_HLL_SET_UNION";
+    /**
+     * hll-refresh-count operator for the operate() method
+     * @const OP_HLL_REFRESH_COUNT
+     */
+    const OP_HLL_REFRESH_COUNT = "OP_HLL_REFRESH_COUNT";
+    /**
+     * hll-fold operator for the operate() method
+     * @const OP_HLL_FOLD
+     */
+    const OP_HLL_FOLD = "OP_HLL_FOLD";
+    /**
+     * hll-get-count operator for the operate() method
+     * @const OP_HLL_GET_COUNT
+     */
+    const OP_HLL_GET_COUNT = "OP_HLL_GET_COUNT";
+    /**
+     * hll-get-union operator for the operate() method
+     * @const OP_HLL_GET_UNION
+     */
+    const OP_HLL_GET_UNION = "OP_HLL_GET_UNION";
+    /**
+     * hll-get-union-count operator for the operate() method
+     * @const OP_HLL_GET_UNION_COUNT
+     */
+    const OP_HLL_GET_UNION_COUNT = "OP_HLL_GET_UNION_COUNT";
+    /**
+     * hll-get-intersect-count operator for the operate() method
+     * @const OP_HLL_GET_INTERSECT_COUNT
+     */
+    const OP_HLL_GET_INTERSECT_COUNT = "OP_HLL_GET_INTERSECT_COUNT";
+    /**
+     * hll-get-similarity operator for the operate() method
+     * @const OP_HLL_GET_SIMILARITY
+     */
+    const OP_HLL_GET_SIMILARITY = "OP_HLL_GET_SIMILARITY";
+    /**
+     * hll-describe operator for the operate() method
+     * @const OP_HLL_DESCRIBE
+     */
+    const OP_HLL_DESCRIBE = "OP_HLL_DESCRIBE";
+    /**
+     * ctx step selecting the list element at an index, negative from the end
+     * @const CDT_CTX_LIST_INDEX
+     */
+    const CDT_CTX_LIST_INDEX = "CDT_CTX_LIST_INDEX";
+    /**
+     * ctx step selecting the list element of a rank, -1 is the largest
+     * @const CDT_CTX_LIST_RANK
+     */
+    const CDT_CTX_LIST_RANK = "CDT_CTX_LIST_RANK";
+    /**
+     * ctx step selecting the first list element equal to a value
+     * @const CDT_CTX_LIST_VALUE
+     */
+    const CDT_CTX_LIST_VALUE = "CDT_CTX_LIST_VALUE";
+    /**
+     * ctx step selecting the map entry at an index in key order
+     * @const CDT_CTX_MAP_INDEX
+     */
+    const CDT_CTX_MAP_INDEX = "CDT_CTX_MAP_INDEX";
+    /**
+     * ctx step selecting the map entry of a value rank
+     * @const CDT_CTX_MAP_RANK
+     */
+    const CDT_CTX_MAP_RANK = "CDT_CTX_MAP_RANK";
+    /**
+     * ctx step selecting the map entry of a key
+     * @const CDT_CTX_MAP_KEY
+     */
+    const CDT_CTX_MAP_KEY = "CDT_CTX_MAP_KEY";
+    /**
+     * ctx step selecting the first map entry with a value
+     * @const CDT_CTX_MAP_VALUE
+     */
+    const CDT_CTX_MAP_VALUE = "CDT_CTX_MAP_VALUE";
 
     // Query Predicate Operators
 
@@ -0,0 +1,88 @@
+<?php
+################################################################################
+# Copyright 2013-2015 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+require_once(realpath(__DIR__ . '/../examples_util.php'));
+
+function parse_args() {
+    $shortopts  = "";
+    $shortopts .= "h::";  /* Optional host */
+    $shortopts .= "p::";  /* Optional port */
+    $shortopts .= "n::";  /* Optionally number of calls per method */
+
+    $longopts  = array(
+        "host::",         /* Optional host */
+        "port::",         /* Optional port */
+        "num-ops::",      /* Optionally number of calls per method */
+        "help",           /* Usage */
+    );
+    $options = getopt($shortopts, $longopts);
+    return $options;
+}
+
+$args = parse_args();
+if (isset($args["help"])) {
+    echo "php dispatch.php [-hHOST] [-pPORT] [-nCALLS]\n";
+    echo " or\n";
+    echo "php dispatch.php [--host=HOST] [--port=PORT] [--num-ops=CALLS]\n";
+    exit(1);
+}
+$addr = (isset($args["h"])) ? (string) $args["h"] : ((isset($args["host"])) ? (string) $args["host"] : "localhost");
+$port = (isset($args["p"])) ? (integer) $args["p"] : ((isset($args["port"])) ? (string) $args["port"] : 3000);
+$total_ops = (isset($args["n"])) ? (integer) $args["n"] : ((isset($args["num-ops"])) ? (string) $args["num-ops"] : 1000000);
+
+echo colorize("Connecting to the host ≻", 'black', true);
+$config = array("hosts" => array(array("addr" => $addr, "port" => $port)));
+$db = new Aerospike($config, false);
+if (!$db->isConnected()) {
+    echo fail("Could not connect to host $addr:$port [{$db->errorno()}]: {$db->error()}");
+    exit(1);
+}
+echo success();
+
+# The key has no namespace, so every call is rejected once its arguments are
+# parsed and its key is read, without a command going to the cluster. What is
+# timed is the cost of calling into the extension.
+$key = array("set" => "performance", "key" => "dispatch");
+$bins = array("v" => 1);
+$ops = array(array("op" => Aerospike::OPERATOR_READ, "bin" => "v"));
+$keys = array($key);
+$methods = array(
+    "isConnected" => function($db, $key) { return $db->isConnected(); },
+    "get" => function($db, $key) { return $db->get($key, $record); },
+    "put" => function($db, $key) use ($bins) { return $db->put($key, $bins); },
+    "exists" => function($db, $key) { return $db->exists($key, $metadata); },
+    "remove" => function($db, $key) { return $db->remove($key); },
+    "touch" => function($db, $key) { return $db->touch($key, 60); },
+    "increment" => function($db, $key) { return $db->increment($key, "v", 1); },
+    "operate" => function($db, $key) use ($ops) { return $db->operate($key, $ops, $record); },
+    "operateOrdered" => function($db, $key) use ($ops) { return $db->operateOrdered($key, $ops, $record); },
+    "getMany" => function($db, $key) use ($keys) { return $db->getMany($keys, $records); },
+    "existsMany" => function($db, $key) use ($keys) { return $db->existsMany($keys, $metadata); },
+);
+
+echo colorize("Calling each method $total_ops times\n", 'black', true);
+foreach ($methods as $name => $call) {
+    $begin = microtime(true);
+    for ($num_ops = 0; $num_ops < $total_ops; $num_ops++) {
+        $call($db, $key);
+    }
+    $end = microtime(true);
+    $per_call = (($end - $begin) / $total_ops) * 1000000000;
+    echo colorize(sprintf("%-16s %8.1f ns/call\n", $name, $per_call), 'purple', true);
+}
+
+$db->close();
+?>
@@ -13,6 +13,12 @@
 #include "php_aerospike_types.h"
 #include "aerospike_class.h"
 #include "persistent_list.h"
+#include "aerospike_async.h"
+#include "record_iterator.h"
+#include "expressions.h"
+#include "compiled_policy.h"
+#include "compiled_operations.h"
+#include "prepared_query.h"
 // #include "include/constants.h"
 
 
@@ -41,10 +47,13 @@ PHP_INI_BEGIN()
     STD_PHP_INI_ENTRY("aerospike.shm.max_nodes", "16", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, shm_max_nodes, zend_aerospike_globals, aerospike_globals)
     STD_PHP_INI_ENTRY("aerospike.shm.max_namespaces", "8", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, shm_max_namespaces, zend_aerospike_globals, aerospike_globals)
     STD_PHP_INI_ENTRY("aerospike.shm.takeover_threshold_sec", "30", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, shm_takeover_threshold_sec, zend_aerospike_globals, aerospike_globals)
+    STD_PHP_INI_ENTRY("aerospike.min_conns_per_node", "0", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, min_conns_per_node, zend_aerospike_globals, aerospike_globals)
+    STD_PHP_INI_ENTRY("aerospike.persistent.max_idle", "0", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, persistent_max_idle, zend_aerospike_globals, aerospike_globals)
     STD_PHP_INI_ENTRY("aerospike.max_threads", "300", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, max_threads, zend_aerospike_globals, aerospike_globals)
 	// This causes issues consider removal
     STD_PHP_INI_ENTRY("aerospike.thread_pool_size", "16", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, thread_pool_size, zend_aerospike_globals, aerospike_globals)
     STD_PHP_INI_ENTRY("aerospike.compression_threshold", "0", PHP_INI_PERDIR|PHP_INI_SYSTEM|PHP_INI_USER, OnUpdateLong, compression_threshold, zend_aerospike_globals, aerospike_globals)
+    STD_PHP_INI_ENTRY("aerospike.async.event_loops", "0", PHP_INI_SYSTEM, OnUpdateLong, async_event_loops, zend_aerospike_globals, aerospike_globals)
 PHP_INI_END()
 
 /* }}} */
@@ -73,7 +82,6 @@ PHP_GINIT_FUNCTION(aerospike) {
 #endif
 
 
-	pthread_mutex_init(&aerospike_globals->query_cb_mutex, NULL);
 	as_error_init(&(aerospike_globals->global_error));
 	aerospike_globals->is_global_user_deserializer_registered = false;
 	memset(&aerospike_globals->user_global_deserializer_call_info, 0, sizeof(zend_fcall_info));
@@ -84,16 +92,23 @@ PHP_GINIT_FUNCTION(aerospike) {
 	memset(&aerospike_globals->user_global_serializer_call_info_cache, 0, sizeof(zend_fcall_info_cache));
 
 	aerospike_globals->is_log_callback_registered = false;
+	aerospike_globals->delivering_logs = false;
 	memset(&aerospike_globals->log_callback_call_info, 0, sizeof(zend_fcall_info));
 	memset(&aerospike_globals->log_callback_call_info_cache, 0, sizeof(zend_fcall_info_cache));
 
 	/* Create the global host list */
 	aerospike_globals->persistent_list_g = (HashTable*)pemalloc(sizeof(HashTable), 1);
+
+	aerospike_globals->completion_queue = NULL;
+	aerospike_globals->pending_callbacks = NULL;
 }
 
 PHP_GSHUTDOWN_FUNCTION(aerospike) {
     zend_hash_destroy(aerospike_globals->persistent_list_g);
     pefree(aerospike_globals->persistent_list_g, 1);
+	if (aerospike_globals->completion_queue) {
+		as_php_completion_queue_release(aerospike_globals->completion_queue);
+	}
 	return;
 }
 
@@ -103,9 +118,17 @@ PHP_MINIT_FUNCTION(aerospike)
 	REGISTER_INI_ENTRIES();
 	/* initialize the hash table */
 	zend_hash_init(AEROSPIKE_G(persistent_list_g), 8, NULL, persistent_host_dtor, 1);
+	as_php_log_queue_init();
 
 
 	register_aerospike_class();
+	register_aerospike_future_class();
+	register_aerospike_pipeline_class();
+	register_aerospike_record_iterator_class();
+	register_aerospike_exp_class();
+	register_aerospike_policy_class();
+	register_aerospike_operations_class();
+	register_aerospike_prepared_query_classes();
 	php_session_register_module(&ps_mod_aerospike);
 
 	return SUCCESS;
@@ -119,6 +142,11 @@ PHP_MSHUTDOWN_FUNCTION(aerospike)
 	/* uncomment this line if you have INI entries*/
 	UNREGISTER_INI_ENTRIES();
 
+	/* The persistent clusters have to be closed while the event loops still run */
+	zend_hash_clean(AEROSPIKE_G(persistent_list_g));
+	shutdown_async_event_loops();
+	as_php_log_queue_destroy();
+
 	return SUCCESS;
 }
 /* }}} */
@@ -142,6 +170,7 @@ PHP_RINIT_FUNCTION(aerospike)
 	AEROSPIKE_G(is_global_user_deserializer_registered) = false;
 	AEROSPIKE_G(is_global_user_serializer_registered) = false;
 	AEROSPIKE_G(is_log_callback_registered) = false;
+	AEROSPIKE_G(delivering_logs) = false;
 
 	return SUCCESS;
 }
@@ -160,10 +189,19 @@ PHP_RSHUTDOWN_FUNCTION(aerospike)
 		zval_dtor(&AEROSPIKE_G(user_global_deserializer_call_info).function_name);
 	}
 
+	/* The handler of this request goes away with it, it gets the events still queued */
+	deliver_pending_log_events();
 	if AEROSPIKE_G(is_log_callback_registered) {
 		zval_dtor(&AEROSPIKE_G(log_callback_call_info).function_name);
 	}
 
+	/* Futures whose callback never ran are freed with the request */
+	if (AEROSPIKE_G(pending_callbacks)) {
+		zend_hash_destroy(AEROSPIKE_G(pending_callbacks));
+		FREE_HASHTABLE(AEROSPIKE_G(pending_callbacks));
+		AEROSPIKE_G(pending_callbacks) = NULL;
+	}
+
 	return SUCCESS;
 }
 /* }}} */
@@ -17,7 +17,7 @@
 
 export CLIENTREPO_3X=${PWD}/../aerospike-client-c
 
-export AEROSPIKE_C_VERSION=${AEROSPIKE_C_CLIENT:-4.6.9}
+export AEROSPIKE_C_VERSION=${AEROSPIKE_C_CLIENT:-6.0.0}
 export DOWNLOAD_C_CLIENT=${DOWNLOAD_C_CLIENT:-1}
 export LUA_USRPATH=${LUA_USRPATH:-/usr/local/aerospike/usr-lua}
 
@@ -140,6 +140,19 @@ else
     LDFLAGS="$LDFLAGS $LIBCRYPTO -lrt"
 fi
 
+# Async commands need the C client package built with an event library
+case "$AEROSPIKE_C_FLAVOR" in
+    libev)
+        LDFLAGS="$LDFLAGS -lev"
+        ;;
+    libuv)
+        LDFLAGS="$LDFLAGS -luv"
+        ;;
+    libevent)
+        LDFLAGS="$LDFLAGS -levent_core -levent_pthreads"
+        ;;
+esac
+
 make clean all "CFLAGS=$CFLAGS" "EXTRA_INCLUDES+=-I$CLIENTREPO_3X/include -I$CLIENTREPO_3X/include/ck $AS_OSX_OPENSSL_INC" "EXTRA_LDFLAGS=$LDFLAGS $AS_OSX_OPENSSL_LINK"
 
 if [ $? -gt 0 ] ; then
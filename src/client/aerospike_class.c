@@ -23,6 +23,7 @@
 
 #include "conversions.h"
 #include "aerospike/aerospike.h"
+#include "aerospike/as_atomic.h"
 #include "aerospike_class.h"
 #include "php_aerospike_types.h"
 #include "register_policy_constants.h"
@@ -34,6 +35,7 @@
 #include "zend_exceptions.h"
 #include <stdbool.h>
 #include "aerospike_session.h"
+#include "aerospike_async.h"
 // SETUP FUNCTIONS
 
 
@@ -41,7 +43,14 @@
 static void set_as_config_from_ini(as_config* config);
 static as_status set_as_config(as_config* config, HashTable* z_conf_hash);
 static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClient* client, HashTable* policy_hash);
-static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_hash);
+static as_status set_policies_from_hash(as_policies* policies, HashTable* policy_hash);
+static as_status set_subpolicies_from_hash(as_policies* policies, HashTable* policy_hash);
+static as_status set_policy_profiles_from_hash(AerospikeClient* client, as_policies* defaults, HashTable* policy_hash);
+static as_php_policy_profile* add_policy_profile(HashTable* profiles, zend_string* name, as_policies* defaults,
+		HashTable* z_options);
+static HashTable* new_policy_profiles(uint32_t size);
+static void destroy_policy_profiles(HashTable* profiles);
+static void policy_profile_dtor(zval* z_profile);
 static as_status add_hosts_from_zhash(as_config* config, HashTable* z_hosts);
 
 static void aerospike_object_destructor(zend_object *object);
@@ -50,6 +59,8 @@ static void aerospike_object_free_storage(zend_object *object);
 /* Actually global variables here*/
 zend_class_entry     *aerospike_ce;
 zend_object_handlers aerospike_ce_handlers;
+/* The id of the last client created by any thread */
+static uint64_t last_client_id = 0;
 static zend_function_entry Aerospike_class_functions[] =
 {
     /*
@@ -101,6 +112,7 @@ static zend_function_entry Aerospike_class_functions[] =
 	PHP_ME(Aerospike, setDeserializer, set_deserializer_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	PHP_ME(Aerospike, setSerializer, set_serializer_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	PHP_ME(Aerospike, shmKey, shm_key_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, persistentStats, persistent_stats_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	PHP_ME(Aerospike, truncate, truncate_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, touch, touch_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, predicateEquals, predicate_equals_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
@@ -114,10 +126,17 @@ static zend_function_entry Aerospike_class_functions[] =
 	PHP_ME(Aerospike, setLogLevel, set_log_level_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, setLogHandler, set_log_handler_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, scan, scan_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, scanPartitions, scan_partitions_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, scanApply, scan_apply_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, scanOperate, scan_operate_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, scanInfo, scan_info_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, query, query_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, scanIterator, scan_iterator_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, queryIterator, query_iterator_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, prepareScan, prepare_scan_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, prepareQuery, prepare_query_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, queryApply, query_apply_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, queryOperate, query_operate_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, aggregate, aggregate_arg_info, ZEND_ACC_PUBLIC)
 	/* Info Methods */
 	PHP_ME(Aerospike, info, info_arg_info, ZEND_ACC_PUBLIC)
@@ -125,7 +144,15 @@ static zend_function_entry Aerospike_class_functions[] =
 	PHP_ME(Aerospike, infoMany, info_many_arg_info, ZEND_ACC_PUBLIC)
 	/* Batch Methods */
 	PHP_ME(Aerospike, existsMany, exists_many_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, existsManyCompact, exists_many_compact_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, getMany, get_many_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, hllGetUnion, hll_get_union_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, hllGetUnionCount, hll_get_union_count_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, getAsync, get_async_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, awaitAll, await_all_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(Aerospike, pipeline, pipeline_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(Aerospike, completionStream, completion_stream_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(Aerospike, poll, poll_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	/* Security Methods */
 	PHP_ME(Aerospike, changePassword, change_password_arg_info, ZEND_ACC_PUBLIC)
 	PHP_ME(Aerospike, setPassword, set_password_arg_info, ZEND_ACC_PUBLIC)
@@ -185,6 +212,14 @@ static void aerospike_object_free_storage(zend_object *object TSRMLS_DC) {
 		aerospike_close(client->as_client, &err);
 		aerospike_destroy(client->as_client);
 	}
+	if (client->is_persistent && client->persistent_host) {
+		release_persistent_host(client->persistent_host);
+		client->persistent_host = NULL;
+	}
+	if (client->policy_profiles) {
+		destroy_policy_profiles(client->policy_profiles);
+		client->policy_profiles = NULL;
+	}
 	client->is_valid = false;
 	zend_object_std_dtor(object);
  	return;
@@ -207,6 +242,7 @@ zend_object *aerospike_create_object(zend_class_entry *ce)
 
     aerospike_obj = ecalloc(1, sizeof(*aerospike_obj) + zend_object_properties_size(ce));
     aerospike_obj->as_client = NULL;
+    aerospike_obj->id = as_aaf_uint64(&last_client_id, 1);
 
     zend_object_std_init(&aerospike_obj->zobj, ce);
     object_properties_init(&aerospike_obj->zobj, ce);
@@ -274,12 +310,6 @@ PHP_METHOD(Aerospike, __construct)
 	as_error_init(&err);
 	as_config_init(&config);
 
-	/*Parallel threads on scan/query cause issues in ZTS mode */
-#ifdef ZTS
-	config.thread_pool_size = 0;
-#endif
-
-
 	/* Add each of the host entries to the as_config.hosts struct */
 	status = add_hosts_from_zhash(&config, Z_ARRVAL_P(z_hosts));
 	if (status != AEROSPIKE_OK) {
@@ -306,10 +336,15 @@ PHP_METHOD(Aerospike, __construct)
 		RETURN_LONG(AEROSPIKE_ERR_CLIENT);
 	}
 	client->is_valid = true;
+
+	/* The event loops must exist before the first cluster of the process connects */
+	init_async_event_loops();
+
 	/* Handle use of persistent connection*/
 	if (persistent) {
 		client->is_persistent = true;
 		status = persistent_connect(client);
+		deliver_pending_log_events();
 		if (status != AEROSPIKE_OK) {
 			zend_throw_exception(NULL, "Failed to connect", 0);
 			RETURN_LONG(status);
@@ -317,6 +352,7 @@ PHP_METHOD(Aerospike, __construct)
 	} else {
 		client->is_persistent = false;
 		status = non_persistent_connect(client);
+		deliver_pending_log_events();
 		if (status != AEROSPIKE_OK) {
 			zend_throw_exception(NULL, "Failed to connect", 0);
 			RETURN_LONG(status);
@@ -498,6 +534,18 @@ PHP_METHOD(Aerospike, shmKey) {
 }
 /* }}} */
 
+/* {{{ proto array Aerospike::persistentStats( void )
+    Returns an entry per persistent cluster connection held by the process */
+PHP_METHOD(Aerospike, persistentStats) {
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	array_init(return_value);
+	persistent_hosts_to_zval(return_value);
+}
+/* }}} */
+
 
 /* {{{ proto Aerospike::close( void )
     Closes the client's connections to the cluster. No-op if the connection is shared */
@@ -614,13 +662,16 @@ static as_status add_hosts_from_zhash(as_config* config, HashTable* z_hosts) {
  * This is a helper function to set the following fields for the constructor
  * username
  * password
+ * auth_mode
+ * login_timeout
  * shm (dict) with following keys:
  * 		shm_key
  * 		shm_max_nodes
  * 		shm_max_namespaces
  * 		shm_takeover_threshold_sec
  * 	max_threads
- * 	thread_pool_size (Always zero when using ZTS)
+ * 	min_conns_per_node
+ * 	thread_pool_size
  * 	compression_threshold
  */
 static as_status set_as_config(as_config* config, HashTable* z_conf_hash) {
@@ -701,6 +752,23 @@ static as_status set_as_config(as_config* config, HashTable* z_conf_hash) {
 		}
 	}
 
+	setting_value = zend_hash_str_find(z_conf_hash, "auth_mode", strlen("auth_mode"));
+	if (setting_value) {
+		if (Z_TYPE_P(setting_value) != IS_LONG || Z_LVAL_P(setting_value) < AS_AUTH_INTERNAL ||
+				Z_LVAL_P(setting_value) > AS_AUTH_EXTERNAL_INSECURE) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		config->auth_mode = (as_auth_mode)Z_LVAL_P(setting_value);
+	}
+
+	setting_value = zend_hash_str_find(z_conf_hash, "login_timeout", strlen("login_timeout"));
+	if (setting_value) {
+		if (Z_TYPE_P(setting_value) != IS_LONG || Z_LVAL_P(setting_value) < 0) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		config->login_timeout_ms = (uint32_t)Z_LVAL_P(setting_value);
+	}
+
 	setting_value = zend_hash_str_find(z_conf_hash, "max_threads", strlen("max_threads"));
 	if (setting_value) {
 		if (Z_TYPE_P(setting_value) != IS_LONG) {
@@ -709,17 +777,21 @@ static as_status set_as_config(as_config* config, HashTable* z_conf_hash) {
 		config->max_conns_per_node = Z_LVAL_P(setting_value);
 	}
 
+	/* The C client opens these when it adds a node, then the tender tops the pool up to them */
+	setting_value = zend_hash_str_find(z_conf_hash, "min_conns_per_node", strlen("min_conns_per_node"));
+	if (setting_value) {
+		if (Z_TYPE_P(setting_value) != IS_LONG || Z_LVAL_P(setting_value) < 0) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		config->min_conns_per_node = Z_LVAL_P(setting_value);
+	}
+
 	setting_value = zend_hash_str_find(z_conf_hash, "thread_pool_size", strlen("thread_pool_size"));
 	if (setting_value) {
 		if (Z_TYPE_P(setting_value) != IS_LONG) {
 			return AEROSPIKE_ERR_PARAM;
 		}
 		config->thread_pool_size = Z_LVAL_P(setting_value);
-/* Using a larger thead pool will crash zts builds, so force it to be 0 */
-#ifdef ZTS
-	config->thread_pool_size = 0;
-#endif
-
 	}
 
 	setting_value = zend_hash_str_find(z_conf_hash, "compression_threshold", strlen("compression_threshold"));
@@ -777,12 +849,9 @@ static void set_as_config_from_ini(as_config* config) {
 	config->shm_takeover_threshold_sec = INI_INT("aerospike.shm.takeover_threshold_sec");
 	config->shm_max_nodes = INI_INT("aerospike.shm.max_nodes");
 
-#ifdef ZTS
-	config->thread_pool_size = 0;
-#else
 	config->thread_pool_size = INI_INT("aerospike.thread_pool_size");
-#endif
 	config->max_conns_per_node = INI_INT("aerospike.max_threads");
+	config->min_conns_per_node = INI_INT("aerospike.min_conns_per_node");
 
 	config->policies.write.compression_threshold = INI_INT("aerospike.compression_threshold");
 
@@ -816,15 +885,37 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			config->use_services_alternate = Z_LVAL_P(policy_zval);
 	}
 
+	policy_zval = zend_hash_index_find(policy_hash, OPT_SERIALIZER);
+	if (policy_zval) {
+		if (Z_TYPE_P(policy_zval) != IS_LONG) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		client->serializer_type = Z_LVAL_P(policy_zval);
+	}
+
+	if (set_policies_from_hash(&config->policies, policy_hash) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	return set_policy_profiles_from_hash(client, &config->policies, policy_hash);
+}
+
+/*
+ * Set the policies the options of the constructor and those of a policy profile have in common
+ */
+static as_status set_policies_from_hash(as_policies* policies, HashTable* policy_hash) {
+	zval* policy_zval = NULL;
+	long int_ini_value;
+
 	policy_zval = zend_hash_index_find(policy_hash, OPT_READ_TIMEOUT);
 	if (policy_zval) {
 		if (Z_TYPE_P(policy_zval) != IS_LONG) {
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.base.total_timeout = int_ini_value;
-		config->policies.info.timeout = int_ini_value;
-		config->policies.batch.base.total_timeout = int_ini_value;
+		policies->read.base.total_timeout = int_ini_value;
+		policies->info.timeout = int_ini_value;
+		policies->batch.base.total_timeout = int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_WRITE_TIMEOUT);
@@ -833,10 +924,10 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.write.base.total_timeout = int_ini_value;
-		config->policies.operate.base.total_timeout = int_ini_value;
-		config->policies.remove.base.total_timeout = int_ini_value;
-		config->policies.apply.base.total_timeout = int_ini_value;
+		policies->write.base.total_timeout = int_ini_value;
+		policies->operate.base.total_timeout = int_ini_value;
+		policies->remove.base.total_timeout = int_ini_value;
+		policies->apply.base.total_timeout = int_ini_value;
 	}
 
 
@@ -846,13 +937,13 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.base.total_timeout = int_ini_value;
-		config->policies.info.timeout = int_ini_value;
-		config->policies.batch.base.total_timeout = int_ini_value;
-		config->policies.write.base.total_timeout = int_ini_value;
-		config->policies.operate.base.total_timeout = int_ini_value;
-		config->policies.remove.base.total_timeout = int_ini_value;
-		config->policies.apply.base.total_timeout = int_ini_value;
+		policies->read.base.total_timeout = int_ini_value;
+		policies->info.timeout = int_ini_value;
+		policies->batch.base.total_timeout = int_ini_value;
+		policies->write.base.total_timeout = int_ini_value;
+		policies->operate.base.total_timeout = int_ini_value;
+		policies->remove.base.total_timeout = int_ini_value;
+		policies->apply.base.total_timeout = int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_SOCKET_TIMEOUT);
@@ -861,12 +952,12 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.base.socket_timeout = int_ini_value;
-		config->policies.batch.base.socket_timeout = int_ini_value;
-		config->policies.write.base.socket_timeout = int_ini_value;
-		config->policies.operate.base.socket_timeout = int_ini_value;
-		config->policies.remove.base.socket_timeout = int_ini_value;
-		config->policies.apply.base.socket_timeout = int_ini_value;
+		policies->read.base.socket_timeout = int_ini_value;
+		policies->batch.base.socket_timeout = int_ini_value;
+		policies->write.base.socket_timeout = int_ini_value;
+		policies->operate.base.socket_timeout = int_ini_value;
+		policies->remove.base.socket_timeout = int_ini_value;
+		policies->apply.base.socket_timeout = int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_POLICY_KEY);
@@ -875,10 +966,10 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.key = (as_policy_key)int_ini_value;
-		config->policies.write.key = (as_policy_key)int_ini_value;
-		config->policies.operate.key = (as_policy_key)int_ini_value;
-		config->policies.remove.key = (as_policy_key)int_ini_value;
+		policies->read.key = (as_policy_key)int_ini_value;
+		policies->write.key = (as_policy_key)int_ini_value;
+		policies->operate.key = (as_policy_key)int_ini_value;
+		policies->remove.key = (as_policy_key)int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_POLICY_EXISTS);
@@ -887,7 +978,7 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.write.exists = (as_policy_exists)int_ini_value;
+		policies->write.exists = (as_policy_exists)int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_MAX_RETRIES);
@@ -896,14 +987,14 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.write.base.max_retries = int_ini_value;
-		config->policies.operate.base.max_retries = int_ini_value;
-		config->policies.remove.base.max_retries = int_ini_value;
-		config->policies.read.base.max_retries = int_ini_value;
-		config->policies.apply.base.max_retries = int_ini_value;
-		config->policies.query.base.max_retries = int_ini_value;
-		config->policies.scan.base.max_retries = int_ini_value;
-		config->policies.batch.base.max_retries = int_ini_value;
+		policies->write.base.max_retries = int_ini_value;
+		policies->operate.base.max_retries = int_ini_value;
+		policies->remove.base.max_retries = int_ini_value;
+		policies->read.base.max_retries = int_ini_value;
+		policies->apply.base.max_retries = int_ini_value;
+		policies->query.base.max_retries = int_ini_value;
+		policies->scan.base.max_retries = int_ini_value;
+		policies->batch.base.max_retries = int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_POLICY_COMMIT_LEVEL);
@@ -912,10 +1003,10 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.write.commit_level = (as_policy_commit_level)int_ini_value;
-		config->policies.remove.commit_level = (as_policy_commit_level)int_ini_value;
-		config->policies.operate.commit_level = (as_policy_commit_level)int_ini_value;
-		config->policies.apply.commit_level = (as_policy_commit_level)int_ini_value;
+		policies->write.commit_level = (as_policy_commit_level)int_ini_value;
+		policies->remove.commit_level = (as_policy_commit_level)int_ini_value;
+		policies->operate.commit_level = (as_policy_commit_level)int_ini_value;
+		policies->apply.commit_level = (as_policy_commit_level)int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_POLICY_READ_MODE_AP);
@@ -924,9 +1015,9 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
-		config->policies.operate.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
-		config->policies.batch.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
+		policies->read.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
+		policies->operate.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
+		policies->batch.read_mode_ap = (as_policy_read_mode_ap)int_ini_value;
 	}
 
 	policy_zval = zend_hash_index_find(policy_hash, OPT_POLICY_REPLICA);
@@ -935,28 +1026,20 @@ static as_status set_policy_defaults_from_hash(as_config* config, AerospikeClien
 			return AEROSPIKE_ERR_PARAM;
 		}
 		int_ini_value = Z_LVAL_P(policy_zval);
-		config->policies.read.replica = (as_policy_replica)int_ini_value;
-		config->policies.operate.replica = (as_policy_replica)int_ini_value;
+		policies->read.replica = (as_policy_replica)int_ini_value;
+		policies->operate.replica = (as_policy_replica)int_ini_value;
 	}
 
-	policy_zval = zend_hash_index_find(policy_hash, OPT_SERIALIZER);
-	if (policy_zval) {
-		if (Z_TYPE_P(policy_zval) != IS_LONG) {
-			return AEROSPIKE_ERR_PARAM;
-		}
-		client->serializer_type = Z_LVAL_P(policy_zval);
-	}
-
-	return set_subpolicies_from_hash(config, policy_hash);
+	return set_subpolicies_from_hash(policies, policy_hash);
 }
 
-static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_hash) {
+static as_status set_subpolicies_from_hash(as_policies* policies, HashTable* policy_hash) {
 	zval* z_subpolicy = NULL;
 
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_READ_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_read_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.read);
+			set_read_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->read);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -965,7 +1048,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_WRITE_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_write_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.write);
+			set_write_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->write);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -974,7 +1057,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_REMOVE_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_remove_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.remove);
+			set_remove_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->remove);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -983,7 +1066,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_BATCH_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_batch_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.batch);
+			set_batch_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->batch);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -992,7 +1075,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_OPERATE_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_operate_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.operate);
+			set_operate_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->operate);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -1001,7 +1084,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_QUERY_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_query_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.query);
+			set_query_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->query);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -1010,7 +1093,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_SCAN_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_scan_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.scan);
+			set_scan_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->scan);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -1019,7 +1102,7 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 	z_subpolicy = zend_hash_index_find(policy_hash, OPT_APPLY_DEFAULT_POL);
 	if (z_subpolicy) {
 		if (Z_TYPE_P(z_subpolicy) == IS_ARRAY) {
-			set_apply_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &config->policies.apply);
+			set_apply_policy_from_hash(Z_ARRVAL_P(z_subpolicy), &policies->apply);
 		} else {
 			return AEROSPIKE_ERR_PARAM;
 		}
@@ -1027,3 +1110,100 @@ static as_status set_subpolicies_from_hash(as_config* config, HashTable* policy_
 
 	return AEROSPIKE_OK;
 }
+
+/*
+ * Resolve the OPT_POLICY_PROFILES of the constructor, an array of namespace => options. The
+ * options of a namespace start from the client defaults, its "sets" entry holds set => options
+ * starting from the namespace ones. Commands then copy the profile of their key instead of
+ * parsing options for it.
+ */
+static as_status set_policy_profiles_from_hash(AerospikeClient* client, as_policies* defaults, HashTable* policy_hash) {
+	zval* z_profiles = NULL;
+	zval* z_profile = NULL;
+	zval* z_sets = NULL;
+	zval* z_set_profile = NULL;
+	zend_string* ns = NULL;
+	zend_string* set = NULL;
+	as_php_policy_profile* profile = NULL;
+
+	if (client->policy_profiles) {
+		destroy_policy_profiles(client->policy_profiles);
+		client->policy_profiles = NULL;
+	}
+
+	z_profiles = zend_hash_index_find(policy_hash, OPT_POLICY_PROFILES);
+	if (!z_profiles) {
+		return AEROSPIKE_OK;
+	}
+	if (Z_TYPE_P(z_profiles) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	client->policy_profiles = new_policy_profiles(zend_hash_num_elements(Z_ARRVAL_P(z_profiles)));
+
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(z_profiles), ns, z_profile) {
+		if (!ns || Z_TYPE_P(z_profile) != IS_ARRAY) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		profile = add_policy_profile(client->policy_profiles, ns, defaults, Z_ARRVAL_P(z_profile));
+		if (!profile) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+
+		z_sets = zend_hash_str_find(Z_ARRVAL_P(z_profile), "sets", strlen("sets"));
+		if (!z_sets) {
+			continue;
+		}
+		if (Z_TYPE_P(z_sets) != IS_ARRAY) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+
+		profile->set_profiles = new_policy_profiles(zend_hash_num_elements(Z_ARRVAL_P(z_sets)));
+		ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(z_sets), set, z_set_profile) {
+			if (!set || Z_TYPE_P(z_set_profile) != IS_ARRAY) {
+				return AEROSPIKE_ERR_PARAM;
+			}
+			if (!add_policy_profile(profile->set_profiles, set, &profile->policies, Z_ARRVAL_P(z_set_profile))) {
+				return AEROSPIKE_ERR_PARAM;
+			}
+		} ZEND_HASH_FOREACH_END();
+	} ZEND_HASH_FOREACH_END();
+
+	return AEROSPIKE_OK;
+}
+
+/* The profile is owned by profiles once added, so it is freed with them even if its options are invalid */
+static as_php_policy_profile* add_policy_profile(HashTable* profiles, zend_string* name, as_policies* defaults,
+		HashTable* z_options) {
+	as_php_policy_profile* profile = ecalloc(1, sizeof(as_php_policy_profile));
+
+	zend_hash_update_ptr(profiles, name, profile);
+	profile->policies = *defaults;
+
+	if (set_policies_from_hash(&profile->policies, z_options) != AEROSPIKE_OK) {
+		return NULL;
+	}
+	return profile;
+}
+
+static HashTable* new_policy_profiles(uint32_t size) {
+	HashTable* profiles = NULL;
+
+	ALLOC_HASHTABLE(profiles);
+	zend_hash_init(profiles, size, NULL, policy_profile_dtor, 0);
+	return profiles;
+}
+
+static void destroy_policy_profiles(HashTable* profiles) {
+	zend_hash_destroy(profiles);
+	FREE_HASHTABLE(profiles);
+}
+
+static void policy_profile_dtor(zval* z_profile) {
+	as_php_policy_profile* profile = (as_php_policy_profile*)Z_PTR_P(z_profile);
+
+	if (profile->set_profiles) {
+		destroy_policy_profiles(profile->set_profiles);
+	}
+	efree(profile);
+}
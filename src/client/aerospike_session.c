@@ -364,12 +364,7 @@ static bool set_up_session_data_from_save_path(aerospike_session_data* session_d
 		goto CLEANUP;
 	}
 
-/* ZTS Runs into problems with aerospike c client callbacks, so disable them */
-#ifdef ZTS
-	config.thread_pool_size = 0;
-#endif
-
-	session_data->php_client = (AerospikeClient*)malloc(sizeof(AerospikeClient));
+	session_data->php_client = (AerospikeClient*)calloc(1, sizeof(AerospikeClient));
 	session_data->php_client->is_connected = false;
 	session_data->php_client->is_persistent = true;
 	set_policy_defaults_from_ini(&config, session_data->php_client);
@@ -68,7 +68,7 @@ PHP_METHOD(Aerospike, append)
 	key_initialized = true;
 
 	if (zval_to_as_policy_operate(z_op_policy, &operate_policy,
-			&operate_policy_p, &as_ptr->config.policies.operate) != AEROSPIKE_OK) {
+			&operate_policy_p, &get_key_policies(client, z_key)->operate, client) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
 		goto CLEANUP;
 	}
@@ -88,6 +88,7 @@ PHP_METHOD(Aerospike, append)
 	}
 
 	aerospike_key_operate(as_ptr, &err, operate_policy_p, &key, &operations, &rec);
+	deliver_pending_log_events();
 
 CLEANUP:
 
@@ -43,7 +43,7 @@ PHP_METHOD(Aerospike, apply) {
 	bool key_initialized = false;
 	bool args_initialized = false;
 	bool has_return = false;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	as_error_init(&err);
 
 	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
@@ -54,6 +54,7 @@ PHP_METHOD(Aerospike, apply) {
 
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hss|h!z/z",
 			&z_key, &module, &module_len, &function, &function_len,
@@ -77,7 +78,7 @@ PHP_METHOD(Aerospike, apply) {
 	key_initialized = true;
 
 	if (zval_to_as_policy_apply(z_policy_apply, &apply_policy,
-			&apply_policy_p, &as_client->config.policies.apply) != AEROSPIKE_OK) {
+			&apply_policy_p, &get_key_policies(php_client, z_key)->apply, php_client) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid Policy.");
 		goto CLEANUP;
 	}
@@ -97,7 +98,9 @@ PHP_METHOD(Aerospike, apply) {
 	}
 	args_initialized = true;
 
-	if (aerospike_key_apply(as_client, &err, apply_policy_p, &key, module, function, arg_list, &result) != AEROSPIKE_OK) {
+	aerospike_key_apply(as_client, &err, apply_policy_p, &key, module, function, arg_list, &result);
+	deliver_pending_log_events();
+	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
@@ -0,0 +1,619 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_event.h"
+#include "aerospike/aerospike_key.h"
+#include "aerospike_class.h"
+#include "aerospike_async.h"
+#include "policy_conversions.h"
+#include "php_aerospike_types.h"
+#include "conversions.h"
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Asynchronous commands are run on the C client event loops. These are process wide,
+ * and must exist before the first cluster of the process is created, since every node
+ * sizes its async connection pools from the number of loops. They are created by the
+ * first Aerospike::__construct of the process when aerospike.async.event_loops > 0,
+ * and are closed at module shutdown.
+ */
+static pthread_mutex_t async_loops_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool async_loops_attempted = false;
+static bool async_loops_created = false;
+static pid_t async_loops_pid = 0;
+
+zend_class_entry* aerospike_future_ce;
+static zend_object_handlers aerospike_future_handlers;
+
+static zend_object* aerospike_future_create_object(zend_class_entry* ce);
+static void aerospike_future_free_storage(zend_object* object);
+
+PHP_METHOD(AerospikeFuture, __construct) {}
+
+static zend_function_entry aerospike_future_class_functions[] =
+{
+	PHP_ME(AerospikeFuture, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeFuture, isReady, future_is_ready_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeFuture, wait, future_wait_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeFuture, onComplete, future_on_complete_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_future_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Future", aerospike_future_class_functions);
+	aerospike_future_ce = zend_register_internal_class(&ce);
+	aerospike_future_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_future_ce->create_object = aerospike_future_create_object;
+	aerospike_future_ce->serialize = zend_class_serialize_deny;
+	aerospike_future_ce->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&aerospike_future_handlers, zend_get_std_object_handlers(), sizeof(aerospike_future_handlers));
+	aerospike_future_handlers.free_obj = aerospike_future_free_storage;
+	aerospike_future_handlers.clone_obj = NULL;
+	aerospike_future_handlers.offset = XtOffsetOf(AerospikeFuture, zobj);
+
+	return true;
+}
+
+AerospikeFuture* get_aerospike_future_from_zobj(zend_object* zobj) {
+	return (AerospikeFuture*)((char*)zobj - XtOffsetOf(AerospikeFuture, zobj));
+}
+
+static zend_object* aerospike_future_create_object(zend_class_entry* ce) {
+	AerospikeFuture* future = ecalloc(1, sizeof(*future) + zend_object_properties_size(ce));
+	future->cmd = NULL;
+	ZVAL_UNDEF(&future->z_result);
+	ZVAL_UNDEF(&future->z_callback);
+
+	zend_object_std_init(&future->zobj, ce);
+	object_properties_init(&future->zobj, ce);
+	future->zobj.handlers = &aerospike_future_handlers;
+
+	return &future->zobj;
+}
+
+static void aerospike_future_free_storage(zend_object* object) {
+	AerospikeFuture* future = get_aerospike_future_from_zobj(object);
+
+	/* If the command is still in flight, the event loop keeps it alive until it completes */
+	if (future->cmd) {
+		if (future->cmd->waiter == object) {
+			future->cmd->waiter = NULL;
+		}
+		as_php_async_command_release(future->cmd);
+		future->cmd = NULL;
+	}
+	zval_ptr_dtor(&future->z_result);
+	zval_ptr_dtor(&future->z_callback);
+	zend_object_std_dtor(object);
+}
+
+/* Wrap a command into a new Aerospike\Future, which takes over the caller's reference */
+void aerospike_future_from_command(zval* z_future, as_php_async_command* cmd) {
+	object_init_ex(z_future, aerospike_future_ce);
+	get_aerospike_future_from_zobj(Z_OBJ_P(z_future))->cmd = cmd;
+}
+
+void init_async_event_loops(void) {
+	zend_long loop_count = AEROSPIKE_G(async_event_loops);
+
+	if (loop_count <= 0) {
+		return;
+	}
+
+	pthread_mutex_lock(&async_loops_lock);
+	if (!async_loops_attempted) {
+		async_loops_attempted = true;
+		/* This fails if the C client was built without an event library */
+		if (as_event_create_loops((uint32_t)loop_count)) {
+			async_loops_created = true;
+			async_loops_pid = getpid();
+		}
+	}
+	pthread_mutex_unlock(&async_loops_lock);
+}
+
+/*
+ * Called at module shutdown, once the persistent clusters are closed, since closing a cluster
+ * still goes through the loops. as_event_close_loops() stops the loop threads and frees the
+ * loops the C client created. A forked child leaves them to the parent.
+ */
+void shutdown_async_event_loops(void) {
+	pthread_mutex_lock(&async_loops_lock);
+	if (async_loops_created && async_loops_pid == getpid()) {
+		as_event_close_loops();
+		async_loops_created = false;
+	}
+	pthread_mutex_unlock(&async_loops_lock);
+}
+
+as_status check_async_event_loops(as_error* err) {
+	bool created;
+	pid_t owner_pid;
+
+	pthread_mutex_lock(&async_loops_lock);
+	created = async_loops_created;
+	owner_pid = async_loops_pid;
+	pthread_mutex_unlock(&async_loops_lock);
+
+	if (!created) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT,
+				"Async commands require aerospike.async.event_loops > 0 and a C client built with an event library");
+		return err->code;
+	}
+
+	/* The loop threads do not survive a fork */
+	if (owner_pid != getpid()) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "The event loops were created by a parent process");
+		return err->code;
+	}
+
+	return AEROSPIKE_OK;
+}
+
+as_php_async_command* as_php_async_command_new(void) {
+	as_php_async_command* cmd = (as_php_async_command*)calloc(1, sizeof(as_php_async_command));
+	if (!cmd) {
+		return NULL;
+	}
+
+	pthread_mutex_init(&cmd->lock, NULL);
+	pthread_cond_init(&cmd->cond, NULL);
+	cmd->ref_cnt = 1;
+	as_error_init(&cmd->err);
+	return cmd;
+}
+
+void as_php_async_command_release(as_php_async_command* cmd) {
+	bool last_ref;
+
+	pthread_mutex_lock(&cmd->lock);
+	last_ref = (--cmd->ref_cnt == 0);
+	pthread_mutex_unlock(&cmd->lock);
+
+	if (!last_ref) {
+		return;
+	}
+
+	if (cmd->key_initialized) {
+		as_key_destroy(&cmd->key);
+	}
+	if (cmd->record) {
+		as_record_destroy(cmd->record);
+	}
+	if (cmd->queue) {
+		as_php_completion_queue_release(cmd->queue);
+	}
+	pthread_cond_destroy(&cmd->cond);
+	pthread_mutex_destroy(&cmd->lock);
+	free(cmd);
+}
+
+/*
+ * Store the outcome of a command and wake up anyone waiting for it. May run on an event loop thread.
+ * The C client destroys the record once the listener returns, so the bin values are reserved into a copy.
+ */
+void as_php_async_command_complete(as_php_async_command* cmd, const as_error* err, const as_record* record) {
+	as_record* record_copy = NULL;
+
+	if ((!err || err->code == AEROSPIKE_OK) && record) {
+		record_copy = as_php_copy_record(record);
+	}
+
+	pthread_mutex_lock(&cmd->lock);
+	if (!cmd->done) {
+		if (err && err->code != AEROSPIKE_OK) {
+			as_error_copy(&cmd->err, err);
+		}
+		cmd->record = record_copy;
+		record_copy = NULL;
+		cmd->done = true;
+		pthread_cond_broadcast(&cmd->cond);
+		if (cmd->queue) {
+			/* The queue holds its own reference until Aerospike::poll() picks the command up */
+			cmd->ref_cnt++;
+			as_php_completion_queue_push(cmd->queue, cmd);
+		}
+	}
+	pthread_mutex_unlock(&cmd->lock);
+
+	if (record_copy) {
+		as_record_destroy(record_copy);
+	}
+}
+
+/* Block until the command completes or the deadline passes, a NULL deadline waits forever */
+bool as_php_async_command_wait(as_php_async_command* cmd, struct timespec* deadline) {
+	bool done;
+
+	pthread_mutex_lock(&cmd->lock);
+	while (!cmd->done) {
+		if (deadline) {
+			if (pthread_cond_timedwait(&cmd->cond, &cmd->lock, deadline) == ETIMEDOUT) {
+				break;
+			}
+		} else {
+			pthread_cond_wait(&cmd->cond, &cmd->lock);
+		}
+	}
+	done = cmd->done;
+	pthread_mutex_unlock(&cmd->lock);
+
+	return done;
+}
+
+void as_php_async_record_listener(as_error* err, as_record* record, void* udata, as_event_loop* event_loop) {
+	as_php_async_command* cmd = (as_php_async_command*)udata;
+	as_php_async_command_complete(cmd, err, record);
+	as_php_async_command_release(cmd);
+}
+
+void as_php_async_write_listener(as_error* err, void* udata, as_event_loop* event_loop) {
+	as_php_async_command* cmd = (as_php_async_command*)udata;
+	as_php_async_command_complete(cmd, err, NULL);
+	as_php_async_command_release(cmd);
+}
+
+void async_deadline_from_timeout(struct timespec* deadline, zend_long timeout_ms) {
+	clock_gettime(CLOCK_REALTIME, deadline);
+	deadline->tv_sec += timeout_ms / 1000;
+	deadline->tv_nsec += (timeout_ms % 1000) * 1000000;
+	if (deadline->tv_nsec >= 1000000000) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000;
+	}
+}
+
+/*
+ * Wait for a command and build its result, an array of the form
+ * ["key" => [..], "metadata" => [..] or NULL, "bins" => [..] or NULL, "result" => status, "error" => message]
+ * "error" is only present for failed commands. The record copy is released once converted,
+ * so this may only be called once per command. Returns false if the deadline passed first.
+ */
+bool as_php_async_command_to_zval(as_php_async_command* cmd, zval* z_entry, as_status* status, struct timespec* deadline) {
+	as_error err;
+	as_error key_err;
+	zval z_key;
+
+	if (!as_php_async_command_wait(cmd, deadline)) {
+		return false;
+	}
+
+	/* Once done, the command is no longer written to by the event loop */
+	ZVAL_UNDEF(z_entry);
+	as_error_init(&err);
+	as_error_init(&key_err);
+	as_error_copy(&err, &cmd->err);
+
+	if (err.code == AEROSPIKE_OK && cmd->record) {
+		as_record_to_zval(cmd->record, z_entry, cmd->key_initialized ? &cmd->key : NULL, cmd->show_pk, &err);
+		as_record_destroy(cmd->record);
+		cmd->record = NULL;
+	}
+
+	if (err.code != AEROSPIKE_OK || Z_TYPE_P(z_entry) != IS_ARRAY) {
+		array_init(z_entry);
+		if (cmd->key_initialized && as_key_to_zval(&cmd->key, &z_key, cmd->show_pk, &key_err) == AEROSPIKE_OK) {
+			add_assoc_zval(z_entry, "key", &z_key);
+		} else {
+			add_assoc_null(z_entry, "key");
+		}
+		add_assoc_null(z_entry, "metadata");
+		add_assoc_null(z_entry, "bins");
+	}
+
+	add_assoc_long(z_entry, "result", err.code);
+	if (err.code != AEROSPIKE_OK) {
+		add_assoc_string(z_entry, "error", err.message);
+	}
+
+	*status = err.code;
+	return true;
+}
+
+/* The result of a future is built once and cached on it, see as_php_async_command_to_zval() */
+bool aerospike_future_result(AerospikeFuture* future, zval* z_result, as_status* status, struct timespec* deadline) {
+	if (Z_TYPE(future->z_result) == IS_UNDEF &&
+			!as_php_async_command_to_zval(future->cmd, &future->z_result, status, deadline)) {
+		return false;
+	}
+
+	*status = (as_status)Z_LVAL_P(zend_hash_str_find(Z_ARRVAL(future->z_result), "result", strlen("result")));
+	ZVAL_COPY(z_result, &future->z_result);
+	return true;
+}
+
+/*
+ * Copy a record handed to a C client callback, which destroys it once the callback returns.
+ * The key is not copied.
+ */
+as_record* as_php_copy_record(const as_record* record) {
+	as_record* record_copy = as_record_new(record->bins.size);
+	as_bin* bin = NULL;
+
+	record_copy->gen = record->gen;
+	record_copy->ttl = record->ttl;
+
+	/* Bins are appended rather than set, operate responses may carry the same bin more than once */
+	for (uint16_t i = 0; i < record->bins.size; i++) {
+		bin = &record->bins.entries[i];
+		as_bin_init(&record_copy->bins.entries[record_copy->bins.size++], bin->name,
+				bin->valuep ? (as_bin_value*)as_php_copy_val((as_val*)bin->valuep) : NULL);
+	}
+
+	return record_copy;
+}
+
+/*
+ * Values which the C client allocated on their own can simply be reserved, the others live
+ * inside the bin array of the record being copied, or on the stack of the callback, and have to
+ * be duplicated. Nil is returned as NULL, as bins hold it
+ */
+as_val* as_php_copy_val(as_val* val) {
+	as_bytes* bytes = NULL;
+	as_bytes* bytes_copy = NULL;
+
+	if (val->free) {
+		as_val_reserve(val);
+		return val;
+	}
+
+	switch (as_val_type(val)) {
+		case AS_NIL:
+			return NULL;
+		case AS_INTEGER:
+			return (as_val*)as_integer_new(as_integer_get((as_integer*)val));
+		case AS_DOUBLE:
+			return (as_val*)as_double_new(as_double_get((as_double*)val));
+		case AS_STRING:
+			return (as_val*)as_string_new_strdup(as_string_get((as_string*)val));
+		case AS_GEOJSON:
+			return (as_val*)as_geojson_new_strdup(as_geojson_get((as_geojson*)val));
+		case AS_BYTES:
+			bytes = (as_bytes*)val;
+			bytes_copy = as_bytes_new(bytes->size);
+			as_bytes_set(bytes_copy, 0, bytes->value, bytes->size);
+			as_bytes_set_type(bytes_copy, as_bytes_get_type(bytes));
+			return (as_val*)bytes_copy;
+		default:
+			as_val_reserve(val);
+			return val;
+	}
+}
+
+/*
+ * Send a read of the key in z_key_hash for cmd. A NULL event_loop picks one round robin,
+ * a pipe_listener sends the command on a pipelined connection of that loop.
+ * The event loop holds its own reference to cmd until the listener has run. The command buffer
+ * is written before this returns, and if sending fails the listener is never called.
+ */
+as_status as_php_async_get(AerospikeClient* client, as_error* err, as_php_async_command* cmd, HashTable* z_key_hash,
+		zval* z_filter, zval* z_read_policy, as_event_loop* event_loop, as_pipe_listener pipe_listener) {
+	as_policy_read read_policy;
+	as_policy_read* read_policy_p = NULL;
+	zval* z_bin = NULL;
+	char** bins = NULL;
+	int num_bins = 0;
+	int i = 0;
+
+	if (zval_to_as_policy_read(z_read_policy, &read_policy, &read_policy_p,
+			&get_key_policies(client, z_key_hash)->read, client) != AEROSPIKE_OK) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid read policy");
+		return err->code;
+	}
+	cmd->show_pk = (read_policy_p && read_policy_p->key == AS_POLICY_KEY_SEND);
+
+	if (z_hashtable_to_as_key(z_key_hash, &cmd->key, err) != AEROSPIKE_OK) {
+		return err->code;
+	}
+	cmd->key_initialized = true;
+
+	if (z_filter) {
+		if (Z_TYPE_P(z_filter) != IS_ARRAY || !hashtable_is_list(Z_ARRVAL_P(z_filter))) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Filter bins must be a list if provided");
+			return err->code;
+		}
+
+		/* The bin list must be NULL terminated */
+		num_bins = zend_hash_num_elements(Z_ARRVAL_P(z_filter));
+		bins = (char**)alloca((num_bins + 1) * sizeof(char*));
+		bins[num_bins] = NULL;
+
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(z_filter), z_bin) {
+			if (Z_TYPE_P(z_bin) != IS_STRING) {
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin names must be strings");
+				return err->code;
+			}
+			if (Z_STRLEN_P(z_bin) > AS_BIN_NAME_MAX_LEN) {
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin name too long");
+				return err->code;
+			}
+			bins[i++] = Z_STRVAL_P(z_bin);
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	cmd->ref_cnt++;
+	if (bins) {
+		aerospike_key_select_async(client->as_client, err, read_policy_p, &cmd->key, (const char**)bins,
+				as_php_async_record_listener, cmd, event_loop, pipe_listener);
+	} else {
+		aerospike_key_get_async(client->as_client, err, read_policy_p, &cmd->key,
+				as_php_async_record_listener, cmd, event_loop, pipe_listener);
+	}
+	if (err->code != AEROSPIKE_OK) {
+		cmd->ref_cnt--;
+	}
+
+	return err->code;
+}
+
+/* {{{ proto bool Aerospike\Future::isReady()
+    Whether the command has completed, never blocks */
+PHP_METHOD(AerospikeFuture, isReady) {
+	AerospikeFuture* future = get_aerospike_future_from_zobj(Z_OBJ_P(getThis()));
+	bool done;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	if (!future->cmd) {
+		RETURN_FALSE;
+	}
+
+	pthread_mutex_lock(&future->cmd->lock);
+	done = future->cmd->done;
+	pthread_mutex_unlock(&future->cmd->lock);
+
+	RETURN_BOOL(done);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Future::wait( array &result [, int timeout_ms=0 ] )
+    Waits for the command and returns its status, or ERR_TIMEOUT if timeout_ms passed first */
+PHP_METHOD(AerospikeFuture, wait) {
+	AerospikeFuture* future = get_aerospike_future_from_zobj(Z_OBJ_P(getThis()));
+	zval* z_result = NULL;
+	zend_long timeout_ms = 0;
+	struct timespec deadline;
+	as_status status = AEROSPIKE_OK;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z/|l", &z_result, &timeout_ms) == FAILURE) {
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_result);
+	ZVAL_NULL(z_result);
+
+	if (!future->cmd) {
+		RETURN_LONG(AEROSPIKE_ERR_CLIENT);
+	}
+
+	if (timeout_ms > 0) {
+		async_deadline_from_timeout(&deadline, timeout_ms);
+	}
+
+	if (!aerospike_future_result(future, z_result, &status, timeout_ms > 0 ? &deadline : NULL)) {
+		RETURN_LONG(AEROSPIKE_ERR_TIMEOUT);
+	}
+
+	RETURN_LONG(status);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Future Aerospike::getAsync( array key [, array filter [, array options ]] )
+    Starts reading a record on the event loops and returns a future for it. Errors which happen before
+    the command is sent are reported by the client and through an already completed future */
+PHP_METHOD(Aerospike, getAsync) {
+	as_error err;
+	HashTable* z_key_hash = NULL;
+	zval* z_filter = NULL;
+	zval* z_read_policy = NULL;
+	AerospikeClient* client = NULL;
+	as_php_async_command* cmd = NULL;
+
+	reset_client_error(getThis());
+	as_error_init(&err);
+
+	cmd = as_php_async_command_new();
+	if (!cmd) {
+		update_client_error(getThis(), AEROSPIKE_ERR_CLIENT, "Unable to allocate the async command", false);
+		RETURN_NULL();
+	}
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|z!z", &z_key_hash, &z_filter, &z_read_policy) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid parameters to Aerospike::getAsync");
+		goto CLEANUP;
+	}
+
+	if (check_async_event_loops(&err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	as_php_async_get(client, &err, cmd, z_key_hash, z_filter, z_read_policy, NULL, NULL);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		as_php_async_command_complete(cmd, &err, NULL);
+	}
+
+	aerospike_future_from_command(return_value, cmd);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike::awaitAll( array futures, array &results [, int timeout_ms=0 ] )
+    Waits for a set of futures. results has the same keys as futures, each entry being the result
+    described in Aerospike\Future::wait(). Returns ERR_TIMEOUT if timeout_ms passed before every
+    future completed, the pending ones then have "result" => ERR_TIMEOUT and may be awaited again */
+PHP_METHOD(Aerospike, awaitAll) {
+	HashTable* z_futures = NULL;
+	zval* z_results = NULL;
+	zval* z_future = NULL;
+	zval z_entry;
+	zend_long timeout_ms = 0;
+	zend_ulong index;
+	zend_string* str_key = NULL;
+	struct timespec deadline;
+	as_status cmd_status;
+	as_status status = AEROSPIKE_OK;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz/|l", &z_futures, &z_results, &timeout_ms) == FAILURE) {
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_results);
+	ZVAL_NULL(z_results);
+
+	ZEND_HASH_FOREACH_VAL(z_futures, z_future) {
+		if (Z_TYPE_P(z_future) != IS_OBJECT || Z_OBJCE_P(z_future) != aerospike_future_ce ||
+				!get_aerospike_future_from_zobj(Z_OBJ_P(z_future))->cmd) {
+			RETURN_LONG(AEROSPIKE_ERR_PARAM);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (timeout_ms > 0) {
+		async_deadline_from_timeout(&deadline, timeout_ms);
+	}
+
+	array_init_size(z_results, zend_hash_num_elements(z_futures));
+	ZEND_HASH_FOREACH_KEY_VAL(z_futures, index, str_key, z_future) {
+		if (!aerospike_future_result(get_aerospike_future_from_zobj(Z_OBJ_P(z_future)), &z_entry,
+				&cmd_status, timeout_ms > 0 ? &deadline : NULL)) {
+			status = AEROSPIKE_ERR_TIMEOUT;
+			array_init(&z_entry);
+			add_assoc_long(&z_entry, "result", AEROSPIKE_ERR_TIMEOUT);
+		}
+
+		if (str_key) {
+			add_assoc_zval_ex(z_results, ZSTR_VAL(str_key), ZSTR_LEN(str_key), &z_entry);
+		} else {
+			add_index_zval(z_results, index, &z_entry);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	RETURN_LONG(status);
+}
+/* }}} */
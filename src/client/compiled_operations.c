@@ -0,0 +1,333 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_nil.h"
+#include "compiled_operations.h"
+#include "policy_conversions.h"
+#include "php_aerospike_types.h"
+#include "conversions.h"
+
+/*
+ * Operation templates.
+ *
+ * operate() converts its array of operations on every call. Aerospike\Operations::compile() does
+ * it once: each operation is validated, converted, and packed if it is a CDT one, into a template
+ * whose operations later calls share. An operation with a "param" entry in place of its "val" is
+ * left as an array, bind() supplies the value and it is converted on each call.
+ */
+
+#define AS_PHP_OPERATION_PARAM_KEY "param"
+
+zend_class_entry* aerospike_operations_ce;
+static zend_object_handlers aerospike_operations_handlers;
+
+static zend_object* aerospike_operations_create_object(zend_class_entry* ce);
+static void aerospike_operations_free_storage(zend_object* object);
+static AerospikeOperations* get_aerospike_operations_from_zobj(zend_object* zobj);
+static as_status compile_operations(AerospikeOperations* operations, HashTable* z_ops, as_error* err,
+		int serializer_type);
+
+PHP_METHOD(AerospikeOperations, __construct) {}
+
+static zend_function_entry aerospike_operations_class_functions[] =
+{
+	PHP_ME(AerospikeOperations, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeOperations, compile, operations_compile_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeOperations, bind, operations_bind_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_operations_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Operations", aerospike_operations_class_functions);
+	aerospike_operations_ce = zend_register_internal_class(&ce);
+	aerospike_operations_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_operations_ce->create_object = aerospike_operations_create_object;
+	aerospike_operations_ce->serialize = zend_class_serialize_deny;
+	aerospike_operations_ce->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&aerospike_operations_handlers, zend_get_std_object_handlers(), sizeof(aerospike_operations_handlers));
+	aerospike_operations_handlers.free_obj = aerospike_operations_free_storage;
+	aerospike_operations_handlers.clone_obj = NULL;
+	aerospike_operations_handlers.offset = XtOffsetOf(AerospikeOperations, zobj);
+
+	return true;
+}
+
+static AerospikeOperations* get_aerospike_operations_from_zobj(zend_object* zobj) {
+	return (AerospikeOperations*)((char*)zobj - XtOffsetOf(AerospikeOperations, zobj));
+}
+
+static zend_object* aerospike_operations_create_object(zend_class_entry* ce) {
+	AerospikeOperations* operations = ecalloc(1, sizeof(*operations) + zend_object_properties_size(ce));
+	ZVAL_UNDEF(&operations->z_template);
+	ZVAL_UNDEF(&operations->z_params);
+
+	zend_object_std_init(&operations->zobj, ce);
+	object_properties_init(&operations->zobj, ce);
+	operations->zobj.handlers = &aerospike_operations_handlers;
+
+	return &operations->zobj;
+}
+
+static void aerospike_operations_free_storage(zend_object* object) {
+	AerospikeOperations* operations = get_aerospike_operations_from_zobj(object);
+
+	if (operations->compiled) {
+		as_operations_destroy(operations->compiled);
+	}
+	if (operations->source) {
+		zend_array_destroy(operations->source);
+	}
+	for (uint32_t i = 0; i < operations->entry_count; i++) {
+		if (operations->entries[i].op_array) {
+			zend_array_destroy(operations->entries[i].op_array);
+		}
+	}
+	if (operations->entries) {
+		efree(operations->entries);
+	}
+
+	zval_ptr_dtor(&operations->z_params);
+	zval_ptr_dtor(&operations->z_template);
+	zend_object_std_dtor(object);
+}
+
+/*
+ * Convert each operation without a parameter into the template, keep a copy of the others. The
+ * template is made from a copy of z_ops held until it is freed, since append and prepend do not
+ * copy their string.
+ */
+static as_status compile_operations(AerospikeOperations* operations, HashTable* z_ops, as_error* err,
+		int serializer_type) {
+	uint32_t op_count = zend_hash_num_elements(z_ops);
+	as_php_compiled_op* entry = NULL;
+	zval* z_op = NULL;
+	zval* z_param = NULL;
+
+	if (!op_count || !hashtable_is_list(z_ops)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations must be a non empty list");
+	}
+
+	operations->compiled = as_operations_new(op_count);
+	operations->entries = ecalloc(op_count, sizeof(as_php_compiled_op));
+	operations->source = zend_array_dup(z_ops);
+
+	ZEND_HASH_FOREACH_VAL(operations->source, z_op) {
+		if (Z_TYPE_P(z_op) != IS_ARRAY) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must be an array");
+		}
+
+		entry = &operations->entries[operations->entry_count];
+		z_param = zend_hash_str_find(Z_ARRVAL_P(z_op), AS_PHP_OPERATION_PARAM_KEY,
+				strlen(AS_PHP_OPERATION_PARAM_KEY));
+
+		if (z_param) {
+			if (Z_TYPE_P(z_param) != IS_LONG || Z_LVAL_P(z_param) < 0 || Z_LVAL_P(z_param) >= op_count) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM,
+						"Operation param must be the position of its value in the bound values");
+			}
+			if (zend_hash_str_exists(Z_ARRVAL_P(z_op), "val", strlen("val"))) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation can not have both a val and a param");
+			}
+			entry->op_array = zend_array_dup(Z_ARRVAL_P(z_op));
+			entry->param = (uint32_t)Z_LVAL_P(z_param);
+			if (entry->param >= operations->param_count) {
+				operations->param_count = entry->param + 1;
+			}
+			operations->entry_count++;
+			continue;
+		}
+
+		entry->binop = operations->compiled->binops.size;
+		if (add_op_to_operations(Z_ARRVAL_P(z_op), operations->compiled, err, serializer_type) != AEROSPIKE_OK) {
+			return err->code;
+		}
+		/* A touch without a ttl adds no operation */
+		if (operations->compiled->binops.size > entry->binop) {
+			operations->entry_count++;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return AEROSPIKE_OK;
+}
+
+/*
+ * Append an operation of a template to ops, which must have room for it. The value is shared with
+ * the template, unless it is stored in the bin itself.
+ */
+bool add_compiled_binop(as_operations* ops, const as_binop* binop) {
+	as_binop* copy = NULL;
+
+	if (ops->binops.size >= ops->binops.capacity) {
+		return false;
+	}
+	copy = &ops->binops.entries[ops->binops.size++];
+	*copy = *binop;
+
+	if (binop->bin.valuep == &binop->bin.value) {
+		copy->bin.valuep = &copy->bin.value;
+	} else if (binop->bin.valuep && (const as_val*)binop->bin.valuep != &as_nil) {
+		as_val_reserve((as_val*)binop->bin.valuep);
+	}
+	return true;
+}
+
+/* The number of operations of an array or of an Aerospike\Operations, 0 for other values */
+uint32_t as_php_operations_count(zval* z_ops) {
+	AerospikeOperations* operations = NULL;
+
+	if (Z_TYPE_P(z_ops) == IS_ARRAY) {
+		return zend_hash_num_elements(Z_ARRVAL_P(z_ops));
+	}
+	if (Z_TYPE_P(z_ops) != IS_OBJECT || Z_OBJCE_P(z_ops) != aerospike_operations_ce) {
+		return 0;
+	}
+
+	operations = get_aerospike_operations_from_zobj(Z_OBJ_P(z_ops));
+	if (Z_TYPE(operations->z_template) != IS_UNDEF) {
+		operations = get_aerospike_operations_from_zobj(Z_OBJ(operations->z_template));
+	}
+	return operations->entry_count;
+}
+
+/*
+ * Load an array of operations, or an Aerospike\Operations, and the generation and ttl of the
+ * operate policy, into ops. ops must already be initialized with room for every operation.
+ */
+as_status zval_to_as_operations(zval* z_ops, zval* z_operate_policy, as_operations* ops,
+		as_error* err, int serializer_type) {
+	AerospikeOperations* operations = NULL;
+	HashTable* z_params = NULL;
+	as_php_compiled_op* entry = NULL;
+	zval* z_val = NULL;
+
+	if (Z_TYPE_P(z_ops) == IS_ARRAY) {
+		return z_hashtable_to_as_operations(Z_ARRVAL_P(z_ops), z_operate_policy, ops, err, serializer_type);
+	}
+	if (Z_TYPE_P(z_ops) != IS_OBJECT || Z_OBJCE_P(z_ops) != aerospike_operations_ce) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations must be an array or an Aerospike\\Operations");
+	}
+
+	if (set_operations_generation_from_operate_policy(ops, z_operate_policy) != AEROSPIKE_OK) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
+	}
+	if (set_operations_ttl_from_operate_policy(ops, z_operate_policy) != AEROSPIKE_OK) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid TTL");
+	}
+
+	operations = get_aerospike_operations_from_zobj(Z_OBJ_P(z_ops));
+	if (Z_TYPE(operations->z_template) != IS_UNDEF) {
+		z_params = Z_ARRVAL(operations->z_params);
+		operations = get_aerospike_operations_from_zobj(Z_OBJ(operations->z_template));
+	}
+	if (operations->param_count && !z_params) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "The operations have parameters, bind() their values");
+	}
+
+	/* The ttl of a touch */
+	if (operations->compiled->ttl) {
+		ops->ttl = operations->compiled->ttl;
+	}
+
+	for (uint32_t i = 0; i < operations->entry_count; i++) {
+		entry = &operations->entries[i];
+
+		if (!entry->op_array) {
+			if (!add_compiled_binop(ops, &operations->compiled->binops.entries[entry->binop])) {
+				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
+			}
+			continue;
+		}
+
+		z_val = zend_hash_index_find(z_params, entry->param);
+		if (!z_val) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Missing the value of an operation param");
+		}
+		Z_TRY_ADDREF_P(z_val);
+		zend_hash_str_update(entry->op_array, "val", strlen("val"), z_val);
+
+		if (add_op_to_operations(entry->op_array, ops, err, serializer_type) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	return AEROSPIKE_OK;
+}
+
+/* {{{ proto Aerospike\Operations Aerospike\Operations::compile( array operations [, array options ] )
+    A template of operations, in the format of operate(), null if an operation is invalid */
+PHP_METHOD(AerospikeOperations, compile) {
+	AerospikeOperations* operations = NULL;
+	HashTable* z_ops = NULL;
+	zval* z_options = NULL;
+	int serializer_type = (int)AEROSPIKE_G(serializer);
+	as_error err;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|z", &z_ops, &z_options) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	as_error_init(&err);
+	if (set_serializer_from_policy_hash(&serializer_type, z_options) != AEROSPIKE_OK) {
+		php_error_docref(NULL, E_WARNING, "Invalid serializer value");
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, aerospike_operations_ce);
+	operations = get_aerospike_operations_from_zobj(Z_OBJ_P(return_value));
+
+	if (compile_operations(operations, z_ops, &err, serializer_type) != AEROSPIKE_OK) {
+		php_error_docref(NULL, E_WARNING, "%s", err.message);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Operations Aerospike\Operations::bind( array params )
+    The operations with the values of their params, null if a value is missing */
+PHP_METHOD(AerospikeOperations, bind) {
+	AerospikeOperations* operations = get_aerospike_operations_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeOperations* bound = NULL;
+	zval* z_template = getThis();
+	zval* z_params = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &z_params) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	/* Binding bound operations again replaces their values */
+	if (Z_TYPE(operations->z_template) != IS_UNDEF) {
+		z_template = &operations->z_template;
+		operations = get_aerospike_operations_from_zobj(Z_OBJ_P(z_template));
+	}
+	for (uint32_t i = 0; i < operations->param_count; i++) {
+		if (!zend_hash_index_exists(Z_ARRVAL_P(z_params), i)) {
+			php_error_docref(NULL, E_WARNING, "Missing the value of param %u", i);
+			RETURN_NULL();
+		}
+	}
+
+	object_init_ex(return_value, aerospike_operations_ce);
+	bound = get_aerospike_operations_from_zobj(Z_OBJ_P(return_value));
+	ZVAL_COPY(&bound->z_template, z_template);
+	ZVAL_COPY(&bound->z_params, z_params);
+}
+/* }}} */
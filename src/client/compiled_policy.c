@@ -0,0 +1,274 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "compiled_policy.h"
+#include "policy_conversions.h"
+#include "php_aerospike_types.h"
+
+/*
+ * Reusable options.
+ *
+ * Every method taking an options array accepts an Aerospike\Policy in its place. Options arrays are
+ * merged with the client defaults on every call, a policy is merged once per kind of command, then
+ * copied into the call. Options a policy does not resolve ahead, such as OPT_SCAN_PRIORITY, are
+ * still read from its array by the commands using them.
+ */
+
+zend_class_entry* aerospike_policy_ce;
+static zend_object_handlers aerospike_policy_handlers;
+
+static zend_object* aerospike_policy_create_object(zend_class_entry* ce);
+static void aerospike_policy_free_storage(zend_object* object);
+static bool policy_resolve_record_options(AerospikePolicy* policy);
+static as_php_policy_resolved* policy_resolved_for(AerospikePolicy* policy, AerospikeClient* client);
+static HashTable* policy_resolved_table(HashTable** table);
+static void policy_destroy_resolved(as_php_policy_resolved* resolved);
+static void policy_resolved_dtor(zval* z_resolved);
+
+PHP_METHOD(AerospikePolicy, __construct) {}
+
+static zend_function_entry aerospike_policy_class_functions[] =
+{
+	PHP_ME(AerospikePolicy, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikePolicy, create, policy_create_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikePolicy, options, policy_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikePolicy, error, policy_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikePolicy, errorno, policy_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_policy_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Policy", aerospike_policy_class_functions);
+	aerospike_policy_ce = zend_register_internal_class(&ce);
+	aerospike_policy_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_policy_ce->create_object = aerospike_policy_create_object;
+	aerospike_policy_ce->serialize = zend_class_serialize_deny;
+	aerospike_policy_ce->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&aerospike_policy_handlers, zend_get_std_object_handlers(), sizeof(aerospike_policy_handlers));
+	aerospike_policy_handlers.free_obj = aerospike_policy_free_storage;
+	aerospike_policy_handlers.clone_obj = NULL;
+	aerospike_policy_handlers.offset = XtOffsetOf(AerospikePolicy, zobj);
+
+	return true;
+}
+
+static zend_object* aerospike_policy_create_object(zend_class_entry* ce) {
+	AerospikePolicy* policy = ecalloc(1, sizeof(*policy) + zend_object_properties_size(ce));
+	ZVAL_UNDEF(&policy->z_options);
+
+	zend_object_std_init(&policy->zobj, ce);
+	object_properties_init(&policy->zobj, ce);
+	policy->zobj.handlers = &aerospike_policy_handlers;
+
+	return &policy->zobj;
+}
+
+static void aerospike_policy_free_storage(zend_object* object) {
+	AerospikePolicy* policy = (AerospikePolicy*)((char*)object - XtOffsetOf(AerospikePolicy, zobj));
+
+	/* The filter expressions of the resolved policies belong to the Aerospike\Exp of the array */
+	for (int i = 0; i < AS_PHP_POLICY_MAX_CLIENTS; i++) {
+		policy_destroy_resolved(&policy->resolved[i]);
+	}
+	zval_ptr_dtor(&policy->z_options);
+	zend_object_std_dtor(object);
+}
+
+/*
+ * Read the options applied to the record rather than to the command, rejecting the values the
+ * commands would reject
+ */
+static bool policy_resolve_record_options(AerospikePolicy* policy) {
+	HashTable* z_options = Z_ARRVAL(policy->z_options);
+	zval* setting_val = NULL;
+
+	setting_val = zend_hash_index_find(z_options, OPT_SERIALIZER);
+	if (setting_val) {
+		if (Z_TYPE_P(setting_val) != IS_LONG) {
+			return false;
+		}
+		policy->has_serializer = true;
+		policy->serializer = (int)Z_LVAL_P(setting_val);
+	}
+
+	setting_val = zend_hash_index_find(z_options, OPT_POLICY_GEN);
+	if (setting_val) {
+		if (Z_TYPE_P(setting_val) != IS_ARRAY) {
+			return false;
+		}
+		if (zend_hash_num_elements(Z_ARRVAL_P(setting_val)) == 2) {
+			setting_val = zend_hash_index_find(Z_ARRVAL_P(setting_val), 1);
+			if (!setting_val || Z_TYPE_P(setting_val) != IS_LONG) {
+				return false;
+			}
+			policy->has_generation = true;
+			policy->generation = (uint16_t)Z_LVAL_P(setting_val);
+		}
+	}
+
+	setting_val = zend_hash_index_find(z_options, OPT_TTL);
+	if (setting_val) {
+		if (Z_TYPE_P(setting_val) != IS_LONG) {
+			return false;
+		}
+		policy->has_ttl = true;
+		policy->ttl = (uint32_t)Z_LVAL_P(setting_val);
+	}
+
+	return true;
+}
+
+/*
+ * The policies resolved for this client, taking the slot of the least recently used client if
+ * there are none yet
+ */
+static as_php_policy_resolved* policy_resolved_for(AerospikePolicy* policy, AerospikeClient* client) {
+	as_php_policy_resolved* found = NULL;
+	as_php_policy_resolved* oldest = &policy->resolved[0];
+
+	for (int i = 0; i < AS_PHP_POLICY_MAX_CLIENTS && !found; i++) {
+		if (policy->resolved[i].client_id == client->id) {
+			found = &policy->resolved[i];
+		} else if (policy->resolved[i].last_use < oldest->last_use) {
+			oldest = &policy->resolved[i];
+		}
+	}
+
+	if (!found) {
+		found = oldest;
+		policy_destroy_resolved(found);
+		found->client_id = client->id;
+	}
+	found->last_use = ++policy->uses;
+	return found;
+}
+
+/* The resolved policies of a kind, keyed on the address of their defaults */
+static HashTable* policy_resolved_table(HashTable** table) {
+	if (!*table) {
+		ALLOC_HASHTABLE(*table);
+		zend_hash_init(*table, 2, NULL, policy_resolved_dtor, 0);
+	}
+	return *table;
+}
+
+static void policy_destroy_resolved(as_php_policy_resolved* resolved) {
+	HashTable** tables[] = {&resolved->read, &resolved->write, &resolved->operate, &resolved->remove,
+		&resolved->batch, &resolved->apply, &resolved->scan, &resolved->query};
+
+	for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); i++) {
+		if (*tables[i]) {
+			zend_hash_destroy(*tables[i]);
+			FREE_HASHTABLE(*tables[i]);
+			*tables[i] = NULL;
+		}
+	}
+}
+
+static void policy_resolved_dtor(zval* z_resolved) {
+	efree(Z_PTR_P(z_resolved));
+}
+
+/*
+ * Copy the policy of a kind of command into the call, resolving it first if it was not resolved
+ * against these defaults of the client yet. The options array is only parsed again in that case.
+ */
+#define POLICY_COPY_FUNCTION(kind) \
+as_status as_php_policy_copy_##kind(AerospikePolicy* policy, as_policy_##kind* kind##_policy, \
+		as_policy_##kind* default_policy, AerospikeClient* client) { \
+	HashTable* resolved_table = policy_resolved_table(&policy_resolved_for(policy, client)->kind); \
+	zend_ulong defaults_key = (zend_ulong)(uintptr_t)default_policy; \
+	as_policy_##kind* resolved = zend_hash_index_find_ptr(resolved_table, defaults_key); \
+	as_policy_##kind* resolved_p = NULL; \
+	if (!resolved) { \
+		resolved = emalloc(sizeof(as_policy_##kind)); \
+		if (zval_to_as_policy_##kind(&policy->z_options, resolved, &resolved_p, \
+				default_policy, client) != AEROSPIKE_OK) { \
+			efree(resolved); \
+			return AEROSPIKE_ERR_PARAM; \
+		} \
+		zend_hash_index_add_new_ptr(resolved_table, defaults_key, resolved); \
+	} \
+	as_policy_##kind##_copy(resolved, kind##_policy); \
+	return AEROSPIKE_OK; \
+}
+
+POLICY_COPY_FUNCTION(read)
+POLICY_COPY_FUNCTION(write)
+POLICY_COPY_FUNCTION(operate)
+POLICY_COPY_FUNCTION(remove)
+POLICY_COPY_FUNCTION(batch)
+POLICY_COPY_FUNCTION(apply)
+POLICY_COPY_FUNCTION(scan)
+POLICY_COPY_FUNCTION(query)
+
+/* {{{ proto Aerospike\Policy Aerospike\Policy::create( array options )
+    Options to pass in place of an options array, null if an option has an invalid value */
+PHP_METHOD(AerospikePolicy, create) {
+	AerospikePolicy* policy = NULL;
+	zval* z_options = NULL;
+
+	as_error_reset(&AEROSPIKE_G(global_error));
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &z_options) == FAILURE) {
+		as_error_update(&AEROSPIKE_G(global_error), AEROSPIKE_ERR_PARAM, "Invalid arguments to create");
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, aerospike_policy_ce);
+	policy = as_php_policy_from_zval(return_value);
+	ZVAL_ARR(&policy->z_options, zend_array_dup(Z_ARRVAL_P(z_options)));
+
+	if (!policy_resolve_record_options(policy)) {
+		as_error_update(&AEROSPIKE_G(global_error), AEROSPIKE_ERR_PARAM,
+			"Invalid serializer, generation or ttl option");
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto array Aerospike\Policy::options( )
+    The options the policy was created from */
+PHP_METHOD(AerospikePolicy, options) {
+	AerospikePolicy* policy = as_php_policy_from_zval(getThis());
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	RETURN_ZVAL(&policy->z_options, 1, 0);
+}
+/* }}} */
+
+/* {{{ proto string Aerospike\Policy::error( )
+    The message of the last create() call, empty if it succeeded */
+PHP_METHOD(AerospikePolicy, error) {
+	RETURN_STRING(AEROSPIKE_G(global_error).message);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Policy::errorno( )
+    The status code of the last create() call */
+PHP_METHOD(AerospikePolicy, errorno) {
+	RETURN_LONG(AEROSPIKE_G(global_error).code);
+}
+/* }}} */
@@ -44,11 +44,15 @@ PHP_METHOD(Aerospike, exists)
 	AerospikeClient* client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	aerospike* as_ptr = client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz/|z",
-		&z_key_hash, &metadata, &z_read_policy) != SUCCESS) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 3)
+		Z_PARAM_ARRAY_HT(z_key_hash)
+		Z_PARAM_ZVAL_EX(metadata, 0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(z_read_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to exists", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 
 	as_error_init(&err);
 
@@ -63,13 +67,14 @@ PHP_METHOD(Aerospike, exists)
 	ZVAL_NULL(metadata);
 
 	if (zval_to_as_policy_read(z_read_policy, &read_policy,
-			&read_policy_p, &as_ptr->config.policies.read) != AEROSPIKE_OK) {
+			&read_policy_p, &get_key_policies(client, z_key_hash)->read, client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid read policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 	read_policy_p = &read_policy;
 
     aerospike_key_exists(as_ptr, &err, read_policy_p, &key, &record);
+    deliver_pending_log_events();
 	as_key_destroy(&key);
 	
 	if (record) {
@@ -117,22 +117,23 @@ PHP_METHOD(Aerospike, existsMany) {
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz/|z",
-			&z_key_array, &z_metadata, &z_policy) == FAILURE) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 3)
+		Z_PARAM_ARRAY_HT(z_key_array)
+		Z_PARAM_ZVAL_EX(z_metadata, 0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(z_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to existsMany");
 		goto CLEANUP;
-	}
+	);
 	zval_dtor(z_metadata);
 	ZVAL_NULL(z_metadata);
 
-	/* Set the batch policy */
-	if (z_policy) {
-		if (zval_to_as_policy_batch(z_policy, &batch_policy,
-				&batch_policy_p, &as_client->config.policies.batch) != AEROSPIKE_OK) {
-			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid batch policy");
-			goto CLEANUP;
-		}
-		batch_policy_p = &batch_policy;
+	/* Set the batch policy, without options the keys may still share a profile */
+	if (zval_to_as_policy_batch(z_policy, &batch_policy,
+			&batch_policy_p, &get_batch_policies(php_client, z_key_array)->batch, php_client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid batch policy");
+		goto CLEANUP;
 	}
 
 	key_count = zend_hash_num_elements(z_key_array);
@@ -162,6 +163,7 @@ PHP_METHOD(Aerospike, existsMany) {
 	/* Setup complete, run the actual batch_exists function */
 	aerospike_batch_exists(as_client, &err, batch_policy_p, &batch,
 			(aerospike_batch_read_callback)exists_callback, (void*)&cb_data);
+	deliver_pending_log_events();
 
 CLEANUP:
 	if (batch_initialized) {
@@ -180,3 +182,151 @@ CLEANUP:
 	RETURN_LONG(err.code);
 }
 /* }}} */
+
+/* {{{ proto int Aerospike::existsManyCompact( array keys, string|array &exists [, array options [, array &generations]] )
+   Checks a batch of keys for existence without building a metadata array per key.
+   By default exists is a bitmap string where bit i (byte i >> 3, bit i & 7) is set when keys[i] exists,
+   with Aerospike::OPT_EXISTS_FORMAT => Aerospike::EXISTS_FORMAT_BOOL it is a packed array of bools.
+   If generations is passed, it is filled with the generation of each record, 0 for non-existent ones */
+PHP_METHOD(Aerospike, existsManyCompact) {
+	as_error err;
+	as_error_init(&err);
+
+	aerospike* as_client;
+	AerospikeClient* php_client;
+	HashTable* z_key_array = NULL;
+	/* zvals by reference to be filled with results */
+	zval* z_exists = NULL;
+	zval* z_generations = NULL;
+	zval* z_policy = NULL;
+
+	as_batch_read_records records;
+	as_batch_read_record* record = NULL;
+	bool records_initialized = false;
+	zend_string* bitmap = NULL;
+	int exists_format = EXISTS_FORMAT_BITMAP;
+
+	uint32_t key_count;
+	as_policy_batch batch_policy;
+	as_policy_batch* batch_policy_p = NULL;
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	reset_client_error(getThis());
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz/|zz/",
+			&z_key_array, &z_exists, &z_policy, &z_generations) == FAILURE) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to existsManyCompact");
+		goto CLEANUP;
+	}
+	zval_dtor(z_exists);
+	ZVAL_NULL(z_exists);
+	if (z_generations) {
+		zval_dtor(z_generations);
+		ZVAL_NULL(z_generations);
+	}
+
+	/* Set the batch policy, without options the keys may still share a profile */
+	if (zval_to_as_policy_batch(z_policy, &batch_policy,
+			&batch_policy_p, &get_batch_policies(php_client, z_key_array)->batch, php_client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid batch policy");
+		goto CLEANUP;
+	}
+
+	if (z_policy) {
+		if (set_exists_format_from_policy_hash(&exists_format, z_policy) != AEROSPIKE_OK) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid value for OPT_EXISTS_FORMAT");
+			goto CLEANUP;
+		}
+	}
+
+	key_count = zend_hash_num_elements(z_key_array);
+
+	as_batch_read_init(&records, key_count);
+	records_initialized = true;
+	zval* current_key = NULL;
+
+	/* Load the php keys as batch index records. Without bin names and without read_all_bins
+	 * the server only sends back the header of each record */
+	ZEND_HASH_FOREACH_VAL(z_key_array, current_key) {
+		if (Z_TYPE_P(current_key) != IS_ARRAY) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid Key");
+			goto CLEANUP;
+		}
+		record = as_batch_read_reserve(&records);
+		if (z_hashtable_to_as_key(Z_ARRVAL_P(current_key), &record->key, &err) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}ZEND_HASH_FOREACH_END();
+
+	aerospike_batch_read(as_client, &err, batch_policy_p, &records);
+	deliver_pending_log_events();
+	if (err.code != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (exists_format == EXISTS_FORMAT_BITMAP) {
+		bitmap = zend_string_alloc((key_count + 7) / 8, 0);
+		memset(ZSTR_VAL(bitmap), 0, ZSTR_LEN(bitmap) + 1);
+	} else {
+		array_init_size(z_exists, key_count);
+	}
+	if (z_generations) {
+		array_init_size(z_generations, key_count);
+	}
+
+	for (uint32_t i = 0; i < key_count; i++) {
+		record = (as_batch_read_record*)as_vector_get(&records.list, i);
+
+		if ( (record->result != AEROSPIKE_OK) && (record->result != AEROSPIKE_ERR_RECORD_NOT_FOUND) ) {
+			as_error_update(&err, record->result, "existsManyCompact failed");
+			goto CLEANUP;
+		}
+
+		if (bitmap) {
+			if (record->result == AEROSPIKE_OK) {
+				ZSTR_VAL(bitmap)[i >> 3] |= (char)(1 << (i & 7));
+			}
+		} else {
+			add_next_index_bool(z_exists, record->result == AEROSPIKE_OK);
+		}
+
+		if (z_generations) {
+			add_next_index_long(z_generations,
+					record->result == AEROSPIKE_OK ? record->record.gen : 0);
+		}
+	}
+
+	if (bitmap) {
+		ZVAL_STR(z_exists, bitmap);
+		bitmap = NULL;
+	}
+
+CLEANUP:
+	if (bitmap) {
+		zend_string_free(bitmap);
+	}
+	if (records_initialized) {
+		as_batch_read_destroy(&records);
+	}
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+
+		/* Partial results are never handed back */
+		if (z_exists) {
+			zval_dtor(z_exists);
+			ZVAL_NULL(z_exists);
+		}
+		if (z_generations) {
+			zval_dtor(z_generations);
+			ZVAL_NULL(z_generations);
+		}
+	}
+
+	RETURN_LONG(err.code);
+}
+/* }}} */
@@ -0,0 +1,731 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_exp.h"
+#include "aerospike/as_bytes.h"
+#include "expressions.h"
+
+/*
+ * Filter expressions.
+ *
+ * The static methods of Aerospike\Exp build an immutable tree of nodes, each holding the
+ * as_exp_entry values the matching as_exp_* macro of the C client would expand to. Passed as
+ * OPT_FILTER_EXP, the tree is flattened into an entry table and compiled by as_exp_compile()
+ * the first time, later commands reuse the compiled expression.
+ *
+ * PHP integers, floats, strings, booleans and NULL are accepted wherever an expression is, as
+ * the matching value expression.
+ */
+
+zend_class_entry* aerospike_exp_ce;
+static zend_object_handlers aerospike_exp_handlers;
+
+static zend_object* aerospike_exp_create_object(zend_class_entry* ce);
+static void aerospike_exp_free_storage(zend_object* object);
+static AerospikeExp* get_aerospike_exp_from_zobj(zend_object* zobj);
+static AerospikeExp* exp_new(zval* z_exp, as_exp_ops op, uint32_t count);
+static AerospikeExp* exp_new_value(zval* z_exp, as_exp_entry value);
+static AerospikeExp* exp_new_str(zval* z_exp, zend_string* str);
+static void exp_add_entry(AerospikeExp* exp, as_exp_entry entry);
+static bool exp_add_operand(AerospikeExp* exp, zval* z_operand);
+static bool exp_from_zval(zval* z_value, zval* z_exp);
+static uint32_t exp_entry_count(AerospikeExp* exp);
+static as_exp_entry exp_entry_at(AerospikeExp* exp, uint32_t i);
+static as_exp_entry* exp_write_entries(AerospikeExp* exp, as_exp_entry* pos);
+static void exp_bin(INTERNAL_FUNCTION_PARAMETERS, as_exp_type type);
+static void exp_key(INTERNAL_FUNCTION_PARAMETERS, as_exp_type type);
+static void exp_metadata(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op);
+static void exp_compare(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op);
+static void exp_variadic(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op);
+
+PHP_METHOD(AerospikeExp, __construct) {}
+
+static zend_function_entry aerospike_exp_class_functions[] =
+{
+	PHP_ME(AerospikeExp, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeExp, int, exp_value_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, float, exp_value_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, str, exp_value_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, bool, exp_value_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, bytes, exp_value_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, nil, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, intBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, floatBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, strBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, blobBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, listBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, mapBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, geoBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, hllBin, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, binExists, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, binType, exp_bin_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, keyInt, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, keyStr, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, keyBlob, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, keyExists, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, setName, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, deviceSize, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, lastUpdate, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, sinceUpdate, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, voidTime, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, ttl, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, isTombstone, exp_no_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, digestModulo, exp_digest_modulo_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, eq, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, ne, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, gt, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, ge, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, lt, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, le, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, regex, exp_regex_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, geoCompare, exp_compare_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, not, exp_not_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, and, exp_variadic_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, or, exp_variadic_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_ME(AerospikeExp, exclusive, exp_variadic_arg_info, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_exp_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Exp", aerospike_exp_class_functions);
+	aerospike_exp_ce = zend_register_internal_class(&ce);
+	aerospike_exp_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_exp_ce->create_object = aerospike_exp_create_object;
+	aerospike_exp_ce->serialize = zend_class_serialize_deny;
+	aerospike_exp_ce->unserialize = zend_class_unserialize_deny;
+
+	/* Flags of regex(), as the server's POSIX regcomp() flags */
+	zend_declare_class_constant_long(aerospike_exp_ce, "REGEX_NONE", sizeof("REGEX_NONE") - 1, 0);
+	zend_declare_class_constant_long(aerospike_exp_ce, "REGEX_EXTENDED", sizeof("REGEX_EXTENDED") - 1, 1);
+	zend_declare_class_constant_long(aerospike_exp_ce, "REGEX_ICASE", sizeof("REGEX_ICASE") - 1, 2);
+	zend_declare_class_constant_long(aerospike_exp_ce, "REGEX_NOSUB", sizeof("REGEX_NOSUB") - 1, 4);
+	zend_declare_class_constant_long(aerospike_exp_ce, "REGEX_NEWLINE", sizeof("REGEX_NEWLINE") - 1, 8);
+
+	memcpy(&aerospike_exp_handlers, zend_get_std_object_handlers(), sizeof(aerospike_exp_handlers));
+	aerospike_exp_handlers.free_obj = aerospike_exp_free_storage;
+	aerospike_exp_handlers.clone_obj = NULL;
+	aerospike_exp_handlers.offset = XtOffsetOf(AerospikeExp, zobj);
+
+	return true;
+}
+
+static AerospikeExp* get_aerospike_exp_from_zobj(zend_object* zobj) {
+	return (AerospikeExp*)((char*)zobj - XtOffsetOf(AerospikeExp, zobj));
+}
+
+static zend_object* aerospike_exp_create_object(zend_class_entry* ce) {
+	AerospikeExp* exp = ecalloc(1, sizeof(*exp) + zend_object_properties_size(ce));
+	ZVAL_UNDEF(&exp->z_operands);
+
+	zend_object_std_init(&exp->zobj, ce);
+	object_properties_init(&exp->zobj, ce);
+	exp->zobj.handlers = &aerospike_exp_handlers;
+
+	return &exp->zobj;
+}
+
+static void aerospike_exp_free_storage(zend_object* object) {
+	AerospikeExp* exp = get_aerospike_exp_from_zobj(object);
+
+	if (exp->compiled) {
+		as_exp_destroy(exp->compiled);
+	}
+	if (exp->str) {
+		zend_string_release(exp->str);
+	}
+	zval_ptr_dtor(&exp->z_operands);
+	zend_object_std_dtor(object);
+}
+
+/*
+ * The filter expression of z_exp, compiled the first time. NULL if z_exp is not an Aerospike\Exp.
+ * The expression belongs to the object, commands using it must not outlive it.
+ */
+as_exp* as_php_exp_compile(zval* z_exp) {
+	AerospikeExp* exp = NULL;
+	as_exp_entry* table = NULL;
+	uint32_t count = 0;
+
+	if (Z_TYPE_P(z_exp) != IS_OBJECT || Z_OBJCE_P(z_exp) != aerospike_exp_ce) {
+		return NULL;
+	}
+
+	exp = get_aerospike_exp_from_zobj(Z_OBJ_P(z_exp));
+	if (exp->compiled) {
+		return exp->compiled;
+	}
+
+	/* The table is a copy, as_exp_compile() sizes its entries in place and destroys its values */
+	count = exp_entry_count(exp);
+	table = (as_exp_entry*)safe_emalloc(count, sizeof(as_exp_entry), 0);
+	exp_write_entries(exp, table);
+	exp->compiled = as_exp_compile(table, count);
+	efree(table);
+
+	return exp->compiled;
+}
+
+static AerospikeExp* exp_new(zval* z_exp, as_exp_ops op, uint32_t count) {
+	AerospikeExp* exp = NULL;
+
+	object_init_ex(z_exp, aerospike_exp_ce);
+	exp = get_aerospike_exp_from_zobj(Z_OBJ_P(z_exp));
+	exp->entries[0] = (as_exp_entry){.op = op, .count = count};
+	exp->entry_count = 1;
+	exp->operands_at = 1;
+
+	return exp;
+}
+
+/* A value, whose as_exp_* macro is a single entry */
+static AerospikeExp* exp_new_value(zval* z_exp, as_exp_entry value) {
+	AerospikeExp* exp = exp_new(z_exp, 0, 0);
+
+	exp->entries[0] = value;
+	return exp;
+}
+
+static AerospikeExp* exp_new_str(zval* z_exp, zend_string* str) {
+	AerospikeExp* exp = exp_new(z_exp, 0, 0);
+
+	exp->str = zend_string_copy(str);
+	exp->value_type = AS_STRING;
+	return exp;
+}
+
+static void exp_add_entry(AerospikeExp* exp, as_exp_entry entry) {
+	exp->entries[exp->entry_count++] = entry;
+}
+
+static bool exp_add_operand(AerospikeExp* exp, zval* z_operand) {
+	zval z_exp;
+
+	if (!exp_from_zval(z_operand, &z_exp)) {
+		return false;
+	}
+
+	if (Z_TYPE(exp->z_operands) == IS_UNDEF) {
+		array_init(&exp->z_operands);
+	}
+	add_next_index_zval(&exp->z_operands, &z_exp);
+	return true;
+}
+
+/* An expression is taken as is, a PHP scalar becomes the value expression */
+static bool exp_from_zval(zval* z_value, zval* z_exp) {
+	switch (Z_TYPE_P(z_value)) {
+		case IS_OBJECT:
+			if (Z_OBJCE_P(z_value) != aerospike_exp_ce) {
+				return false;
+			}
+			ZVAL_COPY(z_exp, z_value);
+			return true;
+		case IS_LONG:
+			exp_new_value(z_exp, (as_exp_entry)as_exp_int(Z_LVAL_P(z_value)));
+			return true;
+		case IS_DOUBLE:
+			exp_new_value(z_exp, (as_exp_entry)as_exp_float(Z_DVAL_P(z_value)));
+			return true;
+		case IS_STRING:
+			exp_new_str(z_exp, Z_STR_P(z_value));
+			return true;
+		case IS_TRUE:
+		case IS_FALSE:
+			exp_new_value(z_exp, (as_exp_entry)as_exp_bool(Z_TYPE_P(z_value) == IS_TRUE));
+			return true;
+		case IS_NULL:
+			exp_new_value(z_exp, (as_exp_entry)as_exp_nil());
+			return true;
+		default:
+			return false;
+	}
+}
+
+static uint32_t exp_entry_count(AerospikeExp* exp) {
+	uint32_t count = exp->entry_count + (exp->variadic ? 1 : 0);
+	zval* z_operand = NULL;
+
+	if (Z_TYPE(exp->z_operands) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(exp->z_operands), z_operand) {
+			count += exp_entry_count(get_aerospike_exp_from_zobj(Z_OBJ_P(z_operand)));
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	return count;
+}
+
+/*
+ * as_exp_compile() destroys the as_val of a value entry once packed, so string and bytes values
+ * get a new one each time, as a node can be compiled again as part of another expression.
+ */
+static as_exp_entry exp_entry_at(AerospikeExp* exp, uint32_t i) {
+	switch (exp->value_type) {
+		case AS_STRING:
+			return (as_exp_entry)as_exp_str(ZSTR_VAL(exp->str));
+		case AS_BYTES:
+			return (as_exp_entry)as_exp_bytes((uint8_t*)ZSTR_VAL(exp->str), (uint32_t)ZSTR_LEN(exp->str));
+		default:
+			return exp->entries[i];
+	}
+}
+
+static as_exp_entry* exp_write_entries(AerospikeExp* exp, as_exp_entry* pos) {
+	zval* z_operand = NULL;
+	uint32_t i;
+
+	for (i = 0; i < exp->operands_at; i++) {
+		*pos++ = exp_entry_at(exp, i);
+	}
+
+	if (Z_TYPE(exp->z_operands) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(exp->z_operands), z_operand) {
+			pos = exp_write_entries(get_aerospike_exp_from_zobj(Z_OBJ_P(z_operand)), pos);
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	for (; i < exp->entry_count; i++) {
+		*pos++ = exp_entry_at(exp, i);
+	}
+
+	if (exp->variadic) {
+		*pos++ = (as_exp_entry){.op = _AS_EXP_CODE_END_OF_VA_ARGS};
+	}
+
+	return pos;
+}
+
+/* as_exp_bin_*(): the value type, then the bin name */
+static void exp_bin(INTERNAL_FUNCTION_PARAMETERS, as_exp_type type) {
+	AerospikeExp* exp = NULL;
+	zend_string* bin = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S", &bin) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_BIN, 3);
+	exp->str = zend_string_copy(bin);
+	exp_add_entry(exp, (as_exp_entry)as_exp_int(type));
+	exp_add_entry(exp, (as_exp_entry)_AS_EXP_VAL_RAWSTR(ZSTR_VAL(exp->str)));
+}
+
+/* as_exp_key(), only there if the key was stored with the record */
+static void exp_key(INTERNAL_FUNCTION_PARAMETERS, as_exp_type type) {
+	AerospikeExp* exp = NULL;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_KEY, 2);
+	exp_add_entry(exp, (as_exp_entry)as_exp_int(type));
+}
+
+static void exp_metadata(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op) {
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new(return_value, op, 1);
+}
+
+static void exp_compare(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op) {
+	AerospikeExp* exp = NULL;
+	zval* z_left = NULL;
+	zval* z_right = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "zz", &z_left, &z_right) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, op, 3);
+	if (!exp_add_operand(exp, z_left) || !exp_add_operand(exp, z_right)) {
+		php_error_docref(NULL, E_WARNING, "Operands must be expressions or scalar values");
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+
+static void exp_variadic(INTERNAL_FUNCTION_PARAMETERS, as_exp_ops op) {
+	AerospikeExp* exp = NULL;
+	zval* z_args = NULL;
+	int arg_count = 0;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "+", &z_args, &arg_count) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, op, 0);
+	exp->variadic = true;
+	for (int i = 0; i < arg_count; i++) {
+		if (!exp_add_operand(exp, &z_args[i])) {
+			php_error_docref(NULL, E_WARNING, "Operands must be expressions or scalar values");
+			zval_ptr_dtor(return_value);
+			RETURN_NULL();
+		}
+	}
+}
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::int( int value ) */
+PHP_METHOD(AerospikeExp, int) {
+	zend_long value;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &value) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new_value(return_value, (as_exp_entry)as_exp_int(value));
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::float( float value ) */
+PHP_METHOD(AerospikeExp, float) {
+	double value;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "d", &value) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new_value(return_value, (as_exp_entry)as_exp_float(value));
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::str( string value ) */
+PHP_METHOD(AerospikeExp, str) {
+	zend_string* value = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S", &value) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new_str(return_value, value);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::bool( bool value ) */
+PHP_METHOD(AerospikeExp, bool) {
+	zend_bool value;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "b", &value) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new_value(return_value, (as_exp_entry)as_exp_bool(value));
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::bytes( string value )
+    A blob value, to compare with blobBin() */
+PHP_METHOD(AerospikeExp, bytes) {
+	AerospikeExp* exp = NULL;
+	zend_string* value = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S", &value) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, 0, 0);
+	exp->str = zend_string_copy(value);
+	exp->value_type = AS_BYTES;
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::nil( ) */
+PHP_METHOD(AerospikeExp, nil) {
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp_new_value(return_value, (as_exp_entry)as_exp_nil());
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::intBin( string bin ) */
+PHP_METHOD(AerospikeExp, intBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_INT);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::floatBin( string bin ) */
+PHP_METHOD(AerospikeExp, floatBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_FLOAT);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::strBin( string bin ) */
+PHP_METHOD(AerospikeExp, strBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_STR);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::blobBin( string bin ) */
+PHP_METHOD(AerospikeExp, blobBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_BLOB);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::listBin( string bin ) */
+PHP_METHOD(AerospikeExp, listBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_LIST);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::mapBin( string bin ) */
+PHP_METHOD(AerospikeExp, mapBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_MAP);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::geoBin( string bin ) */
+PHP_METHOD(AerospikeExp, geoBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_GEOJSON);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::hllBin( string bin ) */
+PHP_METHOD(AerospikeExp, hllBin) {
+	exp_bin(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_HLL);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::binType( string bin )
+    The AS_BYTES_* particle type of the bin, 0 if the record has no such bin */
+PHP_METHOD(AerospikeExp, binType) {
+	AerospikeExp* exp = NULL;
+	zend_string* bin = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S", &bin) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_BIN_TYPE, 2);
+	exp->str = zend_string_copy(bin);
+	exp_add_entry(exp, (as_exp_entry)_AS_EXP_VAL_RAWSTR(ZSTR_VAL(exp->str)));
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::binExists( string bin )
+    As as_exp_bin_exists(), binType(bin) != 0 */
+PHP_METHOD(AerospikeExp, binExists) {
+	AerospikeExp* exp = NULL;
+	AerospikeExp* bin_type = NULL;
+	zend_string* bin = NULL;
+	zval z_bin_type;
+	zval z_undef;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "S", &bin) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	bin_type = exp_new(&z_bin_type, AS_EXP_CODE_BIN_TYPE, 2);
+	bin_type->str = zend_string_copy(bin);
+	exp_add_entry(bin_type, (as_exp_entry)_AS_EXP_VAL_RAWSTR(ZSTR_VAL(bin_type->str)));
+	ZVAL_LONG(&z_undef, AS_BYTES_UNDEF);
+
+	exp = exp_new(return_value, AS_EXP_CODE_CMP_NE, 3);
+	exp_add_operand(exp, &z_bin_type);
+	exp_add_operand(exp, &z_undef);
+	zval_ptr_dtor(&z_bin_type);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::keyInt( ) */
+PHP_METHOD(AerospikeExp, keyInt) {
+	exp_key(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_INT);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::keyStr( ) */
+PHP_METHOD(AerospikeExp, keyStr) {
+	exp_key(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_STR);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::keyBlob( ) */
+PHP_METHOD(AerospikeExp, keyBlob) {
+	exp_key(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_TYPE_BLOB);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::keyExists( ) */
+PHP_METHOD(AerospikeExp, keyExists) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_KEY_EXIST);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::setName( ) */
+PHP_METHOD(AerospikeExp, setName) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_SET_NAME);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::deviceSize( ) */
+PHP_METHOD(AerospikeExp, deviceSize) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_DEVICE_SIZE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::lastUpdate( ) */
+PHP_METHOD(AerospikeExp, lastUpdate) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_LAST_UPDATE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::sinceUpdate( ) */
+PHP_METHOD(AerospikeExp, sinceUpdate) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_SINCE_UPDATE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::voidTime( ) */
+PHP_METHOD(AerospikeExp, voidTime) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_VOID_TIME);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::ttl( ) */
+PHP_METHOD(AerospikeExp, ttl) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_TTL);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::isTombstone( ) */
+PHP_METHOD(AerospikeExp, isTombstone) {
+	exp_metadata(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_IS_TOMBSTONE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::digestModulo( int modulo ) */
+PHP_METHOD(AerospikeExp, digestModulo) {
+	AerospikeExp* exp = NULL;
+	zend_long modulo;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "l", &modulo) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_DIGEST_MODULO, 2);
+	exp_add_entry(exp, (as_exp_entry)as_exp_int(modulo));
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::eq( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, eq) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_EQ);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::ne( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, ne) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_NE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::gt( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, gt) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_GT);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::ge( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, ge) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_GE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::lt( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, lt) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_LT);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::le( mixed left, mixed right ) */
+PHP_METHOD(AerospikeExp, le) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_LE);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::geoCompare( mixed left, mixed right )
+    True if the regions or points of left and right intersect */
+PHP_METHOD(AerospikeExp, geoCompare) {
+	exp_compare(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_CMP_GEO);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::regex( string regex, mixed exp [, int flags ] )
+    As as_exp_cmp_regex(), the flags and the regex are written ahead of the string */
+PHP_METHOD(AerospikeExp, regex) {
+	AerospikeExp* exp = NULL;
+	zend_string* regex = NULL;
+	zval* z_exp = NULL;
+	zend_long flags = 0;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "Sz|l", &regex, &z_exp, &flags) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_CMP_REGEX, 4);
+	exp->str = zend_string_copy(regex);
+	exp_add_entry(exp, (as_exp_entry)as_exp_int(flags));
+	exp_add_entry(exp, (as_exp_entry)_AS_EXP_VAL_RAWSTR(ZSTR_VAL(exp->str)));
+	exp->operands_at = exp->entry_count;
+	if (!exp_add_operand(exp, z_exp)) {
+		php_error_docref(NULL, E_WARNING, "Operands must be expressions or scalar values");
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::not( mixed exp ) */
+PHP_METHOD(AerospikeExp, not) {
+	AerospikeExp* exp = NULL;
+	zval* z_exp = NULL;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &z_exp) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	exp = exp_new(return_value, AS_EXP_CODE_NOT, 2);
+	if (!exp_add_operand(exp, z_exp)) {
+		php_error_docref(NULL, E_WARNING, "Operands must be expressions or scalar values");
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::and( mixed exp, ... ) */
+PHP_METHOD(AerospikeExp, and) {
+	exp_variadic(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_AND);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::or( mixed exp, ... ) */
+PHP_METHOD(AerospikeExp, or) {
+	exp_variadic(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_OR);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Exp Aerospike\Exp::exclusive( mixed exp, ... )
+    True if exactly one of the expressions is */
+PHP_METHOD(AerospikeExp, exclusive) {
+	exp_variadic(INTERNAL_FUNCTION_PARAM_PASSTHRU, AS_EXP_CODE_EXCLUSIVE);
+}
+/* }}} */
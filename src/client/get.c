@@ -52,16 +52,21 @@ PHP_METHOD(Aerospike, get)
 	}
 	aerospike* as_ptr = client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "hz/|z!z",
-		&z_key_hash, &get_record, &z_filter, &z_read_policy) != SUCCESS) {
-			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to Aerospike::get", false);
-			RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 4)
+		Z_PARAM_ARRAY_HT(z_key_hash)
+		Z_PARAM_ZVAL_EX(get_record, 0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL_EX(z_filter, 1, 0)
+		Z_PARAM_ZVAL(z_read_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to Aerospike::get", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	);
 	zval_dtor(get_record);
 	ZVAL_NULL(get_record);
 
 	/* Load the default policies and merge them with any passed to the function */
-	as_status converted = zval_to_as_policy_read(z_read_policy, &read_policy, &read_policy_p, &as_ptr->config.policies.read);
+	as_status converted = zval_to_as_policy_read(z_read_policy, &read_policy, &read_policy_p, &get_key_policies(client, z_key_hash)->read, client);
 	if (converted != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid read read_policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
@@ -93,6 +98,7 @@ PHP_METHOD(Aerospike, get)
 	/* Call get if there were no bins passed in */
 	} else {
 	    aerospike_key_get(as_ptr, &err, read_policy_p, &key, &record);
+	    deliver_pending_log_events();
 	    if (err.code != AEROSPIKE_OK) {
 			goto CLEANUP;
 	    }
@@ -167,5 +173,6 @@ static as_status as_get_with_bins(aerospike* as, as_error* err, const as_key* ke
 	} ZEND_HASH_FOREACH_END();
 
 	aerospike_key_select(as, err, read_policy_p, key, (const char**)c_filter_bins, record);
+	deliver_pending_log_events();
 	return err->code;
 }
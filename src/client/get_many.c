@@ -24,12 +24,19 @@
 
 
 as_status get_many_with_batch_read(aerospike* as, as_error* err, const as_policy_batch* policy,
-		char** bins, uint32_t bin_count, HashTable* z_keys, zval* z_records);
+		char** bins, uint32_t bin_count, HashTable* z_keys, zval* z_records, int retry_budget, bool with_results);
+static bool is_retryable_batch_status(as_status status);
+static void init_batch_read_record(as_batch_read_record* record, char** bins, uint32_t bin_count);
 
 /*
  * These function support the getMany calls, based on whether batch direct is being used,
  * two separate helper functions are called, one utilizes a callback passed to aerospike_batch_get
  * the other handles the stored records from aerospike_batch_read
+ *
+ * With Aerospike::OPT_BATCH_RESULTS every returned entry carries the status of its key under
+ * "result". If the options contain
+ * Aerospike::OPT_BATCH_RETRY_FAILED_KEYS, keys whose sub-batch timed out or whose node failed are
+ * sent again, up to that many extra rounds, instead of failing the whole call.
  */
 
 
@@ -51,6 +58,8 @@ PHP_METHOD(Aerospike, getMany) {
 	aerospike* as_client = NULL;
 
 	uint32_t bin_count = 0;
+	int retry_budget = -1;
+	bool with_results = false;
 	as_error err;
 	as_error_init(&err);
 	reset_client_error(getThis());
@@ -62,21 +71,36 @@ PHP_METHOD(Aerospike, getMany) {
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz/|h!z",
-			&z_keys, &z_records, &z_filter, &z_policy) == FAILURE) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 4)
+		Z_PARAM_ARRAY_HT(z_keys)
+		Z_PARAM_ZVAL_EX(z_records, 0, 1)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ARRAY_HT_EX(z_filter, 1, 0)
+		Z_PARAM_ZVAL(z_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to getMany", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 	zval_dtor(z_records);
 	ZVAL_NULL(z_records);
 
+	/* Without options the keys may still share a profile */
+	if (zval_to_as_policy_batch(z_policy, &batch_policy,
+			&batch_policy_p, &get_batch_policies(php_client, z_keys)->batch, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid batch policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
 	if (z_policy) {
-		if (zval_to_as_policy_batch(z_policy, &batch_policy,
-				&batch_policy_p, &as_client->config.policies.batch) != AEROSPIKE_OK) {
-			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid batch policy", false);
+		if (set_batch_retry_budget_from_policy_hash(&retry_budget, z_policy) != AEROSPIKE_OK) {
+			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid value for OPT_BATCH_RETRY_FAILED_KEYS", false);
+			RETURN_LONG(AEROSPIKE_ERR_PARAM);
+		}
+
+		if (set_batch_results_from_policy_hash(&with_results, z_policy) != AEROSPIKE_OK) {
+			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid value for OPT_BATCH_RESULTS", false);
 			RETURN_LONG(AEROSPIKE_ERR_PARAM);
 		}
-		batch_policy_p = &batch_policy;
 	}
 
 	/* Transform the php filter bins into char** */
@@ -108,7 +132,9 @@ PHP_METHOD(Aerospike, getMany) {
 	}
 
 
-	get_many_with_batch_read(as_client, &err, batch_policy_p, bins, bin_count, z_keys, z_records);
+	get_many_with_batch_read(as_client, &err, batch_policy_p, bins, bin_count, z_keys, z_records, retry_budget,
+			with_results);
+	deliver_pending_log_events();
 
 
 CLEANUP:
@@ -122,9 +148,11 @@ CLEANUP:
 /* }}} */
 
 as_status get_many_with_batch_read(aerospike* as, as_error* err, const as_policy_batch* policy,
-		char** bins, uint32_t bin_count, HashTable* z_keys, zval* z_records) {
+		char** bins, uint32_t bin_count, HashTable* z_keys, zval* z_records, int retry_budget, bool with_results) {
 
 	int num_records;
+	int num_pending;
+	int retry_round = 0;
 	zval z_get_entry;
 	zval z_key_entry;
 	zval z_record_entry;
@@ -132,6 +160,10 @@ as_status get_many_with_batch_read(aerospike* as, as_error* err, const as_policy
 
 	as_batch_read_records records;
 	as_batch_read_record* record;
+	/* For each requested key, the record which holds its final answer. This is either
+	 * the entry in the original batch, or the entry from the retry round which resolved it */
+	as_batch_read_record** resolved = NULL;
+	as_batch_read_records* retry_records = NULL;
 
 	num_records = zend_hash_num_elements(z_keys);
 	array_init(z_records);
@@ -146,28 +178,72 @@ as_status get_many_with_batch_read(aerospike* as, as_error* err, const as_policy
 			goto CLEANUP;
 		}
 		record = as_batch_read_reserve(&records);
-		if (bins) {
-			record->bin_names = bins;
-			record->n_bin_names = bin_count;
-		} else {
-			record->read_all_bins = true;
-		}
+		init_batch_read_record(record, bins, bin_count);
 
 		if (z_hashtable_to_as_key(Z_ARRVAL_P(z_key), &record->key, err) != AEROSPIKE_OK) {
 			goto CLEANUP;
 		}
 	}ZEND_HASH_FOREACH_END();
 
-	if (aerospike_batch_read(as, err, policy, &records) != AEROSPIKE_OK) {
+	aerospike_batch_read(as, err, policy, &records);
+
+	/* Without a retry budget any failure of the batch as a whole fails the call */
+	if (err->code != AEROSPIKE_OK && (retry_budget < 0 || !is_retryable_batch_status(err->code))) {
 		goto CLEANUP;
 	}
 
+	resolved = (as_batch_read_record**)emalloc(num_records * sizeof(as_batch_read_record*));
+	for (int i = 0; i < num_records; i++) {
+		resolved[i] = (as_batch_read_record*)as_vector_get(&records.list, i);
+	}
+
+	/* Only re-send the keys whose sub-batch timed out or whose node failed,
+	 * keys which were answered by a healthy node are never fetched twice */
+	while (err->code != AEROSPIKE_OK && retry_round < retry_budget) {
+		num_pending = 0;
+		for (int i = 0; i < num_records; i++) {
+			if (is_retryable_batch_status(resolved[i]->result)) {
+				num_pending++;
+			}
+		}
+
+		if (!num_pending) {
+			break;
+		}
+
+		retry_records = (as_batch_read_records*)safe_erealloc(retry_records, retry_round + 1,
+				sizeof(as_batch_read_records), 0);
+		as_batch_read_init(&retry_records[retry_round], num_pending);
+		for (int i = 0; i < num_records; i++) {
+			if (!is_retryable_batch_status(resolved[i]->result)) {
+				continue;
+			}
+			as_key* original_key = &((as_batch_read_record*)as_vector_get(&records.list, i))->key;
+
+			record = as_batch_read_reserve(&retry_records[retry_round]);
+			init_batch_read_record(record, bins, bin_count);
+			as_key_init_digest(&record->key, original_key->ns, original_key->set,
+					as_key_digest(original_key)->value);
+			resolved[i] = record;
+		}
+
+		as_error_reset(err);
+		aerospike_batch_read(as, err, policy, &retry_records[retry_round]);
+		retry_round++;
+
+		if (err->code != AEROSPIKE_OK && !is_retryable_batch_status(err->code)) {
+			goto CLEANUP;
+		}
+	}
+
 	for (int i = 0; i < num_records; i++) {
-		record = (as_batch_read_record*)as_vector_get(&records.list, i);
+		record = resolved[i];
+		/* Always use the key which was passed in, retries only carry the digest */
+		as_key* original_key = &((as_batch_read_record*)as_vector_get(&records.list, i))->key;
 
-		if (record->result == AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+		if (record->result != AEROSPIKE_OK) {
 
-			if (as_key_to_zval(&record->key, &z_key_entry, true, err) != AEROSPIKE_OK) {
+			if (as_key_to_zval(original_key, &z_key_entry, true, err) != AEROSPIKE_OK) {
 				goto CLEANUP;
 			}
 
@@ -175,25 +251,73 @@ as_status get_many_with_batch_read(aerospike* as, as_error* err, const as_policy
 			add_assoc_zval(&z_get_entry, "key", &z_key_entry);
 			add_assoc_null(&z_get_entry, "metadata");
 			add_assoc_null(&z_get_entry, "bins");
+			if (with_results) {
+				add_assoc_long(&z_get_entry, "result", record->result);
+			}
 
 			add_next_index_zval(z_records, &z_get_entry);
 
 		} else {
-			if (as_record_to_zval(&record->record, &z_record_entry, &record->key, true, err) != AEROSPIKE_OK) {
+			if (as_record_to_zval(&record->record, &z_record_entry, original_key, true, err) != AEROSPIKE_OK) {
 				goto CLEANUP;
 			}
+			if (with_results) {
+				add_assoc_long(&z_record_entry, "result", record->result);
+			}
 			add_next_index_zval(z_records, &z_record_entry);
 		}
 	}
 
 CLEANUP:
 
+	if (retry_records) {
+		for (int i = 0; i < retry_round; i++) {
+			as_batch_read_destroy(&retry_records[i]);
+		}
+		efree(retry_records);
+	}
+	if (resolved) {
+		efree(resolved);
+	}
 	if (records_initialized) {
 		as_batch_read_destroy(&records);
 	}
-	if (err->code != AEROSPIKE_OK) {
+	/* When a retry budget was given, a node level failure which outlived it still hands back
+	 * the records which were read, unresolved keys have NULL bins and their status in "result" */
+	if (err->code != AEROSPIKE_OK && !(retry_budget >= 0 && is_retryable_batch_status(err->code))) {
 		zval_dtor(z_records);
 		ZVAL_NULL(z_records);
 	}
 	return err->code;
 }
+
+/*
+ * Whether a batch, or a single key inside of it, failed because of its node or sub-batch
+ * rather than because of the record itself. Those are the ones which are worth sending again.
+ */
+static bool is_retryable_batch_status(as_status status) {
+	switch (status) {
+		case AEROSPIKE_NO_RESPONSE:
+		case AEROSPIKE_ERR_TIMEOUT:
+		case AEROSPIKE_ERR_CONNECTION:
+		case AEROSPIKE_ERR_INVALID_NODE:
+		case AEROSPIKE_ERR_NO_MORE_CONNECTIONS:
+		case AEROSPIKE_ERR_CLUSTER:
+		case AEROSPIKE_ERR_CLUSTER_CHANGE:
+		case AEROSPIKE_ERR_DEVICE_OVERLOAD:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static void init_batch_read_record(as_batch_read_record* record, char** bins, uint32_t bin_count) {
+	if (bins) {
+		record->bin_names = bins;
+		record->n_bin_names = bin_count;
+	} else {
+		record->read_all_bins = true;
+	}
+	/* Keys which no node answered keep this status */
+	record->result = AEROSPIKE_NO_RESPONSE;
+}
@@ -0,0 +1,270 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "aerospike/as_error.h"
+#include "aerospike_class.h"
+#include "policy_conversions.h"
+#include "php_aerospike_types.h"
+#include "aerospike/aerospike_batch.h"
+#include "aerospike/as_arraylist.h"
+#include "aerospike/as_hll_operations.h"
+#include "conversions.h"
+
+/*
+ * Unions of the HyperLogLog bins of several records.
+ *
+ * The HLL bin of every key is fetched with one batch read, the union is then computed by the
+ * server on the record of the first key which has one, with the HLLs of the others passed along.
+ * Keys whose record, or bin, does not exist are left out of the union.
+ */
+
+static as_status hll_union_with_batch_read(AerospikeClient* client, as_error* err, HashTable* z_keys, const char* bin_name,
+		zval* z_policy, bool union_count, zval* z_result);
+static as_bytes* get_hll_from_record(as_record* record, const char* bin_name);
+
+/* {{{ proto int Aerospike::hllGetUnionCount( array $keys, string $bin, int &$count [, array $options] )
+    Estimate the number of distinct values added to the HLL bins of all of the keys */
+PHP_METHOD(Aerospike, hllGetUnionCount) {
+	HashTable* z_keys = NULL;
+	char* bin_name = NULL;
+	size_t bin_name_len = 0;
+	zval* z_count = NULL;
+	zval* z_policy = NULL;
+	AerospikeClient* php_client = NULL;
+	as_error err;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		RETURN_LONG(err.code);
+	}
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsz/|z", &z_keys, &bin_name, &bin_name_len,
+			&z_count, &z_policy) == FAILURE) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to hllGetUnionCount", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_count);
+	ZVAL_LONG(z_count, 0);
+
+	if (bin_name_len > AS_BIN_NAME_MAX_LEN) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Bin name is too long", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	hll_union_with_batch_read(php_client, &err, z_keys, bin_name, z_policy, true, z_count);
+
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike::hllGetUnion( array $keys, string $bin, Aerospike\Bytes &$hll [, array $options] )
+    Merge the HLL bins of all of the keys into one HLL, null when none of them has one */
+PHP_METHOD(Aerospike, hllGetUnion) {
+	HashTable* z_keys = NULL;
+	char* bin_name = NULL;
+	size_t bin_name_len = 0;
+	zval* z_hll = NULL;
+	zval* z_policy = NULL;
+	AerospikeClient* php_client = NULL;
+	as_error err;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		RETURN_LONG(err.code);
+	}
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsz/|z", &z_keys, &bin_name, &bin_name_len,
+			&z_hll, &z_policy) == FAILURE) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to hllGetUnion", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_hll);
+	ZVAL_NULL(z_hll);
+
+	if (bin_name_len > AS_BIN_NAME_MAX_LEN) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Bin name is too long", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	hll_union_with_batch_read(php_client, &err, z_keys, bin_name, z_policy, false, z_hll);
+
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/*
+ * Read the HLL bin of every key, then have the server merge them. With union_count z_result is set
+ * to the estimated count of the union, otherwise to the union itself as an Aerospike\Bytes.
+ * The options are used for the batch read and for the operation.
+ */
+static as_status hll_union_with_batch_read(AerospikeClient* client, as_error* err, HashTable* z_keys, const char* bin_name,
+		zval* z_policy, bool union_count, zval* z_result) {
+	aerospike* as = client->as_client;
+	as_policy_batch batch_policy;
+	as_policy_batch* batch_policy_p = NULL;
+	as_policy_operate operate_policy;
+	as_policy_operate* operate_policy_p = NULL;
+	as_batch_read_records records;
+	as_batch_read_record* record = NULL;
+	as_batch_read_record* first = NULL;
+	bool records_initialized = false;
+	char* bins[1];
+	as_arraylist others;
+	bool others_initialized = false;
+	as_bytes* hll = NULL;
+	as_operations ops;
+	bool operations_initialized = false;
+	as_record* rec = NULL;
+	zval* z_key = NULL;
+	uint32_t num_records = zend_hash_num_elements(z_keys);
+	as_policies* defaults = get_batch_policies(client, z_keys);
+
+	if (zval_to_as_policy_batch(z_policy, &batch_policy, &batch_policy_p,
+			&defaults->batch, client) != AEROSPIKE_OK) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid batch policy");
+	}
+	if (zval_to_as_policy_operate(z_policy, &operate_policy, &operate_policy_p,
+			&defaults->operate, client) != AEROSPIKE_OK) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
+	}
+
+	if (!num_records) {
+		return AEROSPIKE_OK;
+	}
+
+	bins[0] = (char*)bin_name;
+	as_batch_read_init(&records, num_records);
+	records_initialized = true;
+
+	ZEND_HASH_FOREACH_VAL(z_keys, z_key) {
+		if (!z_key || (Z_TYPE_P(z_key) != IS_ARRAY)) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Keys must be arrays");
+			goto CLEANUP;
+		}
+		record = as_batch_read_reserve(&records);
+		record->bin_names = bins;
+		record->n_bin_names = 1;
+
+		if (z_hashtable_to_as_key(Z_ARRVAL_P(z_key), &record->key, err) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (aerospike_batch_read(as, err, batch_policy_p, &records) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	/* The HLLs of every record but the first one with an HLL are sent along with the operation */
+	as_arraylist_init(&others, num_records, 0);
+	others_initialized = true;
+
+	for (uint32_t i = 0; i < num_records; i++) {
+		record = (as_batch_read_record*)as_vector_get(&records.list, i);
+		if (record->result == AEROSPIKE_ERR_RECORD_NOT_FOUND) {
+			continue;
+		}
+		if (record->result != AEROSPIKE_OK) {
+			as_error_update(err, record->result, "Failed to read the HLL bin of a key");
+			goto CLEANUP;
+		}
+
+		hll = get_hll_from_record(&record->record, bin_name);
+		if (!hll) {
+			continue;
+		}
+		if (!first) {
+			first = record;
+			continue;
+		}
+		as_val_reserve((as_val*)hll);
+		as_arraylist_append(&others, (as_val*)hll);
+	}
+
+	if (!first) {
+		goto CLEANUP;
+	}
+
+	/* A single HLL is its own union */
+	if (!union_count && !as_arraylist_size(&others)) {
+		as_bytes_to_zval_bytes(get_hll_from_record(&first->record, bin_name), z_result, err);
+		goto CLEANUP;
+	}
+
+	as_operations_inita(&ops, 1);
+	operations_initialized = true;
+
+	if (!as_arraylist_size(&others)) {
+		as_operations_hll_get_count(&ops, bin_name, NULL);
+	} else if (union_count) {
+		as_operations_hll_get_union_count(&ops, bin_name, NULL, (as_list*)&others);
+	} else {
+		as_operations_hll_get_union(&ops, bin_name, NULL, (as_list*)&others);
+	}
+
+	if (aerospike_key_operate(as, err, operate_policy_p, &first->key, &ops, &rec) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (union_count) {
+		ZVAL_LONG(z_result, as_record_get_int64(rec, bin_name, 0));
+	} else {
+		hll = as_record_get_bytes(rec, bin_name);
+		if (!hll) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "The union of the HLL bins is missing from the response");
+			goto CLEANUP;
+		}
+		as_bytes_to_zval_bytes(hll, z_result, err);
+	}
+
+CLEANUP:
+	if (rec) {
+		as_record_destroy(rec);
+	}
+	if (operations_initialized) {
+		as_operations_destroy(&ops);
+	}
+	if (others_initialized) {
+		as_arraylist_destroy(&others);
+	}
+	if (records_initialized) {
+		as_batch_read_destroy(&records);
+	}
+	return err->code;
+}
+
+/* The bin as an HLL, NULL if it does not hold one */
+static as_bytes* get_hll_from_record(as_record* record, const char* bin_name) {
+	as_bytes* bytes = as_record_get_bytes(record, bin_name);
+
+	if (!bytes || as_bytes_get_type(bytes) != AS_BYTES_HLL) {
+		return NULL;
+	}
+	return bytes;
+}
@@ -58,12 +58,16 @@ PHP_METHOD(Aerospike, increment)
 	}
 	aerospike* as_ptr = client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsz|z", &z_key, &bin_str,
-							  &bin_len, &z_increment,
-							  &z_op_policy) != SUCCESS) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 3, 4)
+		Z_PARAM_ARRAY_HT(z_key)
+		Z_PARAM_STRING(bin_str, bin_len)
+		Z_PARAM_ZVAL(z_increment)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(z_op_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to increment", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 
 	/* Valid increment argument is either a long, a double, or a numeric string e.g. "5.5" */
 	if (Z_TYPE_P(z_increment) == IS_LONG) {
@@ -102,7 +106,7 @@ PHP_METHOD(Aerospike, increment)
 	key_initialized = true;
 
 	if (zval_to_as_policy_operate(z_op_policy, &operate_policy,
-			&operate_policy_p, &as_ptr->config.policies.operate) != AEROSPIKE_OK) {
+			&operate_policy_p, &get_key_policies(client, z_key)->operate, client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid operate policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -132,6 +136,7 @@ PHP_METHOD(Aerospike, increment)
 	}
 
 	as_status status = aerospike_key_operate(as_ptr, &err, operate_policy_p, &key, &operations, &rec);
+	deliver_pending_log_events();
 	if (status != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 		goto CLEANUP;
@@ -119,8 +119,9 @@ PHP_METHOD(Aerospike, info)
 		port_number = (uint16_t)Z_LVAL_P(port_zval);
 	}
 
-	if (aerospike_info_host(as_client, &err, info_policy_p, host_str, port_number, request, &response_str)
-			!= AEROSPIKE_OK) {
+	aerospike_info_host(as_client, &err, info_policy_p, host_str, port_number, request, &response_str);
+	deliver_pending_log_events();
+	if (err.code != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 	/* It is possible that an empty response will be returned, so only setup the return
@@ -207,6 +208,7 @@ PHP_METHOD(Aerospike, infoMany) {
 
 	aerospike_info_foreach(as_client, &err, info_policy_p, request,
 			(aerospike_info_foreach_callback)AerospikeClient_Info_each, (void*)&cb_data);
+	deliver_pending_log_events();
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
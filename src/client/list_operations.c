@@ -18,6 +18,7 @@
 #include "php_aerospike_types.h"
 #include "conversions.h"
 #include "policy_conversions.h"
+#include "compiled_policy.h"
 
 #define DECLARE_LIST_OPERATION_VARS \
 		as_key key;\
@@ -34,7 +35,9 @@
 		char* bin_name = NULL;\
 		size_t bin_name_size;\
 		AerospikeClient* php_client = NULL;\
-		aerospike* as_client = NULL;
+		aerospike* as_client = NULL;\
+		as_cdt_ctx ctx;\
+		as_cdt_ctx* ctx_p = NULL;
 
 #define VALIDATE_CLIENT_AND_CONNECTION() \
 	do {\
@@ -56,11 +59,12 @@
 		}\
 	}while(0)
 
-static inline void cleanup_list_operation(as_key* key, bool key_initialized, as_operations* operations, bool operations_initialized, as_record* rec);
+static inline void cleanup_list_operation(as_key* key, bool key_initialized, as_operations* operations, bool operations_initialized,
+		as_record* rec, as_cdt_ctx* ctx_p);
 //static bool validate_list_operation_variables();
 static inline bool setup_list_operation_variables(HashTable* z_key, as_key* key, as_error* err, zval* z_operate_policy,
 		as_policy_operate* operate_policy, as_policy_operate** operate_policy_p, bool* key_initialized, as_operations** operations,
-		bool* ops_initialized, aerospike* as);
+		bool* ops_initialized, AerospikeClient* client, as_cdt_ctx* ctx, as_cdt_ctx** ctx_p);
 
 
 /* {{{ proto int Aerospike::listSize( array key, string bin, int count [,array options ] )
@@ -89,11 +93,11 @@ PHP_METHOD(Aerospike, listSize) {
 
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy,
 			&operate_policy_p, &key_initialized, &operations, &operations_initialized,
-			as_client)) {
+			php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	as_operations_add_list_size(operations, bin_name);
+	as_operations_list_size(operations, bin_name, ctx_p);
 
 	as_status status = aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 	if (status != AEROSPIKE_OK) {
@@ -103,7 +107,7 @@ PHP_METHOD(Aerospike, listSize) {
 	ZVAL_LONG(return_count, as_record_get_int64(rec, bin_name, -1));
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -118,7 +122,7 @@ PHP_METHOD(Aerospike, listAppend) {
 	DECLARE_LIST_OPERATION_VARS;
 	zval* z_append_value = NULL;
 	as_val* val_to_add = NULL;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	reset_client_error(getThis());
 	as_error_init(&err);
 
@@ -126,6 +130,7 @@ PHP_METHOD(Aerospike, listAppend) {
 	VALIDATE_CLIENT_AND_CONNECTION();
 
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsz|z", &z_key, &bin_name, &bin_name_size, &z_append_value, &z_operate_policy)
 			!= SUCCESS) {
@@ -136,7 +141,7 @@ PHP_METHOD(Aerospike, listAppend) {
 	CHECK_BIN_NAME();
 
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy,
-			&operate_policy_p, &key_initialized, &operations, &operations_initialized, as_client)) {
+			&operate_policy_p, &key_initialized, &operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -152,7 +157,7 @@ PHP_METHOD(Aerospike, listAppend) {
 		goto CLEANUP;
 	}
 
-	as_operations_add_list_append(operations, bin_name, val_to_add);
+	as_operations_list_append(operations, bin_name, ctx_p, NULL, val_to_add);
 
 	as_status status = aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 	if (status != AEROSPIKE_OK) {
@@ -161,7 +166,7 @@ PHP_METHOD(Aerospike, listAppend) {
 	}
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -176,7 +181,7 @@ PHP_METHOD(Aerospike, listMerge) {
 	//public int listMerge ( array $key, string $bin, array $items [, array $options ] )
 	DECLARE_LIST_OPERATION_VARS;
 	HashTable* items = NULL;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	as_list* list_items = NULL;
 	as_error_init(&err);
 
@@ -185,6 +190,7 @@ PHP_METHOD(Aerospike, listMerge) {
 	reset_client_error(getThis());
 
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hsh|z", &z_key, &bin_name, &bin_name_size,
 			&items, & z_operate_policy) == FAILURE) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to listSize", false);
@@ -195,7 +201,7 @@ PHP_METHOD(Aerospike, listMerge) {
 
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy,
 			&operate_policy_p, &key_initialized, &operations, &operations_initialized,
-			as_client)) {
+			php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -216,7 +222,7 @@ PHP_METHOD(Aerospike, listMerge) {
 		goto CLEANUP;
 	}
 
-	if (!as_operations_add_list_append_items(operations, bin_name, list_items)) {
+	if (!as_operations_list_append_items(operations, bin_name, ctx_p, NULL, list_items)) {
 		if (list_items) {
 			as_list_destroy(list_items);
 		}
@@ -228,7 +234,7 @@ PHP_METHOD(Aerospike, listMerge) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -246,11 +252,12 @@ PHP_METHOD(Aerospike, listInsert) {
 	zval* zval_to_add = NULL;
 	as_val* val_to_add = NULL;
 	zend_long index = 0;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	reset_client_error(getThis());
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	VALIDATE_CLIENT_AND_CONNECTION();
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if(zend_parse_parameters(ZEND_NUM_ARGS(), "hslz|z",
 			&z_key, &bin_name, &bin_name_size, &index, &zval_to_add, &z_operate_policy) == FAILURE) {
@@ -262,7 +269,7 @@ PHP_METHOD(Aerospike, listInsert) {
 
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy,
 			&operate_policy_p, &key_initialized, &operations, &operations_initialized,
-			as_client)) {
+			php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -280,7 +287,7 @@ PHP_METHOD(Aerospike, listInsert) {
 		goto CLEANUP;
 	}
 
-	if	(!as_operations_add_list_insert(operations, bin_name, (int64_t)index, val_to_add)) {
+	if	(!as_operations_list_insert(operations, bin_name, ctx_p, NULL, (int64_t)index, val_to_add)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), AEROSPIKE_ERR_CLIENT, "Failed to add operations", false);
 		as_val_destroy(val_to_add);
@@ -290,7 +297,7 @@ PHP_METHOD(Aerospike, listInsert) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -308,11 +315,12 @@ PHP_METHOD(Aerospike, listInsertItems) {
 	as_list* values_to_add = NULL;
 	HashTable* z_values_to_add = NULL;
 	zend_long index = 0;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	reset_client_error(getThis());
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	VALIDATE_CLIENT_AND_CONNECTION();
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hslh|z",
 			&z_key, &bin_name, &bin_name_size, &index, &z_values_to_add, &z_operate_policy) == FAILURE) {
@@ -324,7 +332,7 @@ PHP_METHOD(Aerospike, listInsertItems) {
 
 	if (!setup_list_operation_variables(z_key, &key, &err,z_operate_policy, &operate_policy,
 			&operate_policy_p, &key_initialized, &operations, &operations_initialized,
-			as_client)) {
+			php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -344,7 +352,7 @@ PHP_METHOD(Aerospike, listInsertItems) {
 		goto CLEANUP;
 	}
 
-	if (!as_operations_add_list_insert_items(operations, bin_name, (int64_t)index, values_to_add)) {
+	if (!as_operations_list_insert_items(operations, bin_name, ctx_p, NULL, (int64_t)index, values_to_add)) {
 		if (values_to_add) {
 			as_list_destroy(values_to_add);
 		}
@@ -356,7 +364,7 @@ PHP_METHOD(Aerospike, listInsertItems) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -373,11 +381,12 @@ PHP_METHOD(Aerospike, listPop) {
 	as_error_init(&err);
 	zval* retval = NULL;
 	zend_long index = 0;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	reset_client_error(getThis());
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	VALIDATE_CLIENT_AND_CONNECTION();
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hslz/|z",
 			&z_key, &bin_name, &bin_name_size, &index, &retval, &z_operate_policy) == FAILURE) {
@@ -392,7 +401,7 @@ PHP_METHOD(Aerospike, listPop) {
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy,
 			&operate_policy_p, &key_initialized, &operations, &operations_initialized,
-			as_client)) {
+			php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -402,7 +411,7 @@ PHP_METHOD(Aerospike, listPop) {
 		goto CLEANUP;
 	}
 
-	if (!as_operations_add_list_pop(operations, bin_name, (int64_t)index)) {
+	if (!as_operations_list_pop(operations, bin_name, ctx_p, (int64_t)index)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", false);
 		goto CLEANUP;
@@ -424,7 +433,7 @@ PHP_METHOD(Aerospike, listPop) {
 	}
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -462,11 +471,11 @@ PHP_METHOD(Aerospike, listPopRange) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if	(!as_operations_add_list_pop_range(operations, bin_name, (int64_t)start_index, (uint64_t)count)) {
+	if	(!as_operations_list_pop_range(operations, bin_name, ctx_p, (int64_t)start_index, (uint64_t)count)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", false);
 		goto CLEANUP;
@@ -489,7 +498,7 @@ PHP_METHOD(Aerospike, listPopRange) {
 	}
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -520,11 +529,11 @@ PHP_METHOD(Aerospike, listRemove) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if(!as_operations_add_list_remove(operations, bin_name, (int64_t)index)) {
+	if(!as_operations_list_remove(operations, bin_name, ctx_p, (int64_t)index)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", false);
 		goto CLEANUP;
@@ -533,7 +542,7 @@ PHP_METHOD(Aerospike, listRemove) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -565,11 +574,11 @@ PHP_METHOD(Aerospike, listRemoveRange) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if(!as_operations_add_list_remove_range(operations, bin_name, (int64_t)index, (uint64_t)count)) {
+	if(!as_operations_list_remove_range(operations, bin_name, ctx_p, (int64_t)index, (uint64_t)count)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", err.in_doubt);
 		goto CLEANUP;
@@ -578,7 +587,7 @@ PHP_METHOD(Aerospike, listRemoveRange) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -610,11 +619,11 @@ PHP_METHOD(Aerospike, listTrim) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if(!as_operations_add_list_trim(operations, bin_name, (int64_t)index, (uint64_t)count)) {
+	if(!as_operations_list_trim(operations, bin_name, ctx_p, (int64_t)index, (uint64_t)count)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", err.in_doubt);
 		goto CLEANUP;
@@ -623,7 +632,7 @@ PHP_METHOD(Aerospike, listTrim) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -653,11 +662,11 @@ PHP_METHOD(Aerospike, listClear) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if(!as_operations_add_list_clear(operations, bin_name)) {
+	if(!as_operations_list_clear(operations, bin_name, ctx_p)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		update_client_error(getThis(), err.code, "Failed to add operations", err.in_doubt);
 		goto CLEANUP;
@@ -666,7 +675,7 @@ PHP_METHOD(Aerospike, listClear) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -684,11 +693,12 @@ PHP_METHOD(Aerospike, listSet) {
 	zval* zval_to_add = NULL;
 	as_val* val_to_add = NULL;
 	zend_long index = 0;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	VALIDATE_CLIENT_AND_CONNECTION();
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if(zend_parse_parameters(ZEND_NUM_ARGS(), "hslz|z",
 			&z_key, &bin_name, &bin_name_size, &index, &zval_to_add, &z_operate_policy) == FAILURE) {
@@ -699,7 +709,7 @@ PHP_METHOD(Aerospike, listSet) {
 	CHECK_BIN_NAME();
 
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
@@ -717,7 +727,7 @@ PHP_METHOD(Aerospike, listSet) {
 		goto CLEANUP;
 	}
 
-	if	(!as_operations_add_list_set(operations, bin_name, (int64_t)index, val_to_add)) {
+	if	(!as_operations_list_set(operations, bin_name, ctx_p, NULL, (int64_t)index, val_to_add)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Failed to add operations");
 		as_val_destroy(val_to_add);
@@ -727,7 +737,7 @@ PHP_METHOD(Aerospike, listSet) {
 	aerospike_key_operate(as_client, &err, operate_policy_p, &key, operations, &rec);
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -756,14 +766,14 @@ PHP_METHOD(Aerospike, listGet) {
 
 	CHECK_BIN_NAME();
 	if(!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
 	zval_dtor(retval);
 	ZVAL_NULL(retval);
 
-	if (!as_operations_add_list_get(operations, bin_name, (int64_t)index)) {
+	if (!as_operations_list_get(operations, bin_name, ctx_p, (int64_t)index)) {
 		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Failed to add operations");
 		goto CLEANUP;
 	}
@@ -783,7 +793,7 @@ PHP_METHOD(Aerospike, listGet) {
 	}
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -819,11 +829,11 @@ PHP_METHOD(Aerospike, listGetRange) {
 	CHECK_BIN_NAME();
 
 	if (!setup_list_operation_variables(z_key, &key, &err, z_operate_policy, &operate_policy, &operate_policy_p, &key_initialized,
-			&operations, &operations_initialized, as_client)) {
+			&operations, &operations_initialized, php_client, &ctx, &ctx_p)) {
 		goto CLEANUP;
 	}
 
-	if	(!as_operations_add_list_get_range(operations, bin_name, (int64_t)start_index, (uint64_t)count)) {
+	if	(!as_operations_list_get_range(operations, bin_name, ctx_p, (int64_t)start_index, (uint64_t)count)) {
 		err.code = AEROSPIKE_ERR_CLIENT;
 		as_error_update(&err, err.code, "Failed to add operations");
 		goto CLEANUP;
@@ -848,7 +858,7 @@ PHP_METHOD(Aerospike, listGetRange) {
 	}
 
 CLEANUP:
-	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec);
+	cleanup_list_operation(&key, key_initialized, operations, operations_initialized, rec, ctx_p);
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
@@ -859,12 +869,16 @@ CLEANUP:
 
 
 /* Initialize all variables needed for list operations, also validate the key,
- * policy, and generation. Return true on success, false on failure.
+ * policy, generation and the OPT_CDT_CTX of a nested list. Return true on success, false on failure.
  */
 static inline bool setup_list_operation_variables(HashTable* z_key, as_key* key,
 		as_error* err, zval* z_operate_policy, as_policy_operate* operate_policy,
 		as_policy_operate** operate_policy_p, bool* key_initialized,
-		as_operations** operations, bool* operations_initialized, aerospike* as) {
+		as_operations** operations, bool* operations_initialized, AerospikeClient* client,
+		as_cdt_ctx* ctx, as_cdt_ctx** ctx_p) {
+	zval* z_options = NULL;
+	zval* z_ctx = NULL;
+	int serializer_type = client->serializer_type;
 
 	as_error_init(err);
 	if (z_hashtable_to_as_key(z_key, key, err) != AEROSPIKE_OK) {
@@ -875,7 +889,7 @@ static inline bool setup_list_operation_variables(HashTable* z_key, as_key* key,
 	*key_initialized = true;
 
 	if (AEROSPIKE_OK == zval_to_as_policy_operate(z_operate_policy, operate_policy,
-			operate_policy_p, &as->config.policies.operate)) {
+			operate_policy_p, &get_key_policies(client, z_key)->operate, client)) {
 		*operate_policy_p = operate_policy;
 	} else {
 		err->code = AEROSPIKE_ERR_PARAM;
@@ -897,13 +911,32 @@ static inline bool setup_list_operation_variables(HashTable* z_key, as_key* key,
 		return false;
 	}
 
+	z_options = as_php_policy_options(z_operate_policy);
+	if (z_options && Z_TYPE_P(z_options) == IS_ARRAY) {
+		z_ctx = zend_hash_index_find(Z_ARRVAL_P(z_options), OPT_CDT_CTX);
+	}
+	if (z_ctx) {
+		if (Z_TYPE_P(z_ctx) != IS_ARRAY) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "OPT_CDT_CTX must be an array");
+			return false;
+		}
+		if (set_serializer_from_policy_hash(&serializer_type, z_operate_policy) != AEROSPIKE_OK) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid serializer value");
+			return false;
+		}
+		if (z_hashtable_to_as_cdt_ctx(Z_ARRVAL_P(z_ctx), ctx, err, serializer_type) != AEROSPIKE_OK) {
+			return false;
+		}
+		*ctx_p = ctx;
+	}
+
 	return true;
 }
 
 
 /* De-allocate any memory created by the list operation */
 static inline void cleanup_list_operation(as_key* key, bool key_initialized, as_operations* operations,
-		bool operations_initialized, as_record* rec) {
+		bool operations_initialized, as_record* rec, as_cdt_ctx* ctx_p) {
 
 	if (key_initialized) {
 		as_key_destroy(key);
@@ -914,4 +947,7 @@ static inline void cleanup_list_operation(as_key* key, bool key_initialized, as_
 	if (rec) {
 		as_record_destroy(rec);
 	}
+	if (ctx_p) {
+		as_cdt_ctx_destroy(ctx_p);
+	}
 }
@@ -16,6 +16,45 @@
 
 #include "aerospike_class.h"
 #include "php_aerospike_types.h"
+#include "aerospike/as_atomic.h"
+#include "pthread.h"
+
+/*
+ * The C client logs from whichever thread it runs on, node, tender and event loop threads included,
+ * none of which may call into PHP. The log callback only records the event in the queue of the
+ * process, and the commands hand the queued events to the PHP log handler of their request once
+ * the C client call returns. What is still queued at the end of a request goes to its handler
+ * then. Once the queue is full the oldest events are overwritten.
+ *
+ * In ZTS builds the queue is shared by the threads of the process, an event goes to the handler
+ * of the first request to deliver after it was logged.
+ *
+ * The func and file strings of an event are the C client's __func__ and __FILE__ literals,
+ * so only their pointers are kept.
+ */
+
+#define AS_PHP_LOG_QUEUE_SIZE 1024
+/* Events handed to PHP per lock of the queue */
+#define AS_PHP_LOG_BATCH_SIZE 64
+
+typedef struct _as_php_log_event {
+	as_log_level level;
+	const char* func;
+	const char* file;
+	uint32_t line;
+} as_php_log_event;
+
+typedef struct _as_php_log_queue {
+	pthread_mutex_t lock;
+	as_php_log_event events[AS_PHP_LOG_QUEUE_SIZE];
+	uint32_t head;
+	/* Written under the lock, read atomically to skip locking an empty queue */
+	uint32_t count;
+} as_php_log_queue;
+
+static as_php_log_queue* log_queue = NULL;
+
+static bool call_log_handler(as_php_log_event* event);
 
 /*
  *******************************************************************************************************
@@ -29,13 +68,87 @@
  * @param line              The line number in file where the log was generated.
  * @param fmt               The format specifier for logger.
  *
- * @return true if log callback succeeds. Otherwise false.
+ * @return true, the event is delivered later by deliver_pending_log_events().
  *******************************************************************************************************
  */
 
 static bool aerospike_helper_log_callback(as_log_level level, const char * func, const char * file, uint32_t line, const char * fmt, ...)
 {
+	as_php_log_event* event = NULL;
+	uint32_t count = 0;
+
+	if (!log_queue) {
+		return true;
+	}
+
+	pthread_mutex_lock(&log_queue->lock);
+	count = log_queue->count;
+	if (count == AS_PHP_LOG_QUEUE_SIZE) {
+		log_queue->head = (log_queue->head + 1) % AS_PHP_LOG_QUEUE_SIZE;
+		count--;
+	}
+	event = &log_queue->events[(log_queue->head + count) % AS_PHP_LOG_QUEUE_SIZE];
+	event->level = level;
+	event->func = func;
+	event->file = file;
+	event->line = line;
+	as_store_uint32(&log_queue->count, count + 1);
+	pthread_mutex_unlock(&log_queue->lock);
+
+	return true;
+}
+
+/* Called from MINIT, before any client can log */
+void as_php_log_queue_init(void) {
+	log_queue = (as_php_log_queue*)calloc(1, sizeof(as_php_log_queue));
+	pthread_mutex_init(&log_queue->lock, NULL);
+}
+
+/* Called from MSHUTDOWN, once the clients and event loops are closed */
+void as_php_log_queue_destroy(void) {
+	as_php_log_queue* queue = log_queue;
+
+	as_log_set_callback(NULL);
+	log_queue = NULL;
+	pthread_mutex_destroy(&queue->lock);
+	free(queue);
+}
+
+/*
+ * Run the PHP log handler of this request on the queued events. Called by the commands once the
+ * C client call has returned and at the end of the request, a log handler calling the client does
+ * not deliver recursively.
+ */
+void deliver_pending_log_events(void) {
+	as_php_log_event events[AS_PHP_LOG_BATCH_SIZE];
+	uint32_t batch_count = 0;
+
+	/* An event queued after this read goes out with the next command */
+	if (!log_queue || !as_load_uint32(&log_queue->count) ||
+			!AEROSPIKE_G(is_log_callback_registered) || AEROSPIKE_G(delivering_logs)) {
+		return;
+	}
+
+	AEROSPIKE_G(delivering_logs) = true;
 
+	do {
+		pthread_mutex_lock(&log_queue->lock);
+		for (batch_count = 0; batch_count < AS_PHP_LOG_BATCH_SIZE && log_queue->count > batch_count; batch_count++) {
+			events[batch_count] = log_queue->events[log_queue->head];
+			log_queue->head = (log_queue->head + 1) % AS_PHP_LOG_QUEUE_SIZE;
+		}
+		as_store_uint32(&log_queue->count, log_queue->count - batch_count);
+		pthread_mutex_unlock(&log_queue->lock);
+
+		for (uint32_t i = 0; i < batch_count && !EG(exception); i++) {
+			call_log_handler(&events[i]);
+		}
+	} while (batch_count == AS_PHP_LOG_BATCH_SIZE && !EG(exception));
+
+	AEROSPIKE_G(delivering_logs) = false;
+}
+
+static bool call_log_handler(as_php_log_event* event) {
 	zend_fcall_info log_call_info;
 	zend_fcall_info_cache log_call_info_cache;
 	zval function_args[4];
@@ -46,32 +159,22 @@ static bool aerospike_helper_log_callback(as_log_level level, const char * func,
 	zval retval;
 	bool call_status = true;
 
-/* Accessing global thread local storage will cause issues here, so we just return if ZTS is enabled */
-#ifdef ZTS
-	return true;
-#endif
-
 	ZVAL_NULL(&retval);
 
-	/* This should not ever happen, but if it does indicate logging failure */
-	if (!AEROSPIKE_G(is_log_callback_registered)) {
-		return false;
-	}
-
 	memcpy(&log_call_info, &AEROSPIKE_G(log_callback_call_info), sizeof(zend_fcall_info));
 	memcpy(&log_call_info_cache, &AEROSPIKE_G(log_callback_call_info_cache), sizeof(zend_fcall_info_cache));
 
-	ZVAL_LONG(&log_level, level);
-	ZVAL_LONG(&line_number, line);
+	ZVAL_LONG(&log_level, event->level);
+	ZVAL_LONG(&line_number, event->line);
 
-	if (func) {
-		ZVAL_STRING(&function_name, func);
+	if (event->func) {
+		ZVAL_STRING(&function_name, event->func);
 	} else {
 		ZVAL_STRING(&function_name, "");
 	}
 
-	if (file) {
-		ZVAL_STRING(&file_name, file);
+	if (event->file) {
+		ZVAL_STRING(&file_name, event->file);
 	} else {
 		ZVAL_STRING(&file_name, "");
 	}
@@ -143,12 +246,6 @@ PHP_METHOD(Aerospike, setLogHandler) {
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-/* Since non ZE threads can call the callback, TLS will cause issues, so disallow this */
-#ifdef ZTS
-	update_client_error(getThis(), AEROSPIKE_ERR_CLIENT, "User log callback not currently supported in ZTS environments", false);
-	RETURN_LONG(AEROSPIKE_ERR_CLIENT);
-#endif
-
 	/* If there was a log callback registered before, we need to release it */
 	if AEROSPIKE_G(is_log_callback_registered) {
 		zval_dtor(&AEROSPIKE_G(log_callback_call_info).function_name);
@@ -18,6 +18,10 @@
 #include "php_aerospike_types.h"
 #include "conversions.h"
 #include "policy_conversions.h"
+#include "compiled_policy.h"
+#include "compiled_operations.h"
+#include "aerospike/as_bit_operations.h"
+#include "aerospike/as_hll_operations.h"
 
 static inline bool op_requires_long_val(int op_type);
 static inline bool op_requires_list_val(int op_type);
@@ -26,6 +30,11 @@ static inline bool op_requires_val(int op_type);
 static inline bool op_requires_as_val(int op_type);
 static inline bool op_requires_index(int op_type);
 static inline bool op_is_map_op(int op_type);
+static inline bool op_is_list_op(int op_type);
+static inline bool op_is_list_cdt_op(int op_type);
+static inline bool op_is_bit_op(int op_type);
+static inline bool op_is_hll_op(int op_type);
+static inline bool op_accepts_list_policy(int op_type);
 
 /* Map op helpers */
 static inline bool map_op_requires_key(int op_type);
@@ -37,9 +46,23 @@ static inline bool map_op_requires_index(int op_type);
 static inline bool map_op_requires_count(int op_type);
 static inline bool map_op_requires_range_end(int op_type);
 
+/* Rank, value and return type list op helpers */
+static inline bool list_op_requires_index(int op_type);
+static inline bool list_op_requires_rank(int op_type);
+static inline bool list_op_requires_count(int op_type);
+static inline bool list_op_requires_val(int op_type);
+static inline bool list_op_requires_return_type(int op_type);
+
 static as_status add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
-		as_operations* ops, as_error* err, int serializer_type);
-static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, as_error* err, int serializer_type);
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type);
+static as_status add_list_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type);
+static as_status add_bit_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type);
+static as_status add_hll_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type);
+static as_status add_ctx_op_to_operations(HashTable* op_array, as_operations* ops, as_cdt_ctx* ctx,
+		as_error* err, int serializer_type);
 
 static as_status get_count_from_op_hash(as_error* err, HashTable* op_hash, uint64_t* count);
 static as_status get_rank_from_op_hash(as_error* err, HashTable* op_hash, int64_t* rank);
@@ -48,7 +71,13 @@ static as_status get_key_from_op_hash(as_error* err, HashTable* op_hash, as_val*
 static as_status get_value_from_op_hash(as_error* err, HashTable* op_hash, as_val** val, int serializer_type);
 static as_status get_range_end_from_op_hash(as_error* err, HashTable* op_hash, as_val** range_end, int serializer_type);
 static as_status get_map_policy_from_op_hash(as_error* err, HashTable* op_hash, as_map_policy* map_policy_p);
-static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash, as_map_return_type* return_type);
+static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash, int* return_type);
+static as_status get_list_policy_from_op_hash(as_error* err, HashTable* op_hash, as_list_policy* list_policy_p);
+static as_status get_long_from_op_hash(as_error* err, HashTable* op_hash, const char* name, bool required, int64_t* value);
+static as_status get_bit_policy_from_op_hash(as_error* err, HashTable* op_hash, as_bit_policy* bit_policy_p);
+static as_status get_hll_policy_from_op_hash(as_error* err, HashTable* op_hash, as_hll_policy* hll_policy_p);
+static as_status get_hll_list_from_op_hash(as_error* err, HashTable* op_hash, bool hll_values, as_list** list,
+		int serializer_type);
 
 #define AS_MAP_POLICY_KEY "map_policy"
 #define AS_MAP_RANK_KEY "rank"
@@ -58,9 +87,23 @@ static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash,
 #define AS_MAP_RETURN_TYPE_KEY "return_type"
 #define AS_MAP_VALUE_KEY "val"
 #define AS_MAP_RANGE_END "range_end"
-
-
-/* {{{ proto int Aerospike::operate( array key, array operations [,array &returned [,array options ]] )
+#define AS_CDT_CTX_KEY "ctx"
+#define AS_LIST_POLICY_KEY "list_policy"
+#define AS_LIST_SORT_FLAGS_KEY "sort_flags"
+#define AS_BIT_POLICY_KEY "bit_policy"
+#define AS_BIT_OFFSET_KEY "bit_offset"
+#define AS_BIT_SIZE_KEY "bit_size"
+#define AS_BYTE_OFFSET_KEY "byte_offset"
+#define AS_BYTE_SIZE_KEY "byte_size"
+#define AS_BIT_SIGNED_KEY "signed"
+#define AS_BIT_OVERFLOW_ACTION_KEY "overflow_action"
+#define AS_BIT_RESIZE_FLAGS_KEY "resize_flags"
+#define AS_HLL_POLICY_KEY "hll_policy"
+#define AS_HLL_INDEX_BIT_COUNT_KEY "index_bit_count"
+#define AS_HLL_MINHASH_BIT_COUNT_KEY "minhash_bit_count"
+
+
+/* {{{ proto int Aerospike::operate( array key, array|Aerospike\Operations operations [,array &returned [,array options ]] )
     Performs multiple operation on a record */
 PHP_METHOD(Aerospike, operate) {
 	as_error err;
@@ -68,7 +111,7 @@ PHP_METHOD(Aerospike, operate) {
 	as_policy_operate operate_policy;
 	as_policy_operate* operate_policy_p = NULL;
 	zval* z_operate_policy = NULL;
-	HashTable* z_ops = NULL;
+	zval* z_ops = NULL;
 	HashTable* z_key = NULL;
 	as_key key;
 	zval* retval = NULL;
@@ -78,15 +121,21 @@ PHP_METHOD(Aerospike, operate) {
 	bool key_initialized = false;
 	bool operations_initialized = false;
 	as_record* rec = NULL;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 
 	as_error_init(&err);
 	reset_client_error(getThis());
 
-	if(zend_parse_parameters(ZEND_NUM_ARGS(), "hh|z/z", &z_key, &z_ops, &retval, &z_operate_policy) == FAILURE) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 4)
+		Z_PARAM_ARRAY_HT(z_key)
+		Z_PARAM_ZVAL(z_ops)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL_EX(retval, 0, 1)
+		Z_PARAM_ZVAL(z_operate_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid Parameters for operate", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 	if (retval) {
 		zval_dtor(retval);
 		ZVAL_NULL(retval);
@@ -99,6 +148,7 @@ PHP_METHOD(Aerospike, operate) {
 		RETURN_LONG(AEROSPIKE_ERR_CLIENT);
 	}
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (!php_client->is_connected) {
 		update_client_error(getThis(), AEROSPIKE_ERR_CLUSTER, "No connection to Aerospike server", false);
@@ -112,7 +162,7 @@ PHP_METHOD(Aerospike, operate) {
 	key_initialized = true;
 
 	if(zval_to_as_policy_operate(z_operate_policy, &operate_policy,
-			&operate_policy_p, &as_client->config.policies.operate) != AEROSPIKE_OK) {
+			&operate_policy_p, &get_key_policies(php_client, z_key)->operate, php_client) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
 		err.code = AEROSPIKE_ERR_PARAM;
 		goto CLEANUP;
@@ -120,7 +170,7 @@ PHP_METHOD(Aerospike, operate) {
 		operate_policy_p = &operate_policy;
 	}
 
-	operations_size = zend_hash_num_elements(z_ops);
+	operations_size = as_php_operations_count(z_ops);
 	if (!operations_size) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Empty operations array");
 		goto CLEANUP;
@@ -130,66 +180,149 @@ PHP_METHOD(Aerospike, operate) {
 	as_operations_inita(&ops, operations_size);
 	operations_initialized = true;
 
-	if (set_operations_generation_from_operate_policy(&ops, z_operate_policy) != AEROSPIKE_OK) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
+	if (zval_to_as_operations(z_ops, z_operate_policy, &ops, &err, serializer_type) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
-	if (set_operations_ttl_from_operate_policy(&ops, z_operate_policy) != AEROSPIKE_OK) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
+	aerospike_key_operate(as_client, &err, operate_policy_p, &key, &ops, &rec);
+	deliver_pending_log_events();
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 		goto CLEANUP;
 	}
 
-	if (!hashtable_is_list(z_ops)) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Operations array must be a list");
-		goto CLEANUP;
+	if (retval) {
+		as_bins_to_zval(rec, retval, &err);
+	}
+
+CLEANUP:
+	if (key_initialized) {
+		as_key_destroy(&key);
+	}
+	if (operations_initialized) {
+		as_operations_destroy(&ops);
+	}
+	if (rec) {
+		as_record_destroy(rec);
+	}
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
 
+/*
+ * Load a php list of operations, and the generation and ttl of the operate policy, into ops.
+ * ops must already be initialized with room for every operation.
+ */
+as_status z_hashtable_to_as_operations(HashTable* z_ops, zval* z_operate_policy, as_operations* ops,
+		as_error* err, int serializer_type) {
 	zval* current_op = NULL;
 
+	if (set_operations_generation_from_operate_policy(ops, z_operate_policy) != AEROSPIKE_OK) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
+		return err->code;
+	}
+
+	if (set_operations_ttl_from_operate_policy(ops, z_operate_policy) != AEROSPIKE_OK) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
+		return err->code;
+	}
+
+	if (!hashtable_is_list(z_ops)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Operations array must be a list");
+		return err->code;
+	}
+
 	ZEND_HASH_FOREACH_VAL(z_ops, current_op)
 	{
 
 		if (Z_TYPE_P(current_op) != IS_ARRAY) {
-			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Operation must be an array");
-			goto CLEANUP;
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must be an array");
+			return err->code;
 		}
 
-		if (add_op_to_operations(Z_ARRVAL_P(current_op), &ops, &err, serializer_type) != AEROSPIKE_OK) {
-			as_error_update(&err, err.code, NULL);
-			goto CLEANUP;
+		if (add_op_to_operations(Z_ARRVAL_P(current_op), ops, err, serializer_type) != AEROSPIKE_OK) {
+			as_error_update(err, err->code, NULL);
+			return err->code;
 		}
 
 	}ZEND_HASH_FOREACH_END();
 
-	if (aerospike_key_operate(as_client, &err, operate_policy_p, &key, &ops, &rec) != AEROSPIKE_OK) {
-		update_client_error(getThis(), err.code, err.message, err.in_doubt);
-		goto CLEANUP;
+	return AEROSPIKE_OK;
+}
+
+static inline bool operator_is_read(as_operator op) {
+	switch (op) {
+		case AS_OPERATOR_READ:
+		case AS_OPERATOR_CDT_READ:
+		case AS_OPERATOR_MAP_READ:
+		case AS_OPERATOR_BIT_READ:
+		case AS_OPERATOR_HLL_READ:
+		case AS_OPERATOR_EXP_READ:
+			return true;
+		default:
+			return false;
 	}
+}
 
-	if (retval) {
-		as_bins_to_zval(rec, retval, &err);
+/* Whether none of the operations reads a bin, as required by background scans and queries */
+bool as_php_operations_write_only(const as_operations* ops) {
+	for (uint16_t i = 0; i < ops->binops.size; i++) {
+		if (operator_is_read(ops->binops.entries[i].op)) {
+			return false;
+		}
 	}
+	return true;
+}
 
-CLEANUP:
-	if (key_initialized) {
-		as_key_destroy(&key);
+/*
+ * Load the OPT_READ_OPERATIONS of a scan or query, in the format of operate(), into *ops. Each record
+ * then carries the results of the operations instead of its bins. *ops is left NULL without the option.
+ * serializer_type is the one of the client, OPT_SERIALIZER overrides it.
+ */
+as_status set_read_operations_from_policy_hash(as_operations** ops, zval* z_policy, as_error* err,
+		int serializer_type) {
+	zval* z_ops = NULL;
+
+	*ops = NULL;
+	z_policy = as_php_policy_options(z_policy);
+	if (!z_policy || Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_OK;
 	}
-	if (operations_initialized) {
-		as_operations_destroy(&ops);
+
+	z_ops = zend_hash_index_find(Z_ARRVAL_P(z_policy), OPT_READ_OPERATIONS);
+	if (!z_ops) {
+		return AEROSPIKE_OK;
 	}
-	if (rec) {
-		as_record_destroy(rec);
+	if (Z_TYPE_P(z_ops) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(z_ops))) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "OPT_READ_OPERATIONS must be an array of operations");
 	}
-	if (err.code != AEROSPIKE_OK) {
-		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	set_serializer_from_policy_hash(&serializer_type, z_policy);
+
+	*ops = as_operations_new(zend_hash_num_elements(Z_ARRVAL_P(z_ops)));
+	if (z_hashtable_to_as_operations(Z_ARRVAL_P(z_ops), NULL, *ops, err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	for (uint16_t i = 0; i < (*ops)->binops.size; i++) {
+		if (!operator_is_read((*ops)->binops.entries[i].op)) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "OPT_READ_OPERATIONS only accepts read operations");
+			goto CLEANUP;
+		}
 	}
-	RETURN_LONG(err.code);
-}
-/* }}} */
 
+CLEANUP:
+	if (err->code != AEROSPIKE_OK) {
+		as_operations_destroy(*ops);
+		*ops = NULL;
+	}
+	return err->code;
+}
 
-/* {{{ proto int Aerospike::operateOrdered( array key, array operations [,array &returned [,array options ]] )
+/* {{{ proto int Aerospike::operateOrdered( array key, array|Aerospike\Operations operations [,array &returned [,array options ]] )
    Performs multiple operation on a record */
 PHP_METHOD(Aerospike, operateOrdered) {
 	as_error err;
@@ -197,7 +330,7 @@ PHP_METHOD(Aerospike, operateOrdered) {
 	as_policy_operate operate_policy;
 	as_policy_operate* operate_policy_p = NULL;
 	zval* z_operate_policy = NULL;
-	HashTable* z_ops = NULL;
+	zval* z_ops = NULL;
 	HashTable* z_key = NULL;
 	as_key key;
 	zval* retval = NULL;
@@ -207,15 +340,21 @@ PHP_METHOD(Aerospike, operateOrdered) {
 	bool key_initialized = false;
 	bool operations_initialized = false;
 	as_record* rec = NULL;
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 
 	as_error_init(&err);
 	reset_client_error(getThis());
 
-	if(zend_parse_parameters(ZEND_NUM_ARGS(), "hh|z/z", &z_key, &z_ops, &retval, &z_operate_policy) == FAILURE) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 4)
+		Z_PARAM_ARRAY_HT(z_key)
+		Z_PARAM_ZVAL(z_ops)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL_EX(retval, 0, 1)
+		Z_PARAM_ZVAL(z_operate_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid Parameters for operateOrdered", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 	if (retval) {
 		zval_dtor(retval);
 		ZVAL_NULL(retval);
@@ -228,6 +367,7 @@ PHP_METHOD(Aerospike, operateOrdered) {
 		RETURN_LONG(AEROSPIKE_ERR_CLIENT);
 	}
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (!php_client->is_connected) {
 		update_client_error(getThis(), AEROSPIKE_ERR_CLUSTER, "No connection to Aerospike server", false);
@@ -242,13 +382,13 @@ PHP_METHOD(Aerospike, operateOrdered) {
 
 	if (z_operate_policy){
 		if(zval_to_as_policy_operate(z_operate_policy, &operate_policy,
-				&operate_policy_p, &as_client->config.policies.operate) != AEROSPIKE_OK) {
+				&operate_policy_p, &get_key_policies(php_client, z_key)->operate, php_client) != AEROSPIKE_OK) {
 			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
 			goto CLEANUP;
 		}
 	}
 
-	operations_size = zend_hash_num_elements(z_ops);
+	operations_size = as_php_operations_count(z_ops);
 	if (!operations_size) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Empty operations array");
 		goto CLEANUP;
@@ -258,6 +398,14 @@ PHP_METHOD(Aerospike, operateOrdered) {
 	as_operations_inita(&ops, operations_size);
 	operations_initialized = true;
 
+	/* A compiled template is converted the same way as by operate() */
+	if (Z_TYPE_P(z_ops) != IS_ARRAY) {
+		if (zval_to_as_operations(z_ops, z_operate_policy, &ops, &err, serializer_type) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+		goto OPERATE;
+	}
+
 	if (set_operations_generation_from_operate_policy(&ops, z_operate_policy) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid generation policy");
 		err.code = AEROSPIKE_ERR_PARAM;
@@ -274,7 +422,7 @@ PHP_METHOD(Aerospike, operateOrdered) {
 	zval* current_op = NULL;
 	zend_string* string_key = NULL;
 
-	ZEND_HASH_FOREACH_STR_KEY_VAL(z_ops, string_key, current_op)
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(z_ops), string_key, current_op)
 	{
 		if (string_key) {
 			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Operations array must not have string keys");
@@ -295,7 +443,10 @@ PHP_METHOD(Aerospike, operateOrdered) {
 
 	}ZEND_HASH_FOREACH_END();
 
-	if (aerospike_key_operate(as_client, &err, operate_policy_p, &key, &ops, &rec) != AEROSPIKE_OK) {
+OPERATE:
+	aerospike_key_operate(as_client, &err, operate_policy_p, &key, &ops, &rec);
+	deliver_pending_log_events();
+	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 		goto CLEANUP;
 	}
@@ -328,7 +479,35 @@ CLEANUP:
  * the operations.
  * returns AEROSPIKE_OK on success, other status code on failure
  */
-static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, as_error* err, int serializer_type) {
+as_status add_op_to_operations(HashTable* op_array, as_operations* ops, as_error* err, int serializer_type) {
+	as_cdt_ctx ctx;
+	as_cdt_ctx* ctx_p = NULL;
+	as_status status = AEROSPIKE_OK;
+	zval* z_ctx = zend_hash_str_find(op_array, AS_CDT_CTX_KEY, strlen(AS_CDT_CTX_KEY));
+
+	if (z_ctx) {
+		if (Z_TYPE_P(z_ctx) != IS_ARRAY) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation ctx must be an array");
+			return AEROSPIKE_ERR_PARAM;
+		}
+		if (z_hashtable_to_as_cdt_ctx(Z_ARRVAL_P(z_ctx), &ctx, err, serializer_type) != AEROSPIKE_OK) {
+			return err->code;
+		}
+		ctx_p = &ctx;
+	}
+
+	status = add_ctx_op_to_operations(op_array, ops, ctx_p, err, serializer_type);
+
+	/* The ctx was packed into the operation as it was added */
+	if (ctx_p) {
+		as_cdt_ctx_destroy(ctx_p);
+	}
+	return status;
+}
+
+/* Add an operation on the bin, or with a ctx, on the nested list or map element it points to */
+static as_status add_ctx_op_to_operations(HashTable* op_array, as_operations* ops, as_cdt_ctx* ctx,
+		as_error* err, int serializer_type) {
 	int op_type;
 	long index;
 	zval* z_op = NULL;
@@ -337,6 +516,8 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 	zval* z_bin = NULL;
 	as_val* op_val = NULL;
 	char* bin_name = NULL;
+	as_list_policy list_policy;
+	as_list_policy* list_policy_p = NULL;
 
 	z_op = zend_hash_str_find(op_array, "op", strlen("op"));
 
@@ -350,6 +531,11 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 	}
 	op_type = Z_LVAL_P(z_op);
 
+	if (ctx && !op_is_list_op(op_type) && !op_is_map_op(op_type) && !op_is_bit_op(op_type) && !op_is_hll_op(op_type)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Only list, map, bit and HLL operations accept a ctx");
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	//handle touch differently since it is unique
 	if (op_type == AS_OPERATOR_TOUCH) {
 		z_op_val = zend_hash_str_find(op_array, "ttl", strlen("ttl"));
@@ -392,7 +578,30 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 
 	/* If it's a map operation, use the map op helper function */
 	if (op_is_map_op(op_type)) {
-		return add_map_op_to_operations(op_array, op_type, bin_name, ops, err, serializer_type);
+		return add_map_op_to_operations(op_array, op_type, bin_name, ops, ctx, err, serializer_type);
+	}
+
+	/* So do the rank, value and return type list operations */
+	if (op_is_list_cdt_op(op_type)) {
+		return add_list_op_to_operations(op_array, op_type, bin_name, ops, ctx, err, serializer_type);
+	}
+
+	/* and the operations on the bits of a bytes bin */
+	if (op_is_bit_op(op_type)) {
+		return add_bit_op_to_operations(op_array, op_type, bin_name, ops, ctx, err, serializer_type);
+	}
+
+	/* and the HyperLogLog operations */
+	if (op_is_hll_op(op_type)) {
+		return add_hll_op_to_operations(op_array, op_type, bin_name, ops, ctx, err, serializer_type);
+	}
+
+	/* An ordered list, or write flags, for the list write operations */
+	if (op_accepts_list_policy(op_type) && zend_hash_str_exists(op_array, AS_LIST_POLICY_KEY, strlen(AS_LIST_POLICY_KEY))) {
+		if (get_list_policy_from_op_hash(err, op_array, &list_policy) != AEROSPIKE_OK) {
+			return err->code;
+		}
+		list_policy_p = &list_policy;
 	}
 
 	/*
@@ -416,7 +625,10 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 				return AEROSPIKE_ERR_PARAM;
 			}
 		}
-		if (op_requires_as_val(op_type)) {
+		if (op_type == AS_OPERATOR_WRITE && Z_TYPE_P(z_op_val) == IS_NULL) {
+			/* Writing null removes the bin */
+			op_val = (as_val*)&as_nil;
+		} else if (op_requires_as_val(op_type)) {
 			zval_to_as_val(z_op_val, &op_val, err, serializer_type);
 			if (!op_val || err->code != AEROSPIKE_OK) {
 				as_error_update(err, AEROSPIKE_ERR_PARAM, "Unable to convert value");
@@ -513,7 +725,7 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
         }
 		/** Start of list operations **/
 		case OP_LIST_APPEND: {
-			if (!as_operations_add_list_append(ops, bin_name, op_val)) {
+			if (!as_operations_list_append(ops, bin_name, ctx, list_policy_p, op_val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -532,14 +744,14 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 				return err->code;
 			}
 
-			if (!as_operations_add_list_append_items(ops, bin_name, op_list)) {
+			if (!as_operations_list_append_items(ops, bin_name, ctx, list_policy_p, op_list)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_INSERT: {
-			if(!as_operations_add_list_insert(ops, bin_name, index, op_val)) {
+			if(!as_operations_list_insert(ops, bin_name, ctx, list_policy_p, index, op_val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -556,14 +768,14 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 				return err->code;
 			}
 
-			if (!as_operations_add_list_insert_items(ops, bin_name, index, (as_list*)op_list)) {
+			if (!as_operations_list_insert_items(ops, bin_name, ctx, list_policy_p, index, (as_list*)op_list)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_POP: {
-			if(!as_operations_add_list_pop(ops, bin_name, index)) {
+			if(!as_operations_list_pop(ops, bin_name, ctx, index)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -571,14 +783,14 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 		}
 		case OP_LIST_POP_RANGE: {
 			long count = Z_LVAL_P(z_op_val);
-			if(!as_operations_add_list_pop_range(ops, bin_name, index, count)) {
+			if(!as_operations_list_pop_range(ops, bin_name, ctx, index, count)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_REMOVE: {
-			if(!as_operations_add_list_remove(ops, bin_name, index)) {
+			if(!as_operations_list_remove(ops, bin_name, ctx, index)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -586,28 +798,28 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 		}
 		case OP_LIST_REMOVE_RANGE: {
 			long count = Z_LVAL_P(z_op_val);
-			if(!as_operations_add_list_remove_range(ops, bin_name, index, count)) {
+			if(!as_operations_list_remove_range(ops, bin_name, ctx, index, count)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_CLEAR: {
-			if(!as_operations_add_list_clear(ops, bin_name)) {
+			if(!as_operations_list_clear(ops, bin_name, ctx)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_SET: {
-			if(!as_operations_add_list_set(ops, bin_name, index, op_val)) {
+			if(!as_operations_list_set(ops, bin_name, ctx, list_policy_p, index, op_val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_GET: {
-			if(!as_operations_add_list_get(ops, bin_name, index)) {
+			if(!as_operations_list_get(ops, bin_name, ctx, index)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -615,7 +827,7 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 		}
 		case OP_LIST_GET_RANGE: {
 			long count = Z_LVAL_P(z_op_val);
-			if(!as_operations_add_list_get_range(ops, bin_name, index, count)) {
+			if(!as_operations_list_get_range(ops, bin_name, ctx, index, count)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -623,14 +835,14 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 		}
 		case OP_LIST_TRIM: {
 			long count = Z_LVAL_P(z_op_val);
-			if(!as_operations_add_list_trim(ops, bin_name, index, count)) {
+			if(!as_operations_list_trim(ops, bin_name, ctx, index, count)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
 			break;
 		}
 		case OP_LIST_SIZE: {
-			if(!as_operations_add_list_size(ops, bin_name)) {
+			if(!as_operations_list_size(ops, bin_name, ctx)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to add operation");
 				return AEROSPIKE_ERR_CLIENT;
 			}
@@ -650,7 +862,7 @@ static as_status add_op_to_operations(HashTable* op_array, as_operations* ops, a
 
 static as_status
 add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
-		as_operations* ops, as_error* err, int serializer_type) {
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type) {
 	uint64_t count;
 	int64_t index;
 	int64_t rank;
@@ -658,7 +870,7 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 	as_val* val = NULL;
 	as_val* key = NULL;
 	as_map_policy map_policy;
-	as_map_return_type return_type;
+	int return_type;
 
 	if (map_op_requires_count(op_type)) {
 		if (get_count_from_op_hash(err, op_array, &count) != AEROSPIKE_OK) {
@@ -712,13 +924,13 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 
 		/* 1 */
 		case OP_MAP_SET_POLICY:
-			if (!as_operations_add_map_set_policy(ops, bin_name, &map_policy)) {
+			if (!as_operations_map_set_policy(ops, bin_name, ctx, &map_policy)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_SET_POLICY operation");
 			}
 			break;
 		/* 2 */
 		case OP_MAP_PUT:
-			if (!as_operations_add_map_put(ops, bin_name, &map_policy, key, val)) {
+			if (!as_operations_map_put(ops, bin_name, ctx, &map_policy, key, val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_PUT operation");
 			}
 			break;
@@ -735,7 +947,7 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 				as_error_update(err, AEROSPIKE_ERR_PARAM, "Failed to store map put items");
 				goto CLEANUP;
 			}
-			if (!as_operations_add_map_put_items(ops, bin_name, &map_policy, map)) {
+			if (!as_operations_map_put_items(ops, bin_name, ctx, &map_policy, map)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_PUT_ITEMS operation");
 			}
 			break;
@@ -743,35 +955,35 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 
 		/* 4 */
 		case OP_MAP_INCREMENT:
-			if (!as_operations_add_map_increment(ops, bin_name, &map_policy, key, val)) {
+			if (!as_operations_map_increment(ops, bin_name, ctx, &map_policy, key, val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_INCREMENT operation");
 			}
 			break;
 
 		/* 5 */
 		case OP_MAP_DECREMENT:
-			if (!as_operations_add_map_decrement(ops, bin_name, &map_policy, key, val)) {
+			if (!as_operations_map_decrement(ops, bin_name, ctx, &map_policy, key, val)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_INCREMENT operation");
 			}
 			break;
 
 		/* 6 */
 		case OP_MAP_SIZE:
-			if (!as_operations_add_map_size(ops, bin_name)) {
+			if (!as_operations_map_size(ops, bin_name, ctx)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_SIZE operation");
 			}
 			break;
 
 		/* 7 */
 		case OP_MAP_CLEAR:
-			if (!as_operations_add_map_clear(ops, bin_name)) {
+			if (!as_operations_map_clear(ops, bin_name, ctx)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_CLEAR operation");
 			}
 			break;
 
 		/* 8 */
 		case OP_MAP_REMOVE_BY_KEY:
-			if (!as_operations_add_map_remove_by_key(ops, bin_name, key, return_type)) {
+			if (!as_operations_map_remove_by_key(ops, bin_name, ctx, key, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_KEY operation");
 			}
 			break;
@@ -789,7 +1001,7 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to store key list for remove by key list");
 				goto CLEANUP;
 			}
-			if (!as_operations_add_map_remove_by_key_list(ops, bin_name, key_list, return_type)) {
+			if (!as_operations_map_remove_by_key_list(ops, bin_name, ctx, key_list, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_KEY_LIST operation");
 			}
 
@@ -798,14 +1010,14 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 
 		/* 10 */
 		case OP_MAP_REMOVE_BY_KEY_RANGE:
-			if (!as_operations_add_map_remove_by_key_range(ops, bin_name, key, range_end, return_type)) {
+			if (!as_operations_map_remove_by_key_range(ops, bin_name, ctx, key, range_end, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_KEY_RANGE operation");
 			}
 			break;
 
 		/* 11 */
 		case OP_MAP_REMOVE_BY_VALUE:
-			if (!as_operations_add_map_remove_by_value(ops, bin_name, val, return_type)) {
+			if (!as_operations_map_remove_by_value(ops, bin_name, ctx, val, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_VALUE operation");
 			}
 			break;
@@ -823,7 +1035,7 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to store key list for remove by value list");
 				goto CLEANUP;
 			}
-			if (!as_operations_add_map_remove_by_value_list(ops, bin_name, val_list, return_type)) {
+			if (!as_operations_map_remove_by_value_list(ops, bin_name, ctx, val_list, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_VALUE_LIST operation");
 			}
 			break;
@@ -831,94 +1043,114 @@ add_map_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
 
 		/* 13 */
 		case OP_MAP_REMOVE_BY_VALUE_RANGE:
-			if (!as_operations_add_map_remove_by_value_range(ops, bin_name, val, range_end, return_type)) {
+			if (!as_operations_map_remove_by_value_range(ops, bin_name, ctx, val, range_end, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_VALUE_RANGE operation");
 			}
 			break;
 
 		/* 14 */
 		case OP_MAP_REMOVE_BY_INDEX:
-			if (!as_operations_add_map_remove_by_index(ops, bin_name, index, return_type)) {
+			if (!as_operations_map_remove_by_index(ops, bin_name, ctx, index, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_INDEX operation");
 			}
 			break;
 
 		/* 15 */
 		case OP_MAP_REMOVE_BY_INDEX_RANGE:
-			if (!as_operations_add_map_remove_by_index_range(ops, bin_name, index, count, return_type)) {
+			if (!as_operations_map_remove_by_index_range(ops, bin_name, ctx, index, count, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_INDEX_RANGE operation");
 			}
 			break;
 
 		/* 16 */
 		case OP_MAP_REMOVE_BY_RANK:
-			if (!as_operations_add_map_remove_by_rank(ops, bin_name, rank, return_type)) {
+			if (!as_operations_map_remove_by_rank(ops, bin_name, ctx, rank, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_RANK operation");
 			}
 			break;
 
 		/* 17 */
 		case OP_MAP_REMOVE_BY_RANK_RANGE:
-			if (!as_operations_add_map_remove_by_rank_range(ops, bin_name, rank, count, return_type)) {
+			if (!as_operations_map_remove_by_rank_range(ops, bin_name, ctx, rank, count, return_type)) {
 				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_REMOVE_BY_RANK_RANGE operation");
 			}
 			break;
 
 		/* 18 */
 		case OP_MAP_GET_BY_KEY:
-			if (!as_operations_add_map_get_by_key(ops, bin_name, key, return_type)) {
+			if (!as_operations_map_get_by_key(ops, bin_name, ctx, key, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_KEY operation");
 			}
 			break;
 
 		/* 19 */
 		case OP_MAP_GET_BY_KEY_RANGE:
-			if (!as_operations_add_map_get_by_key_range(ops, bin_name, key, range_end, return_type)) {
+			if (!as_operations_map_get_by_key_range(ops, bin_name, ctx, key, range_end, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_KEY_RANGE operation");
 			}
 			break;
 
 		/* 20 */
 		case OP_MAP_GET_BY_VALUE:
-			if (!as_operations_add_map_get_by_value(ops, bin_name, val, return_type)) {
+			if (!as_operations_map_get_by_value(ops, bin_name, ctx, val, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_VALUE operation");
 			}
 			break;
 
 		/* 21 */
 		case OP_MAP_GET_BY_VALUE_RANGE:
-			if (!as_operations_add_map_get_by_value_range(ops, bin_name, val, range_end, return_type)) {
+			if (!as_operations_map_get_by_value_range(ops, bin_name, ctx, val, range_end, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_VALUE_RANGE operation");
 			}
 			break;
 
 		/* 22 */
 		case OP_MAP_GET_BY_INDEX:
-			if (!as_operations_add_map_get_by_index(ops, bin_name, index, return_type)) {
+			if (!as_operations_map_get_by_index(ops, bin_name, ctx, index, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_INDEX operation");
 			}
 			break;
 
 		/* 23 */
 		case OP_MAP_GET_BY_INDEX_RANGE:
-			if (!as_operations_add_map_get_by_index_range(ops, bin_name, index, count, return_type)) {
+			if (!as_operations_map_get_by_index_range(ops, bin_name, ctx, index, count, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_INDEX_RANGE operation");
 			}
 			break;
 
 		/* 24 */
 		case OP_MAP_GET_BY_RANK:
-			if (!as_operations_add_map_get_by_rank(ops, bin_name, rank, return_type)) {
+			if (!as_operations_map_get_by_rank(ops, bin_name, ctx, rank, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_RANK operation");
 			}
 			break;
 
 		/* 25 */
 		case OP_MAP_GET_BY_RANK_RANGE:
-			if (!as_operations_add_map_get_by_rank_range(ops, bin_name, rank, count, return_type)) {
+			if (!as_operations_map_get_by_rank_range(ops, bin_name, ctx, rank, count, return_type)) {
 				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_RANK_RANGE operation");
 			}
 			break;
+
+		case OP_MAP_GET_BY_KEY_LIST:
+			if (as_val_type(key) != AS_LIST) {
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "list of keys must be an array");
+				goto CLEANUP;
+			}
+			if (!as_operations_map_get_by_key_list(ops, bin_name, ctx, as_list_fromval(key), return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_KEY_LIST operation");
+			}
+			break;
+
+		case OP_MAP_GET_BY_VALUE_LIST:
+			if (as_val_type(val) != AS_LIST) {
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "list of values must be an array");
+				goto CLEANUP;
+			}
+			if (!as_operations_map_get_by_value_list(ops, bin_name, ctx, as_list_fromval(val), return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_MAP_GET_BY_VALUE_LIST operation");
+			}
+			break;
 		default:
 			as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown map operation");
 			break;
@@ -946,6 +1178,484 @@ CLEANUP:
 
 }
 
+/*
+ * Add one of the list operations working on ranks, values and index ranges, which like the map
+ * operations select elements and take a return_type.
+ */
+static as_status
+add_list_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type) {
+	uint64_t count;
+	int64_t index;
+	int64_t rank;
+	int return_type;
+	long sort_flags = AS_LIST_SORT_DEFAULT;
+	zval* z_sort_flags = NULL;
+	as_val* val = NULL;
+	as_val* range_end = NULL;
+	as_list_policy list_policy;
+	as_list_policy* list_policy_p = NULL;
+
+	if (list_op_requires_index(op_type)) {
+		if (get_index_from_op_hash(err, op_array, &index) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	if (list_op_requires_rank(op_type)) {
+		if (get_rank_from_op_hash(err, op_array, &rank) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	if (list_op_requires_count(op_type)) {
+		if (get_count_from_op_hash(err, op_array, &count) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	if (list_op_requires_return_type(op_type)) {
+		if (get_return_type_from_op_hash(err, op_array, &return_type) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	}
+
+	/* Required to set the order, optional for an increment */
+	if (op_type == OP_LIST_SET_ORDER ||
+			zend_hash_str_exists(op_array, AS_LIST_POLICY_KEY, strlen(AS_LIST_POLICY_KEY))) {
+		if (get_list_policy_from_op_hash(err, op_array, &list_policy) != AEROSPIKE_OK) {
+			return err->code;
+		}
+		list_policy_p = &list_policy;
+	}
+
+	if (op_type == OP_LIST_SORT) {
+		z_sort_flags = zend_hash_str_find(op_array, AS_LIST_SORT_FLAGS_KEY, strlen(AS_LIST_SORT_FLAGS_KEY));
+		if (z_sort_flags) {
+			if (Z_TYPE_P(z_sort_flags) != IS_LONG) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "sort_flags must be a long");
+			}
+			sort_flags = Z_LVAL_P(z_sort_flags);
+		}
+	}
+
+	if (list_op_requires_val(op_type)) {
+		if (get_value_from_op_hash(err, op_array, &val, serializer_type) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	/* A value range without an end runs to the largest value */
+	if ((op_type == OP_LIST_GET_BY_VALUE_RANGE || op_type == OP_LIST_REMOVE_BY_VALUE_RANGE) &&
+			zend_hash_str_exists(op_array, AS_MAP_RANGE_END, strlen(AS_MAP_RANGE_END))) {
+		if (get_range_end_from_op_hash(err, op_array, &range_end, serializer_type) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	if ((op_type == OP_LIST_GET_BY_VALUE_LIST || op_type == OP_LIST_REMOVE_BY_VALUE_LIST) &&
+			as_val_type(val) != AS_LIST) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "list of values must be an array");
+		goto CLEANUP;
+	}
+
+	switch(op_type) {
+		case OP_LIST_SET_ORDER:
+			if (!as_operations_list_set_order(ops, bin_name, ctx, list_policy.order)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_SET_ORDER operation");
+			}
+			break;
+
+		case OP_LIST_SORT:
+			if (!as_operations_list_sort(ops, bin_name, ctx, (as_list_sort_flags)sort_flags)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_SORT operation");
+			}
+			break;
+
+		case OP_LIST_INCREMENT:
+			if (!as_operations_list_increment(ops, bin_name, ctx, list_policy_p, index, val)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_INCREMENT operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_INDEX:
+			if (!as_operations_list_get_by_index(ops, bin_name, ctx, index, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_INDEX operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_INDEX_RANGE:
+			if (!as_operations_list_get_by_index_range(ops, bin_name, ctx, index, count, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_INDEX_RANGE operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_RANK:
+			if (!as_operations_list_get_by_rank(ops, bin_name, ctx, rank, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_RANK operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_RANK_RANGE:
+			if (!as_operations_list_get_by_rank_range(ops, bin_name, ctx, rank, count, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_RANK_RANGE operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_VALUE:
+			if (!as_operations_list_get_by_value(ops, bin_name, ctx, val, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_VALUE operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_VALUE_LIST:
+			if (!as_operations_list_get_by_value_list(ops, bin_name, ctx, as_list_fromval(val), return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_VALUE_LIST operation");
+			}
+			break;
+
+		case OP_LIST_GET_BY_VALUE_RANGE:
+			if (!as_operations_list_get_by_value_range(ops, bin_name, ctx, val, range_end, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_GET_BY_VALUE_RANGE operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_INDEX:
+			if (!as_operations_list_remove_by_index(ops, bin_name, ctx, index, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_INDEX operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_INDEX_RANGE:
+			if (!as_operations_list_remove_by_index_range(ops, bin_name, ctx, index, count, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_INDEX_RANGE operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_RANK:
+			if (!as_operations_list_remove_by_rank(ops, bin_name, ctx, rank, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_RANK operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_RANK_RANGE:
+			if (!as_operations_list_remove_by_rank_range(ops, bin_name, ctx, rank, count, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_RANK_RANGE operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_VALUE:
+			if (!as_operations_list_remove_by_value(ops, bin_name, ctx, val, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_VALUE operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_VALUE_LIST:
+			if (!as_operations_list_remove_by_value_list(ops, bin_name, ctx, as_list_fromval(val), return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_VALUE_LIST operation");
+			}
+			break;
+
+		case OP_LIST_REMOVE_BY_VALUE_RANGE:
+			if (!as_operations_list_remove_by_value_range(ops, bin_name, ctx, val, range_end, return_type)) {
+				as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add OP_LIST_REMOVE_BY_VALUE_RANGE operation");
+			}
+			break;
+
+		default:
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown list operation");
+			break;
+	}
+
+CLEANUP:
+	if (err->code != AEROSPIKE_OK) {
+		if (range_end) {
+			as_val_destroy(range_end);
+		}
+		if (val) {
+			as_val_destroy(val);
+		}
+	}
+	return err->code;
+}
+
+/*
+ * Add an operation on the bits of a bytes bin. Offsets and sizes are in bits, apart from those of
+ * resize, insert and remove which work on whole bytes. A value to write may be an Aerospike\Bytes
+ * or a string, its bytes are copied into the operation.
+ */
+static as_status
+add_bit_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type) {
+	int64_t bit_offset = 0;
+	int64_t bit_size = 0;
+	int64_t byte_offset = 0;
+	int64_t byte_size = 0;
+	int64_t resize_flags = AS_BIT_RESIZE_DEFAULT;
+	int64_t overflow_action = AS_BIT_OVERFLOW_FAIL;
+	int64_t int_val = 0;
+	bool is_signed = false;
+	zval* z_val = NULL;
+	zval* z_signed = NULL;
+	as_val* val = NULL;
+	uint8_t* bytes = NULL;
+	uint32_t bytes_size = 0;
+	as_bit_policy bit_policy;
+	bool added = false;
+
+	if (get_bit_policy_from_op_hash(err, op_array, &bit_policy) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	if (op_type == OP_BIT_RESIZE || op_type == OP_BIT_INSERT || op_type == OP_BIT_REMOVE) {
+		if (get_long_from_op_hash(err, op_array, AS_BYTE_OFFSET_KEY, op_type != OP_BIT_RESIZE, &byte_offset) != AEROSPIKE_OK ||
+				get_long_from_op_hash(err, op_array, AS_BYTE_SIZE_KEY, op_type != OP_BIT_INSERT, &byte_size) != AEROSPIKE_OK ||
+				get_long_from_op_hash(err, op_array, AS_BIT_RESIZE_FLAGS_KEY, false, &resize_flags) != AEROSPIKE_OK) {
+			return err->code;
+		}
+	} else {
+		if (get_long_from_op_hash(err, op_array, AS_BIT_OFFSET_KEY, true, &bit_offset) != AEROSPIKE_OK ||
+				get_long_from_op_hash(err, op_array, AS_BIT_SIZE_KEY, true, &bit_size) != AEROSPIKE_OK) {
+			return err->code;
+		}
+		if (bit_size < 0) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "bit_size must not be negative");
+		}
+	}
+
+	if (byte_size < 0) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "byte_size must not be negative");
+	}
+
+	z_signed = zend_hash_str_find(op_array, AS_BIT_SIGNED_KEY, strlen(AS_BIT_SIGNED_KEY));
+	if (z_signed) {
+		is_signed = zend_is_true(z_signed);
+	}
+
+	if (get_long_from_op_hash(err, op_array, AS_BIT_OVERFLOW_ACTION_KEY, false, &overflow_action) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	z_val = zend_hash_str_find(op_array, AS_MAP_VALUE_KEY, strlen(AS_MAP_VALUE_KEY));
+	switch (op_type) {
+		/* Bytes values */
+		case OP_BIT_INSERT:
+		case OP_BIT_SET:
+		case OP_BIT_OR:
+		case OP_BIT_XOR:
+		case OP_BIT_AND:
+			if (!z_val || zval_to_as_val(z_val, &val, err, serializer_type) != AEROSPIKE_OK || !val) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation requires a bytes val entry");
+			}
+			if (as_val_type(val) == AS_BYTES) {
+				bytes = as_bytes_get(as_bytes_fromval(val));
+				bytes_size = as_bytes_size(as_bytes_fromval(val));
+			} else if (as_val_type(val) == AS_STRING) {
+				bytes = (uint8_t*)as_string_get(as_string_fromval(val));
+				bytes_size = (uint32_t)as_string_len(as_string_fromval(val));
+			} else {
+				as_val_destroy(val);
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation val must be an Aerospike\\Bytes or a string");
+			}
+			break;
+		/* Integer values */
+		case OP_BIT_LSHIFT:
+		case OP_BIT_RSHIFT:
+		case OP_BIT_ADD:
+		case OP_BIT_SUBTRACT:
+		case OP_BIT_SET_INT:
+			if (!z_val || Z_TYPE_P(z_val) != IS_LONG) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation requires an integer val entry");
+			}
+			int_val = Z_LVAL_P(z_val);
+			break;
+		/* The bit value to look for */
+		case OP_BIT_LSCAN:
+		case OP_BIT_RSCAN:
+			if (!z_val) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation requires a val entry");
+			}
+			int_val = zend_is_true(z_val);
+			break;
+		default:
+			break;
+	}
+
+	switch (op_type) {
+		case OP_BIT_RESIZE:
+			added = as_operations_bit_resize(ops, bin_name, ctx, &bit_policy, (uint32_t)byte_size,
+					(as_bit_resize_flags)resize_flags);
+			break;
+		case OP_BIT_INSERT:
+			added = as_operations_bit_insert(ops, bin_name, ctx, &bit_policy, (int)byte_offset, bytes_size, bytes);
+			break;
+		case OP_BIT_REMOVE:
+			added = as_operations_bit_remove(ops, bin_name, ctx, &bit_policy, (int)byte_offset, (uint32_t)byte_size);
+			break;
+		case OP_BIT_SET:
+			added = as_operations_bit_set(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					bytes_size, bytes);
+			break;
+		case OP_BIT_OR:
+			added = as_operations_bit_or(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					bytes_size, bytes);
+			break;
+		case OP_BIT_XOR:
+			added = as_operations_bit_xor(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					bytes_size, bytes);
+			break;
+		case OP_BIT_AND:
+			added = as_operations_bit_and(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					bytes_size, bytes);
+			break;
+		case OP_BIT_NOT:
+			added = as_operations_bit_not(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size);
+			break;
+		case OP_BIT_LSHIFT:
+			added = as_operations_bit_lshift(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					(uint32_t)int_val);
+			break;
+		case OP_BIT_RSHIFT:
+			added = as_operations_bit_rshift(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					(uint32_t)int_val);
+			break;
+		case OP_BIT_ADD:
+			added = as_operations_bit_add(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					int_val, is_signed, (as_bit_overflow_action)overflow_action);
+			break;
+		case OP_BIT_SUBTRACT:
+			added = as_operations_bit_subtract(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					int_val, is_signed, (as_bit_overflow_action)overflow_action);
+			break;
+		case OP_BIT_SET_INT:
+			added = as_operations_bit_set_int(ops, bin_name, ctx, &bit_policy, (int)bit_offset, (uint32_t)bit_size,
+					int_val);
+			break;
+		case OP_BIT_GET:
+			added = as_operations_bit_get(ops, bin_name, ctx, (int)bit_offset, (uint32_t)bit_size);
+			break;
+		case OP_BIT_COUNT:
+			added = as_operations_bit_count(ops, bin_name, ctx, (int)bit_offset, (uint32_t)bit_size);
+			break;
+		case OP_BIT_LSCAN:
+			added = as_operations_bit_lscan(ops, bin_name, ctx, (int)bit_offset, (uint32_t)bit_size, int_val != 0);
+			break;
+		case OP_BIT_RSCAN:
+			added = as_operations_bit_rscan(ops, bin_name, ctx, (int)bit_offset, (uint32_t)bit_size, int_val != 0);
+			break;
+		case OP_BIT_GET_INT:
+			added = as_operations_bit_get_int(ops, bin_name, ctx, (int)bit_offset, (uint32_t)bit_size, is_signed);
+			break;
+		default:
+			break;
+	}
+
+	/* The bytes were copied into the operation */
+	if (val) {
+		as_val_destroy(val);
+	}
+
+	if (!added) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add bit operation");
+	}
+	return AEROSPIKE_OK;
+}
+
+/*
+ * Add a HyperLogLog operation. init and add take the index_bit_count and the optional
+ * minhash_bit_count of the HLL, -1 keeps those of an existing bin. The union, intersect and
+ * similarity operations take a val list of the HLLs, as Aerospike\Bytes, returned by get_union
+ * or read from other records.
+ */
+static as_status
+add_hll_op_to_operations(HashTable* op_array, int op_type, const char* bin_name,
+		as_operations* ops, as_cdt_ctx* ctx, as_error* err, int serializer_type) {
+	int64_t index_bit_count = -1;
+	int64_t minhash_bit_count = -1;
+	as_list* list = NULL;
+	as_hll_policy hll_policy;
+	bool added = false;
+
+	if (get_hll_policy_from_op_hash(err, op_array, &hll_policy) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	if (get_long_from_op_hash(err, op_array, AS_HLL_INDEX_BIT_COUNT_KEY,
+				op_type == OP_HLL_FOLD, &index_bit_count) != AEROSPIKE_OK ||
+			get_long_from_op_hash(err, op_array, AS_HLL_MINHASH_BIT_COUNT_KEY, false, &minhash_bit_count) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	switch (op_type) {
+		case OP_HLL_ADD:
+			if (get_hll_list_from_op_hash(err, op_array, false, &list, serializer_type) != AEROSPIKE_OK) {
+				return err->code;
+			}
+			break;
+		case OP_HLL_SET_UNION:
+		case OP_HLL_GET_UNION:
+		case OP_HLL_GET_UNION_COUNT:
+		case OP_HLL_GET_INTERSECT_COUNT:
+		case OP_HLL_GET_SIMILARITY:
+			if (get_hll_list_from_op_hash(err, op_array, true, &list, serializer_type) != AEROSPIKE_OK) {
+				return err->code;
+			}
+			break;
+		default:
+			break;
+	}
+
+	switch (op_type) {
+		case OP_HLL_INIT:
+			added = as_operations_hll_init_mh(ops, bin_name, ctx, &hll_policy, (int)index_bit_count,
+					(int)minhash_bit_count);
+			break;
+		case OP_HLL_ADD:
+			added = as_operations_hll_add_mh(ops, bin_name, ctx, &hll_policy, list, (int)index_bit_count,
+					(int)minhash_bit_count);
+			break;
+		case OP_HLL_SET_UNION:
+			added = as_operations_hll_set_union(ops, bin_name, ctx, &hll_policy, list);
+			break;
+		case OP_HLL_REFRESH_COUNT:
+			added = as_operations_hll_refresh_count(ops, bin_name, ctx);
+			break;
+		case OP_HLL_FOLD:
+			added = as_operations_hll_fold(ops, bin_name, ctx, (int)index_bit_count);
+			break;
+		case OP_HLL_GET_COUNT:
+			added = as_operations_hll_get_count(ops, bin_name, ctx);
+			break;
+		case OP_HLL_GET_UNION:
+			added = as_operations_hll_get_union(ops, bin_name, ctx, list);
+			break;
+		case OP_HLL_GET_UNION_COUNT:
+			added = as_operations_hll_get_union_count(ops, bin_name, ctx, list);
+			break;
+		case OP_HLL_GET_INTERSECT_COUNT:
+			added = as_operations_hll_get_intersect_count(ops, bin_name, ctx, list);
+			break;
+		case OP_HLL_GET_SIMILARITY:
+			added = as_operations_hll_get_similarity(ops, bin_name, ctx, list);
+			break;
+		case OP_HLL_DESCRIBE:
+			added = as_operations_hll_describe(ops, bin_name, ctx);
+			break;
+		default:
+			break;
+	}
+
+	/* The list was packed into the operation */
+	if (list) {
+		as_list_destroy(list);
+	}
+
+	if (!added) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Failed to add HLL operation");
+	}
+	return AEROSPIKE_OK;
+}
+
 static inline bool op_requires_bin(int op_type) {
 	return (op_type != AS_OPERATOR_DELETE);
 }
@@ -971,9 +1681,11 @@ op_is_map_op(int op_type) {
 			 op_type == OP_MAP_CLEAR ||
 			 op_type == OP_MAP_REMOVE_BY_KEY ||
 			 op_type == OP_MAP_REMOVE_BY_KEY_LIST ||
+			 op_type == OP_MAP_GET_BY_KEY_LIST ||
 			 op_type == OP_MAP_REMOVE_BY_KEY_RANGE ||
 			 op_type == OP_MAP_REMOVE_BY_VALUE ||
 			 op_type == OP_MAP_REMOVE_BY_VALUE_LIST ||
+			 op_type == OP_MAP_GET_BY_VALUE_LIST ||
 			 op_type == OP_MAP_REMOVE_BY_VALUE_RANGE ||
 			 op_type == OP_MAP_REMOVE_BY_INDEX ||
 			 op_type == OP_MAP_REMOVE_BY_INDEX_RANGE ||
@@ -989,6 +1701,28 @@ op_is_map_op(int op_type) {
 			 op_type == OP_MAP_GET_BY_RANK_RANGE);
 }
 
+static inline bool op_is_list_op(int op_type) {
+	return (op_type >= OP_LIST_APPEND && op_type <= OP_LIST_REMOVE_BY_VALUE_RANGE);
+}
+
+static inline bool op_is_list_cdt_op(int op_type) {
+	return (op_type >= OP_LIST_SET_ORDER && op_type <= OP_LIST_REMOVE_BY_VALUE_RANGE);
+}
+
+static inline bool op_is_bit_op(int op_type) {
+	return (op_type >= OP_BIT_RESIZE && op_type <= OP_BIT_GET_INT);
+}
+
+static inline bool op_is_hll_op(int op_type) {
+	return (op_type >= OP_HLL_INIT && op_type <= OP_HLL_DESCRIBE);
+}
+
+static inline bool op_accepts_list_policy(int op_type) {
+	return (op_type == OP_LIST_APPEND || op_type == OP_LIST_MERGE ||
+			op_type == OP_LIST_INSERT || op_type == OP_LIST_INSERT_ITEMS ||
+			op_type == OP_LIST_SET);
+}
+
 static inline bool op_requires_list_val(int op_type) {
 	return (op_type == OP_LIST_MERGE || op_type == OP_LIST_INSERT_ITEMS);
 }
@@ -1018,9 +1752,11 @@ map_op_requires_map_return_type(int op_type) {
 	return (
 			op_type == OP_MAP_REMOVE_BY_KEY ||
 			op_type == OP_MAP_REMOVE_BY_KEY_LIST ||
+			op_type == OP_MAP_GET_BY_KEY_LIST ||
 			op_type == OP_MAP_REMOVE_BY_KEY_RANGE ||
 			op_type == OP_MAP_REMOVE_BY_VALUE ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_LIST ||
+			op_type == OP_MAP_GET_BY_VALUE_LIST ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_RANGE ||
 			op_type == OP_MAP_REMOVE_BY_INDEX ||
 			op_type == OP_MAP_REMOVE_BY_INDEX_RANGE ||
@@ -1044,6 +1780,7 @@ static inline bool map_op_requires_key(int op_type) {
 			op_type == OP_MAP_DECREMENT ||
 			op_type == OP_MAP_REMOVE_BY_KEY ||
 			op_type == OP_MAP_REMOVE_BY_KEY_LIST ||
+			op_type == OP_MAP_GET_BY_KEY_LIST ||
 			op_type == OP_MAP_REMOVE_BY_KEY_RANGE ||
 			op_type == OP_MAP_GET_BY_KEY ||
 			op_type == OP_MAP_GET_BY_KEY_RANGE
@@ -1058,6 +1795,7 @@ static inline bool map_op_requires_val(int op_type) {
 			op_type == OP_MAP_DECREMENT ||
 			op_type == OP_MAP_REMOVE_BY_VALUE ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_LIST ||
+			op_type == OP_MAP_GET_BY_VALUE_LIST ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_RANGE ||
 			op_type == OP_MAP_GET_BY_VALUE ||
 			op_type == OP_MAP_GET_BY_VALUE_RANGE ||
@@ -1076,9 +1814,11 @@ static inline bool map_op_requires_return_type(int op_type) {
 	return (
 			op_type == OP_MAP_REMOVE_BY_KEY ||
 			op_type == OP_MAP_REMOVE_BY_KEY_LIST ||
+			op_type == OP_MAP_GET_BY_KEY_LIST ||
 			op_type == OP_MAP_REMOVE_BY_KEY_RANGE ||
 			op_type == OP_MAP_REMOVE_BY_VALUE ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_LIST ||
+			op_type == OP_MAP_GET_BY_VALUE_LIST ||
 			op_type == OP_MAP_REMOVE_BY_VALUE_RANGE ||
 			op_type == OP_MAP_REMOVE_BY_INDEX ||
 			op_type == OP_MAP_REMOVE_BY_INDEX_RANGE ||
@@ -1119,6 +1859,47 @@ static inline bool map_op_requires_count(int op_type) {
 			op_type == OP_MAP_GET_BY_RANK_RANGE);
 }
 
+/* List op argument classifiers */
+static inline bool list_op_requires_index(int op_type) {
+	return (
+			op_type == OP_LIST_INCREMENT ||
+			op_type == OP_LIST_GET_BY_INDEX ||
+			op_type == OP_LIST_GET_BY_INDEX_RANGE ||
+			op_type == OP_LIST_REMOVE_BY_INDEX ||
+			op_type == OP_LIST_REMOVE_BY_INDEX_RANGE);
+}
+
+static inline bool list_op_requires_rank(int op_type) {
+	return (
+			op_type == OP_LIST_GET_BY_RANK ||
+			op_type == OP_LIST_GET_BY_RANK_RANGE ||
+			op_type == OP_LIST_REMOVE_BY_RANK ||
+			op_type == OP_LIST_REMOVE_BY_RANK_RANGE);
+}
+
+static inline bool list_op_requires_count(int op_type) {
+	return (
+			op_type == OP_LIST_GET_BY_INDEX_RANGE ||
+			op_type == OP_LIST_GET_BY_RANK_RANGE ||
+			op_type == OP_LIST_REMOVE_BY_INDEX_RANGE ||
+			op_type == OP_LIST_REMOVE_BY_RANK_RANGE);
+}
+
+static inline bool list_op_requires_val(int op_type) {
+	return (
+			op_type == OP_LIST_INCREMENT ||
+			op_type == OP_LIST_GET_BY_VALUE ||
+			op_type == OP_LIST_GET_BY_VALUE_LIST ||
+			op_type == OP_LIST_GET_BY_VALUE_RANGE ||
+			op_type == OP_LIST_REMOVE_BY_VALUE ||
+			op_type == OP_LIST_REMOVE_BY_VALUE_LIST ||
+			op_type == OP_LIST_REMOVE_BY_VALUE_RANGE);
+}
+
+static inline bool list_op_requires_return_type(int op_type) {
+	return (op_type >= OP_LIST_GET_BY_INDEX && op_type <= OP_LIST_REMOVE_BY_VALUE_RANGE);
+}
+
 static inline bool map_op_requires_range_end(int op_type) {
 	return (
 			op_type == OP_MAP_REMOVE_BY_KEY_RANGE ||
@@ -1263,7 +2044,7 @@ static as_status get_map_policy_from_op_hash(as_error* err, HashTable* op_hash,
 	return AEROSPIKE_OK;
 }
 
-static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash, as_map_return_type* return_type) {
+static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash, int* return_type) {
 	zval* z_return_type = NULL;
 
 	if (!op_hash) {
@@ -1278,7 +2059,134 @@ static as_status get_return_type_from_op_hash(as_error* err, HashTable* op_hash,
 	if (Z_TYPE_P(z_return_type) != IS_LONG) {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "return_type must be a long");
 	}
-	*return_type = (as_map_return_type)Z_LVAL_P(z_return_type);
+	*return_type = (int)Z_LVAL_P(z_return_type);
+
+	return AEROSPIKE_OK;
+}
+
+static as_status get_list_policy_from_op_hash(as_error* err, HashTable* op_hash, as_list_policy* list_policy_p) {
+	zval* z_list_policy = NULL;
+
+	if (!op_hash) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation must not be empty");
+	}
 
+	z_list_policy = zend_hash_str_find(op_hash, AS_LIST_POLICY_KEY, strlen(AS_LIST_POLICY_KEY));
+	if (!z_list_policy) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation missing a required list_policy entry");
+	}
+
+	if (zval_to_as_policy_list(z_list_policy, list_policy_p) != AEROSPIKE_OK) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid list_policy");
+	}
+	return AEROSPIKE_OK;
+}
+
+/* An optional, or if required a mandatory, integer entry of the operation */
+static as_status get_long_from_op_hash(as_error* err, HashTable* op_hash, const char* name, bool required, int64_t* value) {
+	zval* z_value = zend_hash_str_find(op_hash, name, strlen(name));
+
+	if (!z_value) {
+		if (required) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation missing a required %s entry", name);
+		}
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_value) != IS_LONG) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "%s entry must be a long type", name);
+	}
+
+	*value = Z_LVAL_P(z_value);
+	return AEROSPIKE_OK;
+}
+
+static as_status get_bit_policy_from_op_hash(as_error* err, HashTable* op_hash, as_bit_policy* bit_policy_p) {
+	zval* z_bit_policy = NULL;
+	zval* z_flags = NULL;
+
+	as_bit_policy_init(bit_policy_p);
+
+	z_bit_policy = zend_hash_str_find(op_hash, AS_BIT_POLICY_KEY, strlen(AS_BIT_POLICY_KEY));
+	if (!z_bit_policy) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_bit_policy) != IS_ARRAY) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid bit_policy");
+	}
+
+	z_flags = zend_hash_index_find(Z_ARRVAL_P(z_bit_policy), OPT_BIT_WRITE_FLAGS);
+	if (z_flags) {
+		if (Z_TYPE_P(z_flags) != IS_LONG) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid bit_policy");
+		}
+		as_bit_policy_set_write_flags(bit_policy_p, (as_bit_write_flags)Z_LVAL_P(z_flags));
+	}
+	return AEROSPIKE_OK;
+}
+
+static as_status get_hll_policy_from_op_hash(as_error* err, HashTable* op_hash, as_hll_policy* hll_policy_p) {
+	zval* z_hll_policy = NULL;
+	zval* z_flags = NULL;
+
+	as_hll_policy_init(hll_policy_p);
+
+	z_hll_policy = zend_hash_str_find(op_hash, AS_HLL_POLICY_KEY, strlen(AS_HLL_POLICY_KEY));
+	if (!z_hll_policy) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_hll_policy) != IS_ARRAY) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid hll_policy");
+	}
+
+	z_flags = zend_hash_index_find(Z_ARRVAL_P(z_hll_policy), OPT_HLL_WRITE_FLAGS);
+	if (z_flags) {
+		if (Z_TYPE_P(z_flags) != IS_LONG) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid hll_policy");
+		}
+		as_hll_policy_set_write_flags(hll_policy_p, (as_hll_write_flags)Z_LVAL_P(z_flags));
+	}
+	return AEROSPIKE_OK;
+}
+
+/*
+ * The val list of an HLL operation. With hll_values each entry must be an Aerospike\Bytes,
+ * it is tagged as an HLL for the server.
+ */
+static as_status get_hll_list_from_op_hash(as_error* err, HashTable* op_hash, bool hll_values, as_list** list,
+		int serializer_type) {
+	as_val* val = NULL;
+	as_bytes* bytes = NULL;
+	uint32_t size = 0;
+	uint32_t i = 0;
+
+	if (get_value_from_op_hash(err, op_hash, &val, serializer_type) != AEROSPIKE_OK) {
+		return err->code;
+	}
+
+	if (!val || as_val_type(val) != AS_LIST) {
+		if (val) {
+			as_val_destroy(val);
+		}
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation requires a list val entry");
+	}
+
+	*list = as_list_fromval(val);
+	if (!hll_values) {
+		return AEROSPIKE_OK;
+	}
+
+	size = as_list_size(*list);
+	for (i = 0; i < size; i++) {
+		bytes = as_bytes_fromval(as_list_get(*list, i));
+		if (!bytes) {
+			as_list_destroy(*list);
+			*list = NULL;
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Operation val must be a list of HLL Aerospike\\Bytes");
+		}
+		as_bytes_set_type(bytes, AS_BYTES_HLL);
+	}
 	return AEROSPIKE_OK;
 }
@@ -104,3 +104,75 @@ void set_policy_defaults_from_ini(as_config* config, AerospikeClient* client) {
 		strcpy(config->lua.user_path, lua_user_path_str);
 	}
 }
+
+/*
+ * The defaults of a command on the records of set in ns: the profile of the set, else of the
+ * namespace, else the defaults of the client. set may be NULL or empty for a whole namespace.
+ */
+as_policies* get_set_policies(AerospikeClient* client, const char* ns, size_t ns_len, const char* set,
+		size_t set_len) {
+	as_php_policy_profile* profile = NULL;
+	as_php_policy_profile* set_profile = NULL;
+
+	if (!client->policy_profiles || !ns ||
+			!(profile = zend_hash_str_find_ptr(client->policy_profiles, ns, ns_len))) {
+		return &client->as_client->config.policies;
+	}
+
+	if (profile->set_profiles && set && set_len &&
+			(set_profile = zend_hash_str_find_ptr(profile->set_profiles, set, set_len))) {
+		return &set_profile->policies;
+	}
+	return &profile->policies;
+}
+
+/*
+ * The defaults of a command on the record of z_key: the profile of its set, else of its
+ * namespace, else the defaults of the client
+ */
+as_policies* get_key_policies(AerospikeClient* client, HashTable* z_key) {
+	zval* z_ns = NULL;
+	zval* z_set = NULL;
+
+	if (!client->policy_profiles || !z_key) {
+		return &client->as_client->config.policies;
+	}
+
+	z_ns = zend_hash_str_find(z_key, NAMESPACE_KEY, sizeof(NAMESPACE_KEY) - 1);
+	if (!z_ns || Z_TYPE_P(z_ns) != IS_STRING) {
+		return &client->as_client->config.policies;
+	}
+
+	z_set = zend_hash_str_find(z_key, SET_KEY, sizeof(SET_KEY) - 1);
+	if (!z_set || Z_TYPE_P(z_set) != IS_STRING) {
+		return get_set_policies(client, Z_STRVAL_P(z_ns), Z_STRLEN_P(z_ns), NULL, 0);
+	}
+	return get_set_policies(client, Z_STRVAL_P(z_ns), Z_STRLEN_P(z_ns), Z_STRVAL_P(z_set), Z_STRLEN_P(z_set));
+}
+
+/*
+ * The defaults of a batch command on the records of z_keys: the profile all of its keys share,
+ * else the defaults of the client
+ */
+as_policies* get_batch_policies(AerospikeClient* client, HashTable* z_keys) {
+	as_policies* policies = NULL;
+	as_policies* key_policies = NULL;
+	zval* z_key = NULL;
+
+	if (!client->policy_profiles || !z_keys) {
+		return &client->as_client->config.policies;
+	}
+
+	ZEND_HASH_FOREACH_VAL(z_keys, z_key) {
+		if (Z_TYPE_P(z_key) != IS_ARRAY) {
+			return &client->as_client->config.policies;
+		}
+		key_policies = get_key_policies(client, Z_ARRVAL_P(z_key));
+		if (policies && key_policies != policies) {
+			return &client->as_client->config.policies;
+		}
+		policies = key_policies;
+	} ZEND_HASH_FOREACH_END();
+
+	return policies ? policies : &client->as_client->config.policies;
+}
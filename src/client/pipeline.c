@@ -0,0 +1,498 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_event.h"
+#include "aerospike/aerospike_key.h"
+#include "aerospike_class.h"
+#include "aerospike_async.h"
+#include "policy_conversions.h"
+#include "php_aerospike_types.h"
+#include "conversions.h"
+#include "compiled_operations.h"
+
+/*
+ * An Aerospike\Pipeline sends single record commands as soon as they are issued, on the pipelined
+ * connections of one event loop, so commands to the same node are written back to back without
+ * waiting for the previous answer. flush() waits for all of them and returns the results in the
+ * order the commands were issued.
+ */
+
+zend_class_entry* aerospike_pipeline_ce;
+static zend_object_handlers aerospike_pipeline_handlers;
+
+static zend_object* aerospike_pipeline_create_object(zend_class_entry* ce);
+static void aerospike_pipeline_free_storage(zend_object* object);
+static AerospikePipeline* get_aerospike_pipeline_from_zobj(zend_object* zobj);
+static AerospikeClient* get_pipeline_client(AerospikePipeline* pipeline, as_error* err);
+static void add_pipeline_command(AerospikePipeline* pipeline, as_php_async_command* cmd);
+static void release_pipeline_commands(AerospikePipeline* pipeline);
+static void pipeline_pipe_listener(void* udata, as_event_loop* event_loop);
+
+PHP_METHOD(AerospikePipeline, __construct) {}
+
+static zend_function_entry aerospike_pipeline_class_functions[] =
+{
+	PHP_ME(AerospikePipeline, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikePipeline, put, pipeline_put_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikePipeline, get, pipeline_get_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikePipeline, operate, pipeline_operate_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikePipeline, remove, pipeline_remove_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikePipeline, flush, pipeline_flush_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_pipeline_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Pipeline", aerospike_pipeline_class_functions);
+	aerospike_pipeline_ce = zend_register_internal_class(&ce);
+	aerospike_pipeline_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_pipeline_ce->create_object = aerospike_pipeline_create_object;
+	aerospike_pipeline_ce->serialize = zend_class_serialize_deny;
+	aerospike_pipeline_ce->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&aerospike_pipeline_handlers, zend_get_std_object_handlers(), sizeof(aerospike_pipeline_handlers));
+	aerospike_pipeline_handlers.free_obj = aerospike_pipeline_free_storage;
+	aerospike_pipeline_handlers.clone_obj = NULL;
+	aerospike_pipeline_handlers.offset = XtOffsetOf(AerospikePipeline, zobj);
+
+	return true;
+}
+
+static AerospikePipeline* get_aerospike_pipeline_from_zobj(zend_object* zobj) {
+	return (AerospikePipeline*)((char*)zobj - XtOffsetOf(AerospikePipeline, zobj));
+}
+
+static zend_object* aerospike_pipeline_create_object(zend_class_entry* ce) {
+	AerospikePipeline* pipeline = ecalloc(1, sizeof(*pipeline) + zend_object_properties_size(ce));
+	ZVAL_UNDEF(&pipeline->z_client);
+
+	zend_object_std_init(&pipeline->zobj, ce);
+	object_properties_init(&pipeline->zobj, ce);
+	pipeline->zobj.handlers = &aerospike_pipeline_handlers;
+
+	return &pipeline->zobj;
+}
+
+static void aerospike_pipeline_free_storage(zend_object* object) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(object);
+
+	/* Commands still in flight are kept alive by the event loop until they complete */
+	release_pipeline_commands(pipeline);
+	if (pipeline->cmds) {
+		efree(pipeline->cmds);
+	}
+	zval_ptr_dtor(&pipeline->z_client);
+	zend_object_std_dtor(object);
+}
+
+/* Errors of the pipeline are reported on the client which created it */
+static AerospikeClient* get_pipeline_client(AerospikePipeline* pipeline, as_error* err) {
+	if (Z_TYPE(pipeline->z_client) != IS_OBJECT) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Pipeline is not attached to a client");
+		return NULL;
+	}
+
+	reset_client_error(&pipeline->z_client);
+	if (check_object_and_connection(&pipeline->z_client, err) != AEROSPIKE_OK) {
+		return NULL;
+	}
+
+	return get_aerospike_from_zobj(Z_OBJ(pipeline->z_client));
+}
+
+static void add_pipeline_command(AerospikePipeline* pipeline, as_php_async_command* cmd) {
+	if (pipeline->cmd_count == pipeline->cmd_capacity) {
+		pipeline->cmd_capacity = pipeline->cmd_capacity ? pipeline->cmd_capacity * 2 : 64;
+		pipeline->cmds = (as_php_async_command**)safe_erealloc(pipeline->cmds, pipeline->cmd_capacity,
+				sizeof(as_php_async_command*), 0);
+	}
+	pipeline->cmds[pipeline->cmd_count++] = cmd;
+}
+
+static void release_pipeline_commands(AerospikePipeline* pipeline) {
+	for (uint32_t i = 0; i < pipeline->cmd_count; i++) {
+		as_php_async_command_release(pipeline->cmds[i]);
+	}
+	pipeline->cmd_count = 0;
+}
+
+/* Passing a pipe listener is what selects the pipelined connections, there is nothing
+ * to do once a command has been written */
+static void pipeline_pipe_listener(void* udata, as_event_loop* event_loop) {
+}
+
+/* {{{ proto Aerospike\Pipeline Aerospike::pipeline( )
+    Creates a pipeline whose commands are sent back to back, see Aerospike\Pipeline::flush() */
+PHP_METHOD(Aerospike, pipeline) {
+	as_error err;
+	AerospikePipeline* pipeline = NULL;
+
+	reset_client_error(getThis());
+	as_error_init(&err);
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to Aerospike::pipeline", false);
+		RETURN_NULL();
+	}
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK ||
+			check_async_event_loops(&err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, aerospike_pipeline_ce);
+	pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(return_value));
+	ZVAL_COPY(&pipeline->z_client, getThis());
+	pipeline->event_loop = as_event_loop_get();
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Pipeline::put( array key, array record [, int ttl=0 [, array options ]] )
+    Sends a write, its outcome is returned by flush() */
+PHP_METHOD(AerospikePipeline, put) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* client = NULL;
+	as_error err;
+	as_php_async_command* cmd = NULL;
+	as_record* record = NULL;
+
+	HashTable* z_key_hash = NULL;
+	zval* z_bins = NULL;
+	zval* z_ttl = NULL;
+	zval* z_write_policy = NULL;
+
+	as_policy_write write_policy;
+	as_policy_write* write_policy_p = NULL;
+	int serializer_type;
+
+	as_error_init(&err);
+
+	if (!(client = get_pipeline_client(pipeline, &err))) {
+		goto CLEANUP;
+	}
+	serializer_type = client->serializer_type;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz|z!z",
+			&z_key_hash, &z_bins, &z_ttl, &z_write_policy) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid parameters to put");
+		goto CLEANUP;
+	}
+
+	if (z_ttl && !(Z_TYPE_P(z_ttl) == IS_NULL || Z_TYPE_P(z_ttl) == IS_LONG)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "ttl must be null or long");
+		goto CLEANUP;
+	}
+
+	if (Z_TYPE_P(z_bins) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(z_bins))) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Record must be a non empty array");
+		goto CLEANUP;
+	}
+
+	if (zval_to_as_policy_write(z_write_policy, &write_policy,
+			&write_policy_p, &get_key_policies(client, z_key_hash)->write, client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid policy");
+		goto CLEANUP;
+	}
+
+	if (set_serializer_from_policy_hash(&serializer_type, z_write_policy) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid serializer value");
+		goto CLEANUP;
+	}
+
+	if (z_hashtable_to_as_record(Z_ARRVAL_P(z_bins), &record, &err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (z_ttl && Z_TYPE_P(z_ttl) == IS_LONG) {
+		record->ttl = (uint32_t)Z_LVAL_P(z_ttl);
+	}
+
+	if (set_record_generation_from_write_policy(record, z_write_policy) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "generation policy");
+		goto CLEANUP;
+	}
+
+	cmd = as_php_async_command_new();
+	if (!cmd) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the async command");
+		goto CLEANUP;
+	}
+
+	if (z_hashtable_to_as_key(z_key_hash, &cmd->key, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	cmd->key_initialized = true;
+
+	cmd->ref_cnt++;
+	if (aerospike_key_put_async(client->as_client, &err, write_policy_p, &cmd->key, record,
+			as_php_async_write_listener, cmd, pipeline->event_loop, pipeline_pipe_listener) != AEROSPIKE_OK) {
+		cmd->ref_cnt--;
+	}
+
+CLEANUP:
+	if (record) {
+		as_record_destroy(record);
+	}
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(pipeline->z_client) == IS_OBJECT) {
+			update_client_error(&pipeline->z_client, err.code, err.message, err.in_doubt);
+		}
+		if (cmd) {
+			as_php_async_command_release(cmd);
+		}
+	} else {
+		add_pipeline_command(pipeline, cmd);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Pipeline::get( array key [, array filter [, array options ]] )
+    Sends a read, the record is returned by flush() */
+PHP_METHOD(AerospikePipeline, get) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* client = NULL;
+	as_error err;
+	as_php_async_command* cmd = NULL;
+
+	HashTable* z_key_hash = NULL;
+	zval* z_filter = NULL;
+	zval* z_read_policy = NULL;
+
+	as_error_init(&err);
+
+	if (!(client = get_pipeline_client(pipeline, &err))) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|z!z", &z_key_hash, &z_filter, &z_read_policy) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid parameters to get");
+		goto CLEANUP;
+	}
+
+	cmd = as_php_async_command_new();
+	if (!cmd) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the async command");
+		goto CLEANUP;
+	}
+
+	as_php_async_get(client, &err, cmd, z_key_hash, z_filter, z_read_policy,
+			pipeline->event_loop, pipeline_pipe_listener);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(pipeline->z_client) == IS_OBJECT) {
+			update_client_error(&pipeline->z_client, err.code, err.message, err.in_doubt);
+		}
+		if (cmd) {
+			as_php_async_command_release(cmd);
+		}
+	} else {
+		add_pipeline_command(pipeline, cmd);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Pipeline::operate( array key, array|Aerospike\Operations operations [, array options ] )
+    Sends an operate, the returned bins are in the record returned by flush() */
+PHP_METHOD(AerospikePipeline, operate) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* client = NULL;
+	as_error err;
+	as_php_async_command* cmd = NULL;
+	as_operations ops;
+	bool operations_initialized = false;
+
+	HashTable* z_key_hash = NULL;
+	zval* z_ops = NULL;
+	zval* z_operate_policy = NULL;
+
+	as_policy_operate operate_policy;
+	as_policy_operate* operate_policy_p = NULL;
+	int serializer_type;
+
+	as_error_init(&err);
+
+	if (!(client = get_pipeline_client(pipeline, &err))) {
+		goto CLEANUP;
+	}
+	serializer_type = client->serializer_type;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "hz|z", &z_key_hash, &z_ops, &z_operate_policy) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid Parameters for operate");
+		goto CLEANUP;
+	}
+
+	if (zval_to_as_policy_operate(z_operate_policy, &operate_policy,
+			&operate_policy_p, &get_key_policies(client, z_key_hash)->operate, client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
+		goto CLEANUP;
+	}
+
+	if (!as_php_operations_count(z_ops)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Empty operations array");
+		goto CLEANUP;
+	}
+	set_serializer_from_policy_hash(&serializer_type, z_operate_policy);
+
+	as_operations_init(&ops, as_php_operations_count(z_ops));
+	operations_initialized = true;
+
+	if (zval_to_as_operations(z_ops, z_operate_policy, &ops, &err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	cmd = as_php_async_command_new();
+	if (!cmd) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the async command");
+		goto CLEANUP;
+	}
+	cmd->show_pk = (operate_policy_p && operate_policy_p->key == AS_POLICY_KEY_SEND);
+
+	if (z_hashtable_to_as_key(z_key_hash, &cmd->key, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	cmd->key_initialized = true;
+
+	cmd->ref_cnt++;
+	if (aerospike_key_operate_async(client->as_client, &err, operate_policy_p, &cmd->key, &ops,
+			as_php_async_record_listener, cmd, pipeline->event_loop, pipeline_pipe_listener) != AEROSPIKE_OK) {
+		cmd->ref_cnt--;
+	}
+
+CLEANUP:
+	if (operations_initialized) {
+		as_operations_destroy(&ops);
+	}
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(pipeline->z_client) == IS_OBJECT) {
+			update_client_error(&pipeline->z_client, err.code, err.message, err.in_doubt);
+		}
+		if (cmd) {
+			as_php_async_command_release(cmd);
+		}
+	} else {
+		add_pipeline_command(pipeline, cmd);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Pipeline::remove( array key [, array options ] )
+    Sends a remove, its outcome is returned by flush() */
+PHP_METHOD(AerospikePipeline, remove) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* client = NULL;
+	as_error err;
+	as_php_async_command* cmd = NULL;
+
+	HashTable* z_key_hash = NULL;
+	zval* z_remove_policy = NULL;
+
+	as_policy_remove remove_policy;
+	as_policy_remove* remove_policy_p = NULL;
+
+	as_error_init(&err);
+
+	if (!(client = get_pipeline_client(pipeline, &err))) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|z", &z_key_hash, &z_remove_policy) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid Parameters for remove");
+		goto CLEANUP;
+	}
+
+	if (zval_to_as_policy_remove(z_remove_policy, &remove_policy,
+			&remove_policy_p, &get_key_policies(client, z_key_hash)->remove, client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid remove policy");
+		goto CLEANUP;
+	}
+
+	cmd = as_php_async_command_new();
+	if (!cmd) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the async command");
+		goto CLEANUP;
+	}
+
+	if (z_hashtable_to_as_key(z_key_hash, &cmd->key, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	cmd->key_initialized = true;
+
+	cmd->ref_cnt++;
+	if (aerospike_key_remove_async(client->as_client, &err, remove_policy_p, &cmd->key,
+			as_php_async_write_listener, cmd, pipeline->event_loop, pipeline_pipe_listener) != AEROSPIKE_OK) {
+		cmd->ref_cnt--;
+	}
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(pipeline->z_client) == IS_OBJECT) {
+			update_client_error(&pipeline->z_client, err.code, err.message, err.in_doubt);
+		}
+		if (cmd) {
+			as_php_async_command_release(cmd);
+		}
+	} else {
+		add_pipeline_command(pipeline, cmd);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Pipeline::flush( array &results [, int timeout_ms=0 ] )
+    Waits for every command sent since the last flush. results is a list in the order the commands
+    were issued, each entry as described in Aerospike::awaitAll(). Returns ERR_TIMEOUT if timeout_ms
+    passed first, the pending commands then have "result" => ERR_TIMEOUT and their outcome is dropped */
+PHP_METHOD(AerospikePipeline, flush) {
+	AerospikePipeline* pipeline = get_aerospike_pipeline_from_zobj(Z_OBJ_P(getThis()));
+	zval* z_results = NULL;
+	zval z_entry;
+	zend_long timeout_ms = 0;
+	struct timespec deadline;
+	as_status cmd_status;
+	as_status status = AEROSPIKE_OK;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z/|l", &z_results, &timeout_ms) == FAILURE) {
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_results);
+	array_init_size(z_results, pipeline->cmd_count);
+
+	if (timeout_ms > 0) {
+		async_deadline_from_timeout(&deadline, timeout_ms);
+	}
+
+	for (uint32_t i = 0; i < pipeline->cmd_count; i++) {
+		if (!as_php_async_command_to_zval(pipeline->cmds[i], &z_entry, &cmd_status,
+				timeout_ms > 0 ? &deadline : NULL)) {
+			status = AEROSPIKE_ERR_TIMEOUT;
+			array_init(&z_entry);
+			add_assoc_long(&z_entry, "result", AEROSPIKE_ERR_TIMEOUT);
+		}
+		add_next_index_zval(z_results, &z_entry);
+	}
+	release_pipeline_commands(pipeline);
+
+	RETURN_LONG(status);
+}
+/* }}} */
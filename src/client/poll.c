@@ -0,0 +1,313 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike_class.h"
+#include "aerospike_async.h"
+#include "php_aerospike_types.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*
+ * Completion callbacks, for applications which run their own event loop (Swoole, ReactPHP, ...).
+ *
+ * Aerospike\Future::onComplete() registers a callback for a command. Once the command completes,
+ * the event loop thread pushes it on the completion queue of the PHP thread, and the stream returned
+ * by Aerospike::completionStream() becomes readable. The application then calls Aerospike::poll(),
+ * which never blocks, to run the callbacks of every command completed so far.
+ *
+ * A socket pair is used rather than an eventfd so this also works outside of Linux, and so
+ * it can be read and written without blocking whatever mode the application sets on its stream.
+ */
+
+static as_php_completion_queue* get_completion_queue(as_error* err);
+static as_php_async_command* take_completed_commands(as_php_completion_queue* queue);
+static void requeue_completed_commands(as_php_completion_queue* queue, as_php_async_command* list);
+static void signal_completion_queue(as_php_completion_queue* queue);
+
+/* Make the command go through queue once it completes, right away if it already has */
+void as_php_async_command_notify(as_php_async_command* cmd, as_php_completion_queue* queue) {
+	pthread_mutex_lock(&cmd->lock);
+	if (!cmd->queue) {
+		pthread_mutex_lock(&queue->lock);
+		queue->ref_cnt++;
+		pthread_mutex_unlock(&queue->lock);
+		cmd->queue = queue;
+	}
+	if (cmd->done) {
+		cmd->ref_cnt++;
+		as_php_completion_queue_push(cmd->queue, cmd);
+	}
+	pthread_mutex_unlock(&cmd->lock);
+}
+
+/* May run on an event loop thread, the caller holds the command lock and passes the queue a reference */
+void as_php_completion_queue_push(as_php_completion_queue* queue, as_php_async_command* cmd) {
+	bool was_empty;
+
+	pthread_mutex_lock(&queue->lock);
+	cmd->next = NULL;
+	was_empty = (queue->head == NULL);
+	if (was_empty) {
+		queue->head = cmd;
+	} else {
+		queue->tail->next = cmd;
+	}
+	queue->tail = cmd;
+	pthread_mutex_unlock(&queue->lock);
+
+	if (was_empty) {
+		signal_completion_queue(queue);
+	}
+}
+
+void as_php_completion_queue_release(as_php_completion_queue* queue) {
+	bool last_ref;
+
+	pthread_mutex_lock(&queue->lock);
+	last_ref = (--queue->ref_cnt == 0);
+	pthread_mutex_unlock(&queue->lock);
+
+	if (!last_ref) {
+		return;
+	}
+
+	/* Only commands hold references besides the PHP thread, so nothing can be queued anymore */
+	close(queue->read_fd);
+	close(queue->write_fd);
+	pthread_mutex_destroy(&queue->lock);
+	free(queue);
+}
+
+static as_php_completion_queue* get_completion_queue(as_error* err) {
+	as_php_completion_queue* queue = AEROSPIKE_G(completion_queue);
+	int fds[2];
+
+	if (queue) {
+		return queue;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to create the completion socket pair: %s", strerror(errno));
+		return NULL;
+	}
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+	queue = (as_php_completion_queue*)calloc(1, sizeof(as_php_completion_queue));
+	if (!queue) {
+		close(fds[0]);
+		close(fds[1]);
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the completion queue");
+		return NULL;
+	}
+
+	pthread_mutex_init(&queue->lock, NULL);
+	queue->ref_cnt = 1;
+	queue->read_fd = fds[0];
+	queue->write_fd = fds[1];
+
+	AEROSPIKE_G(completion_queue) = queue;
+	return queue;
+}
+
+/*
+ * Drain the socket before taking the list, a command queued in between is then either
+ * taken now, leaving a spurious wake up, or signals the socket again
+ */
+static as_php_async_command* take_completed_commands(as_php_completion_queue* queue) {
+	as_php_async_command* list = NULL;
+	char buf[64];
+
+	while (recv(queue->read_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+	}
+
+	pthread_mutex_lock(&queue->lock);
+	list = queue->head;
+	queue->head = NULL;
+	queue->tail = NULL;
+	pthread_mutex_unlock(&queue->lock);
+
+	return list;
+}
+
+/* Put back the commands a poll() did not get to, ahead of the ones queued meanwhile */
+static void requeue_completed_commands(as_php_completion_queue* queue, as_php_async_command* list) {
+	as_php_async_command* last = list;
+
+	while (last->next) {
+		last = last->next;
+	}
+
+	pthread_mutex_lock(&queue->lock);
+	last->next = queue->head;
+	if (!queue->head) {
+		queue->tail = last;
+	}
+	queue->head = list;
+	pthread_mutex_unlock(&queue->lock);
+
+	signal_completion_queue(queue);
+}
+
+static void signal_completion_queue(as_php_completion_queue* queue) {
+	char signal_byte = 1;
+
+	/* A full socket buffer already means readable */
+	while (send(queue->write_fd, &signal_byte, 1, MSG_DONTWAIT) < 0 && errno == EINTR) {
+	}
+}
+
+/* {{{ proto int Aerospike\Future::onComplete( callable callback )
+    Registers callback(array result, int status) to be run by Aerospike::poll() once the command completed */
+PHP_METHOD(AerospikeFuture, onComplete) {
+	AerospikeFuture* future = get_aerospike_future_from_zobj(Z_OBJ_P(getThis()));
+	as_php_completion_queue* queue = NULL;
+	zval* z_callback = NULL;
+	zval z_waiter;
+	as_error err;
+
+	as_error_init(&err);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &z_callback) == FAILURE ||
+			!zend_is_callable(z_callback, 0, NULL)) {
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (!future->cmd) {
+		RETURN_LONG(AEROSPIKE_ERR_CLIENT);
+	}
+
+	if (!(queue = get_completion_queue(&err))) {
+		RETURN_LONG(err.code);
+	}
+
+	zval_ptr_dtor(&future->z_callback);
+	ZVAL_COPY(&future->z_callback, z_callback);
+
+	if (future->cmd->waiter) {
+		RETURN_LONG(AEROSPIKE_OK);
+	}
+
+	/* Keep the future alive until its callback has run, even if the application drops it */
+	if (!AEROSPIKE_G(pending_callbacks)) {
+		ALLOC_HASHTABLE(AEROSPIKE_G(pending_callbacks));
+		zend_hash_init(AEROSPIKE_G(pending_callbacks), 16, NULL, ZVAL_PTR_DTOR, 0);
+	}
+	ZVAL_COPY(&z_waiter, getThis());
+	zend_hash_index_update(AEROSPIKE_G(pending_callbacks), Z_OBJ_HANDLE(z_waiter), &z_waiter);
+
+	future->cmd->waiter = Z_OBJ_P(getThis());
+	as_php_async_command_notify(future->cmd, queue);
+
+	RETURN_LONG(AEROSPIKE_OK);
+}
+/* }}} */
+
+/* {{{ proto resource Aerospike::completionStream( )
+    Returns a stream which becomes readable when commands with a completion callback complete */
+PHP_METHOD(Aerospike, completionStream) {
+	as_php_completion_queue* queue = NULL;
+	php_stream* stream = NULL;
+	as_error err;
+	int fd;
+
+	as_error_init(&err);
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (!(queue = get_completion_queue(&err))) {
+		RETURN_NULL();
+	}
+
+	/* Each stream owns its own descriptor, so closing it leaves the queue working */
+	fd = dup(queue->read_fd);
+	if (fd < 0) {
+		RETURN_NULL();
+	}
+
+	stream = php_stream_fopen_from_fd(fd, "r", NULL);
+	if (!stream) {
+		close(fd);
+		RETURN_NULL();
+	}
+
+	php_stream_to_zval(stream, return_value);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike::poll( )
+    Runs the callbacks of the commands completed so far without blocking, returns how many were run */
+PHP_METHOD(Aerospike, poll) {
+	as_php_completion_queue* queue = AEROSPIKE_G(completion_queue);
+	as_php_async_command* list = NULL;
+	as_php_async_command* cmd = NULL;
+	AerospikeFuture* future = NULL;
+	zend_object* waiter = NULL;
+	zval z_args[2];
+	zval z_retval;
+	as_status status;
+	zend_long callbacks_run = 0;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_LONG(0);
+	}
+
+	if (!queue) {
+		RETURN_LONG(0);
+	}
+
+	list = take_completed_commands(queue);
+	while (list) {
+		/* Stop at the first callback which throws, the rest is left for the next poll() */
+		if (EG(exception)) {
+			requeue_completed_commands(queue, list);
+			break;
+		}
+
+		cmd = list;
+		list = cmd->next;
+		cmd->next = NULL;
+
+		/* Futures freed since, at the end of a request, have no waiter anymore */
+		if ((waiter = cmd->waiter)) {
+			cmd->waiter = NULL;
+			future = get_aerospike_future_from_zobj(waiter);
+
+			if (aerospike_future_result(future, &z_args[0], &status, NULL)) {
+				ZVAL_LONG(&z_args[1], status);
+				ZVAL_UNDEF(&z_retval);
+				call_user_function(NULL, NULL, &future->z_callback, &z_retval, 2, z_args);
+				zval_ptr_dtor(&z_retval);
+				zval_ptr_dtor(&z_args[0]);
+				callbacks_run++;
+			}
+
+			zend_hash_index_del(AEROSPIKE_G(pending_callbacks), waiter->handle);
+		}
+
+		as_php_async_command_release(cmd);
+	}
+
+	RETURN_LONG(callbacks_run);
+}
+/* }}} */
@@ -0,0 +1,221 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike_class.h"
+#include "php_aerospike_types.h"
+#include "compiled_operations.h"
+#include "prepared_query.h"
+
+/*
+ * Prepared scans and queries.
+ *
+ * Aerospike::prepareQuery() and Aerospike::prepareScan() parse the where predicate, bins, read
+ * operations and options once. Running the result only copies the prepared scan or query, binding
+ * the value of the predicate, so a query run again and again with other values does not go through
+ * the arrays each time. The runs are executed by query.c and scan.c like those of query() and scan().
+ */
+
+zend_class_entry* aerospike_query_ce;
+zend_class_entry* aerospike_scan_ce;
+static zend_object_handlers aerospike_prepared_query_handlers;
+
+static zend_object* aerospike_prepared_query_create_object(zend_class_entry* ce);
+static void aerospike_prepared_query_free_storage(zend_object* object);
+static as_operations* copy_read_operations(const as_operations* source);
+
+PHP_METHOD(AerospikeQuery, __construct) {}
+PHP_METHOD(AerospikeScan, __construct) {}
+
+static zend_function_entry aerospike_query_class_functions[] =
+{
+	PHP_ME(AerospikeQuery, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeQuery, execute, prepared_query_execute_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeQuery, iterator, prepared_query_iterator_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+static zend_function_entry aerospike_scan_class_functions[] =
+{
+	PHP_ME(AerospikeScan, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeScan, execute, prepared_scan_execute_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeScan, partitions, prepared_scan_partitions_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeScan, iterator, prepared_scan_iterator_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_prepared_query_classes(void) {
+	zend_class_entry ce;
+
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Query", aerospike_query_class_functions);
+	aerospike_query_ce = zend_register_internal_class(&ce);
+	aerospike_query_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_query_ce->create_object = aerospike_prepared_query_create_object;
+	aerospike_query_ce->serialize = zend_class_serialize_deny;
+	aerospike_query_ce->unserialize = zend_class_unserialize_deny;
+
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "Scan", aerospike_scan_class_functions);
+	aerospike_scan_ce = zend_register_internal_class(&ce);
+	aerospike_scan_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_scan_ce->create_object = aerospike_prepared_query_create_object;
+	aerospike_scan_ce->serialize = zend_class_serialize_deny;
+	aerospike_scan_ce->unserialize = zend_class_unserialize_deny;
+
+	memcpy(&aerospike_prepared_query_handlers, zend_get_std_object_handlers(),
+			sizeof(aerospike_prepared_query_handlers));
+	aerospike_prepared_query_handlers.free_obj = aerospike_prepared_query_free_storage;
+	aerospike_prepared_query_handlers.clone_obj = NULL;
+	aerospike_prepared_query_handlers.offset = XtOffsetOf(AerospikePreparedQuery, zobj);
+
+	return true;
+}
+
+AerospikePreparedQuery* get_aerospike_prepared_query_from_zobj(zend_object* zobj) {
+	return (AerospikePreparedQuery*)((char*)zobj - XtOffsetOf(AerospikePreparedQuery, zobj));
+}
+
+static zend_object* aerospike_prepared_query_create_object(zend_class_entry* ce) {
+	AerospikePreparedQuery* prepared = ecalloc(1, sizeof(*prepared) + zend_object_properties_size(ce));
+	ZVAL_UNDEF(&prepared->z_client);
+	ZVAL_UNDEF(&prepared->z_where);
+	ZVAL_UNDEF(&prepared->z_policy);
+	prepared->is_query = (ce == aerospike_query_ce);
+
+	zend_object_std_init(&prepared->zobj, ce);
+	object_properties_init(&prepared->zobj, ce);
+	prepared->zobj.handlers = &aerospike_prepared_query_handlers;
+
+	return &prepared->zobj;
+}
+
+static void aerospike_prepared_query_free_storage(zend_object* object) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(object);
+
+	if (prepared->initialized) {
+		if (prepared->is_query) {
+			as_query_destroy(&prepared->query);
+		} else {
+			as_scan_destroy(&prepared->scan);
+		}
+	}
+
+	zval_ptr_dtor(&prepared->z_where);
+	zval_ptr_dtor(&prepared->z_policy);
+	zval_ptr_dtor(&prepared->z_client);
+	zend_object_std_dtor(object);
+}
+
+/* Errors of a run are reported on the client the scan or query was prepared with */
+AerospikeClient* get_prepared_query_client(AerospikePreparedQuery* prepared, as_error* err) {
+	if (Z_TYPE(prepared->z_client) != IS_OBJECT || !prepared->initialized) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "The scan or query was not prepared by a client");
+		return NULL;
+	}
+
+	reset_client_error(&prepared->z_client);
+	if (check_object_and_connection(&prepared->z_client, err) != AEROSPIKE_OK) {
+		return NULL;
+	}
+
+	return get_aerospike_from_zobj(Z_OBJ(prepared->z_client));
+}
+
+/*
+ * Copy the prepared query into query for one run, with z_val as the value of its predicate, or the
+ * value of the where array when z_val is NULL. String values are pointed to, not copied, so z_val
+ * must outlive the run. On failure the copy is left destroyed.
+ */
+as_status as_php_prepared_query_copy(AerospikePreparedQuery* prepared, zval* z_val, as_query* query,
+		as_error* err) {
+	const as_query* source = &prepared->query;
+
+	/* The scalar settings are shared, the lists the copy destroys are its own */
+	*query = *source;
+	query->_free = false;
+	memset(&query->select, 0, sizeof(query->select));
+	memset(&query->where, 0, sizeof(query->where));
+	query->ops = NULL;
+	query->parts_all = NULL;
+
+	if (source->select.size) {
+		as_query_select_init(query, source->select.size);
+		for (uint16_t i = 0; i < source->select.size; i++) {
+			as_query_select(query, source->select.entries[i]);
+		}
+	}
+
+	if (source->ops) {
+		query->ops = copy_read_operations(source->ops);
+	}
+
+	if (!prepared->has_predicate) {
+		if (z_val && Z_TYPE_P(z_val) != IS_NULL) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "The query has no predicate to bind a value to");
+		}
+		goto CLEANUP;
+	}
+
+	if (!z_val || Z_TYPE_P(z_val) == IS_NULL) {
+		z_val = prepared->predicate.val;
+	}
+	if (!z_val) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "No value is bound to the query predicate");
+		goto CLEANUP;
+	}
+	add_parsed_predicate_to_query(query, &prepared->predicate, z_val, err);
+
+CLEANUP:
+	if (err->code != AEROSPIKE_OK) {
+		as_query_destroy(query);
+	}
+	return err->code;
+}
+
+/* Copy the prepared scan into scan for one run */
+as_status as_php_prepared_scan_copy(AerospikePreparedQuery* prepared, as_scan* scan, as_error* err) {
+	const as_scan* source = &prepared->scan;
+
+	*scan = *source;
+	scan->_free = false;
+	memset(&scan->select, 0, sizeof(scan->select));
+	scan->ops = NULL;
+	scan->parts_all = NULL;
+
+	if (source->select.size) {
+		as_scan_select_init(scan, source->select.size);
+		for (uint16_t i = 0; i < source->select.size; i++) {
+			as_scan_select(scan, source->select.entries[i]);
+		}
+	}
+
+	if (source->ops) {
+		scan->ops = copy_read_operations(source->ops);
+	}
+
+	return err->code;
+}
+
+/* The operations share the values of the prepared ones, which are reserved rather than copied */
+static as_operations* copy_read_operations(const as_operations* source) {
+	as_operations* ops = as_operations_new(source->binops.size);
+
+	for (uint16_t i = 0; i < source->binops.size; i++) {
+		add_compiled_binop(ops, &source->binops.entries[i]);
+	}
+	return ops;
+}
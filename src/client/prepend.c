@@ -75,7 +75,7 @@ PHP_METHOD(Aerospike, prepend)
 	key_initialized = true;
 
 	if (zval_to_as_policy_operate(z_op_policy, &operate_policy,
-			&operate_policy_p, &as_ptr->config.policies.operate) != AEROSPIKE_OK) {
+			&operate_policy_p, &get_key_policies(client, z_key)->operate, client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid operate policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -98,6 +98,7 @@ PHP_METHOD(Aerospike, prepend)
 	}
 
 	as_status status = aerospike_key_operate(as_ptr, &err, operate_policy_p, &key, &operations, &rec);
+	deliver_pending_log_events();
 	if (status != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 		goto CLEANUP;
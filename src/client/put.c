@@ -42,10 +42,9 @@ PHP_METHOD(Aerospike, put)
 
 	as_record* record = NULL;
 
-	int serializer_type = INI_INT("aerospike.serializer");
-
 	reset_client_error(getThis());
 	AerospikeClient* client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	int serializer_type = client->serializer_type;
 	aerospike* as_ptr = client->as_client;
 
 	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
@@ -53,12 +52,16 @@ PHP_METHOD(Aerospike, put)
 		RETURN_LONG(err.code);
 	}
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "hz|z!z",
-			&z_key_hash, &zval_to_store, &z_ttl, &z_write_policy) != SUCCESS) {
-
+	ZEND_PARSE_PARAMETERS_START_EX(0, 2, 4)
+		Z_PARAM_ARRAY_HT(z_key_hash)
+		Z_PARAM_ZVAL(zval_to_store)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL_EX(z_ttl, 1, 0)
+		Z_PARAM_ZVAL(z_write_policy)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to put", false);
-	  	RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	);
 
 	if (z_ttl && !(Z_TYPE_P(z_ttl) == IS_NULL || Z_TYPE_P(z_ttl) == IS_LONG)) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "ttl must be null or long", false);
@@ -83,7 +86,7 @@ PHP_METHOD(Aerospike, put)
 
 	if (z_write_policy) {
 		if (zval_to_as_policy_write(z_write_policy, &write_policy,
-				&write_policy_p, &as_ptr->config.policies.write) != AEROSPIKE_OK) {
+				&write_policy_p, &get_key_policies(client, z_key_hash)->write, client) != AEROSPIKE_OK) {
 			as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid policy");
 			goto CLEANUP;
 		}
@@ -116,6 +119,7 @@ PHP_METHOD(Aerospike, put)
 
 	/* Arguments validated and ready, call the C client function */
     aerospike_key_put(as_ptr, &err, write_policy_p, &key, record);
+    deliver_pending_log_events();
 
 CLEANUP:
     if (err.code != AEROSPIKE_OK) {
@@ -21,6 +21,9 @@
 #include "user_callbacks.h"
 #include "aerospike/aerospike_query.h"
 #include "policy_conversions.h"
+#include "record_iterator.h"
+#include "scan_partitions.h"
+#include "prepared_query.h"
 
 #define QUERY_WHERE_OP_KEY "op"
 #define QUERY_WHERE_VAL_KEY "val"
@@ -45,10 +48,16 @@ as_status add_mapkeys_contains_predicate_to_query(as_query* query, char* bin_nam
 as_status add_mapvalues_contains_predicate_to_query(as_query* query, char* bin_name, zval* val, as_error* err);
 // Helper for extracting min max from two element array
 as_status get_min_max_from_zval(zval* val, long* min_long, long* max_long, as_error* err);
+static as_status init_query_from_php(as_query* query, char* ns, char* set, HashTable* predicate_array,
+		HashTable* select_bins, zval* z_policy, int serializer_type, as_error* err);
+static as_status query_cursor_from_zval(zval* z_cursor, as_partitions_status** parts_all, as_error* err);
+static void execute_query_stream(as_php_record_stream* stream, user_callback_function* callback_function_data,
+		zval* z_cursor, as_partitions_status* parts_all);
 
 
-/* {{{ proto int Aerospike::query( string ns, string set, array where, callback record_cb [, array select [, array options ]] )
-    Queries a secondary index on a set for records matching the where predicate  */
+/* {{{ proto int Aerospike::query( string ns, string set, array where, callback record_cb [, array select [, array options [, string &cursor ]]] )
+    Queries a secondary index on a set for records matching the where predicate. With a cursor, returns the page
+    of OPT_MAX_RECORDS records following it and sets it to the next page, or to NULL after the last one  */
 PHP_METHOD(Aerospike, query) {
 
 	AerospikeClient* php_client = NULL;
@@ -63,14 +72,14 @@ PHP_METHOD(Aerospike, query) {
 	size_t ns_len = 0;
 	HashTable* predicate_array = NULL;
 	HashTable* select_bins = NULL;
-	uint32_t select_count = 0;
 	user_callback_function callback_function_data;
 
 	zval* z_policy = NULL;
 	as_policy_query query_policy;
 	as_policy_query* query_policy_p = NULL;
-	bool query_initialized = false;
-	as_query query;
+	zval* z_cursor = NULL;
+	as_partitions_status* parts_all = NULL;
+	as_php_record_stream stream;
 
 	reset_client_error(getThis());
 
@@ -82,10 +91,10 @@ PHP_METHOD(Aerospike, query) {
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshf|h!z",
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshf|h!zz/",
 			&ns, &ns_len, &set, &set_len, &predicate_array,
 			&callback_info, &callback_cache,
-			&select_bins, &z_policy) != SUCCESS) {
+			&select_bins, &z_policy, &z_cursor) != SUCCESS) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to query", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -96,73 +105,416 @@ PHP_METHOD(Aerospike, query) {
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-	if (z_policy && Z_TYPE_P(z_policy) != IS_NULL) {
-		if (zval_to_as_policy_query(z_policy, &query_policy,
-				&query_policy_p, &as_client->config.policies.query) != AEROSPIKE_OK) {
-			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid query policy", false);
-			RETURN_LONG(AEROSPIKE_ERR_PARAM);
-		}
-		query_policy_p = &query_policy;
+	if (zval_to_as_policy_query(z_policy, &query_policy,
+			&query_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->query, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid query policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-	if (!as_query_init(&query, ns, set)) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to create query");
+	if (query_cursor_from_zval(z_cursor, &parts_all, &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_LONG(err.code);
+	}
+
+	callback_function_data.callback = callback_info;
+	callback_function_data.callback_cache = callback_cache;
+	callback_function_data.err = &err;
+	callback_function_data.cursor = NULL;
+
+	as_php_record_stream_init(&stream, as_client, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream.is_query = true;
+	stream.query_policy = query_policy;
+
+	if (init_query_from_php(&stream.query, ns, set, predicate_array, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
-	query_initialized = true;
+	stream.query_initialized = true;
 
-	if (z_policy && Z_TYPE_P(z_policy) != IS_NULL) {
-		if (set_query_options_from_policy_hash(&query, z_policy) != AEROSPIKE_OK) {
-			RETURN_LONG(AEROSPIKE_ERR_PARAM)
+	execute_query_stream(&stream, &callback_function_data, z_cursor, parts_all);
+
+CLEANUP:
+	as_php_record_stream_destroy(&stream);
+	if (parts_all) {
+		as_partitions_status_release(parts_all);
+	}
+
+	if ((err.code) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+
+
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+
+/* {{{ proto Aerospike\RecordIterator Aerospike::queryIterator( string ns, string set, array where [, array select [, array options ]] )
+    Returns an iterator over the records matching the where predicate, read as the application iterates */
+PHP_METHOD(Aerospike, queryIterator) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	AerospikeRecordIterator* iterator = NULL;
+	as_error err;
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+	zval* z_where = NULL;
+	HashTable* select_bins = NULL;
+	zval* z_policy = NULL;
+	as_policy_query query_policy;
+	as_policy_query* query_policy_p = NULL;
+	uint32_t queue_size = 0;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_NULL();
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ssa|h!z",
+			&ns, &ns_len, &set, &set_len, &z_where, &select_bins, &z_policy) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to queryIterator", false);
+		RETURN_NULL();
+	}
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_NULL();
+	}
+
+	if (zval_to_as_policy_query(z_policy, &query_policy,
+			&query_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->query, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid query policy", false);
+		RETURN_NULL();
+	}
+
+	if (set_iterator_queue_size_from_policy_hash(&queue_size, z_policy) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid value for OPT_ITERATOR_QUEUE_SIZE", false);
+		RETURN_NULL();
+	}
+
+	iterator = aerospike_record_iterator_new(return_value, getThis(), queue_size);
+	iterator->stream.is_query = true;
+	iterator->stream.query_policy = query_policy;
+	/* The predicates point into the where array rather than copying its strings */
+	ZVAL_COPY(&iterator->z_where, z_where);
+	/* And the policy to the filter expression of the options */
+	if (z_policy) {
+		ZVAL_COPY(&iterator->z_policy, z_policy);
+	}
+
+	if (init_query_from_php(&iterator->stream.query, ns, set, Z_ARRVAL(iterator->z_where), select_bins,
+			z_policy, php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+	iterator->stream.query_initialized = true;
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Query Aerospike::prepareQuery( string ns, string set, array where [, array select [, array options ]] )
+    Prepares a query to run repeatedly, with the value of the where predicate bound on each run. The val
+    entry of the predicate may then be left out */
+PHP_METHOD(Aerospike, prepareQuery) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	AerospikePreparedQuery* prepared = NULL;
+	as_error err;
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+	zval* z_where = NULL;
+	HashTable* select_bins = NULL;
+	zval* z_policy = NULL;
+	as_policy_query* query_policy_p = NULL;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_NULL();
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ssa|h!z",
+			&ns, &ns_len, &set, &set_len, &z_where, &select_bins, &z_policy) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to prepareQuery", false);
+		RETURN_NULL();
+	}
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, aerospike_query_ce);
+	prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(return_value));
+	ZVAL_COPY(&prepared->z_client, getThis());
+	/* The predicate points into the where array, and the policy to the filter expression of the options */
+	ZVAL_ARR(&prepared->z_where, zend_array_dup(Z_ARRVAL_P(z_where)));
+	if (z_policy) {
+		ZVAL_COPY(&prepared->z_policy, z_policy);
+	}
+
+	if (zval_to_as_policy_query(z_policy, &prepared->query_policy,
+			&query_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->query, php_client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid query policy");
+		goto CLEANUP;
+	}
+
+	if (set_iterator_queue_size_from_policy_hash(&prepared->queue_size, z_policy) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid value for OPT_ITERATOR_QUEUE_SIZE");
+		goto CLEANUP;
+	}
+
+	if (zend_hash_num_elements(Z_ARRVAL(prepared->z_where))) {
+		if (parse_predicate_from_php(Z_ARRVAL(prepared->z_where), &prepared->predicate, &err) != AEROSPIKE_OK) {
+			goto CLEANUP;
 		}
+		prepared->has_predicate = true;
+	}
+
+	if (init_query_from_php(&prepared->query, ns, set, NULL, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	prepared->initialized = true;
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Query::execute( callback record_cb [, mixed val [, string &cursor ]] )
+    Runs the query with val as the value of its where predicate, the value it was prepared with when
+    val is null. With a cursor only a page of records is returned, as by Aerospike::query() */
+PHP_METHOD(AerospikeQuery, execute) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* php_client = NULL;
+	as_error err;
+	zend_fcall_info callback_info;
+	zend_fcall_info_cache callback_cache;
+	zval* z_val = NULL;
+	zval* z_cursor = NULL;
+	user_callback_function callback_function_data;
+	as_partitions_status* parts_all = NULL;
+	as_php_record_stream stream;
+	bool stream_initialized = false;
+
+	as_error_init(&err);
+
+	if (!(php_client = get_prepared_query_client(prepared, &err))) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "f|z!z/",
+			&callback_info, &callback_cache, &z_val, &z_cursor) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to Aerospike\\Query::execute");
+		goto CLEANUP;
+	}
+
+	if (query_cursor_from_zval(z_cursor, &parts_all, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
 	}
 
 	callback_function_data.callback = callback_info;
 	callback_function_data.callback_cache = callback_cache;
 	callback_function_data.err = &err;
-	callback_function_data.cb_mutex = &AEROSPIKE_G(query_cb_mutex);
+	callback_function_data.cursor = NULL;
+
+	as_php_record_stream_init(&stream, php_client->as_client, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream_initialized = true;
+	stream.is_query = true;
+	stream.query_policy = prepared->query_policy;
+
+	if (as_php_prepared_query_copy(prepared, z_val, &stream.query, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	stream.query_initialized = true;
+
+	execute_query_stream(&stream, &callback_function_data, z_cursor, parts_all);
+
+CLEANUP:
+	if (stream_initialized) {
+		as_php_record_stream_destroy(&stream);
+	}
+	if (parts_all) {
+		as_partitions_status_release(parts_all);
+	}
+
+	if (err.code != AEROSPIKE_OK && Z_TYPE(prepared->z_client) == IS_OBJECT) {
+		update_client_error(&prepared->z_client, err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\RecordIterator Aerospike\Query::iterator( [ mixed val ] )
+    Returns an iterator over the records matching the where predicate with val as its value */
+PHP_METHOD(AerospikeQuery, iterator) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeRecordIterator* iterator = NULL;
+	as_error err;
+	zval* z_val = NULL;
+
+	as_error_init(&err);
+
+	if (!get_prepared_query_client(prepared, &err)) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "|z!", &z_val) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to Aerospike\\Query::iterator");
+		goto CLEANUP;
+	}
+
+	iterator = aerospike_record_iterator_new(return_value, &prepared->z_client, prepared->queue_size);
+	iterator->stream.is_query = true;
+	iterator->stream.query_policy = prepared->query_policy;
+	/* The predicate points to the bound value, or into the where array of the prepared query */
+	if (z_val) {
+		ZVAL_COPY(&iterator->z_where, z_val);
+	}
+	/* Which also holds the options the policy points to */
+	ZVAL_COPY(&iterator->z_policy, getThis());
+
+	if (as_php_prepared_query_copy(prepared, z_val, &iterator->stream.query, &err) != AEROSPIKE_OK) {
+		zval_ptr_dtor(return_value);
+		goto CLEANUP;
+	}
+	iterator->stream.query_initialized = true;
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(prepared->z_client) == IS_OBJECT) {
+			update_client_error(&prepared->z_client, err.code, err.message, err.in_doubt);
+		}
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/*
+ * Shared by query(), queryIterator() and prepareQuery(). The bin list is heap allocated, since the
+ * query of an iterator outlives the call. predicate_array may be NULL. On failure the query is left
+ * destroyed.
+ */
+static as_status init_query_from_php(as_query* query, char* ns, char* set, HashTable* predicate_array,
+		HashTable* select_bins, zval* z_policy, int serializer_type, as_error* err) {
+	uint32_t select_count = 0;
+	zval* entry = NULL;
+
+	if (!as_query_init(query, ns, set)) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Unable to create query");
+		return err->code;
+	}
+
+	if (z_policy && Z_TYPE_P(z_policy) != IS_NULL) {
+		if (set_query_options_from_policy_hash(query, z_policy) != AEROSPIKE_OK) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid query options");
+			goto CLEANUP;
+		}
+	}
+
+	if (set_read_operations_from_policy_hash(&query->ops, z_policy, err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
 
 	if (select_bins) {
 		select_count = zend_hash_num_elements(select_bins);
+		if (select_count > 0 && query->ops) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Bins can not be selected along with OPT_READ_OPERATIONS");
+			goto CLEANUP;
+		}
 		if (select_count > 0) {
-			as_query_select_inita(&query, select_count);
-
-
-			zval* entry = NULL;
+			as_query_select_init(query, select_count);
 
 			ZEND_HASH_FOREACH_VAL(select_bins, entry)
 			{
 				if (Z_TYPE_P(entry) != IS_STRING) {
-					as_error_update(&err, AEROSPIKE_ERR_PARAM, "Bin names must be strings");
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin names must be strings");
 					goto CLEANUP;
 				}
-				as_query_select(&query, Z_STRVAL_P(entry));
+				as_query_select(query, Z_STRVAL_P(entry));
 			} ZEND_HASH_FOREACH_END();
 		}
 	}
 
-	if (zend_hash_num_elements(predicate_array)) {
-		if (add_predicate_to_query(&query, predicate_array, &err) != AEROSPIKE_OK) {
+	if (predicate_array && zend_hash_num_elements(predicate_array)) {
+		if (add_predicate_to_query(query, predicate_array, err) != AEROSPIKE_OK) {
 			goto CLEANUP;
 		}
 	}
 
-	aerospike_query_foreach(as_client, &err, query_policy_p, &query, user_callback_wrapper, (void*)&callback_function_data);
-
 CLEANUP:
-	if (query_initialized) {
-		as_query_destroy(&query);
+	if (err->code != AEROSPIKE_OK) {
+		as_query_destroy(query);
 	}
+	return err->code;
+}
 
-	if ((err.code) != AEROSPIKE_OK) {
-		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+/* The partitions status of a query cursor, left NULL when the cursor is NULL or not passed */
+static as_status query_cursor_from_zval(zval* z_cursor, as_partitions_status** parts_all, as_error* err) {
+	if (!z_cursor || Z_TYPE_P(z_cursor) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+	if (Z_TYPE_P(z_cursor) != IS_STRING) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "The query cursor must be a string");
+	}
+	return as_php_query_cursor_from_string(Z_STRVAL_P(z_cursor), Z_STRLEN_P(z_cursor), parts_all, err);
+}
+
+/*
+ * Shared by query() and Aerospike\Query::execute(). Runs the query of the stream into the callback,
+ * with a cursor only the page following parts_all is, and the cursor is then set to the next one.
+ */
+static void execute_query_stream(as_php_record_stream* stream, user_callback_function* callback_function_data,
+		zval* z_cursor, as_partitions_status* parts_all) {
+	as_error* err = callback_function_data->err;
+	zval z_next;
+
+	/* Passing a cursor, even NULL, makes the query paginated */
+	if (z_cursor) {
+		stream->use_partition_filter = true;
+		stream->query.paginate = true;
+		as_partition_filter_set_all(&stream->partition_filter);
+		if (parts_all) {
+			as_partition_filter_set_partitions(&stream->partition_filter, parts_all);
+		}
 	}
 
+	execute_user_callback_on_stream(stream, callback_function_data);
 
-	RETURN_LONG(err.code);
+	/*
+	 * The page was handed to the callback as a whole, so the status the C client kept is where the
+	 * next page starts. A page cut short by the callback or by an error is returned again.
+	 */
+	if (z_cursor && err->code == AEROSPIKE_OK && !callback_function_data->stopped) {
+		if (as_query_is_done(&stream->query) || !stream->query.parts_all) {
+			zval_dtor(z_cursor);
+			ZVAL_NULL(z_cursor);
+		} else if (as_php_query_cursor_to_zval(&stream->query, &z_next, err) == AEROSPIKE_OK) {
+			zval_dtor(z_cursor);
+			ZVAL_COPY_VALUE(z_cursor, &z_next);
+		}
+	}
 }
-/* }}} */
-
 
 /* {{{ proto in Aerospike::queryApply( string ns, string set, array where,
  * string module, string function, array args, int &job_id [, array options ] )
@@ -196,7 +548,7 @@ PHP_METHOD(Aerospike, queryApply) {
 
 	bool query_initialized = false;
 
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 	as_query query;
 
 	reset_client_error(getThis());
@@ -208,6 +560,7 @@ PHP_METHOD(Aerospike, queryApply) {
 
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	//7th by ref
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshsshz/|z",
@@ -227,7 +580,7 @@ PHP_METHOD(Aerospike, queryApply) {
 	}
 
 	if (zval_to_as_policy_write(z_policy, &write_policy,
-			&write_policy_p, &as_client->config.policies.write) != AEROSPIKE_OK) {
+			&write_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->write, php_client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -273,33 +626,146 @@ CLEANUP:
 /* }}} */
 
 
+/* {{{ proto int Aerospike::queryOperate( string ns, string set, array where, array operations, int &job_id [, array options ] )
+    Applies write operations to each record matching the where predicate using a background query */
+PHP_METHOD(Aerospike, queryOperate) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	as_error err;
+	as_error_init(&err);
+
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+
+	HashTable* predicate_array = NULL;
+	HashTable* z_ops = NULL;
+
+	uint64_t job_id = 0;
+	zval* z_job_id = NULL;
+	zval* z_policy = NULL;
+	as_policy_write write_policy;
+	as_policy_write* write_policy_p = NULL;
+
+	bool query_initialized = false;
+
+	int serializer_type;
+	as_query query;
+
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_LONG(err.code);
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshhz/|z",
+			&ns, &ns_len, &set, &set_len,
+			&predicate_array, &z_ops,
+			&z_job_id, &z_policy) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to queryOperate", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	zval_dtor(z_job_id);
+	ZVAL_NULL(z_job_id);
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (!zend_hash_num_elements(z_ops)) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Empty operations array", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (zval_to_as_policy_write(z_policy, &write_policy,
+			&write_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->write, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	write_policy_p = &write_policy;
+	set_serializer_from_policy_hash(&serializer_type, z_policy);
+
+	if (!as_query_init(&query, ns, set)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to create query");
+		goto CLEANUP;
+	}
+	query_initialized = true;
+
+	if (zend_hash_num_elements(predicate_array)) {
+		if (add_predicate_to_query(&query, predicate_array, &err) != AEROSPIKE_OK) {
+			goto CLEANUP;
+		}
+	}
+
+	/* The query owns its operations, the ttl of a touch or of OPT_TTL applies to every record */
+	query.ops = as_operations_new(zend_hash_num_elements(z_ops));
+	if (z_hashtable_to_as_operations(z_ops, z_policy, query.ops, &err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (!as_php_operations_write_only(query.ops)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "A background query only accepts write operations");
+		goto CLEANUP;
+	}
+
+	if (aerospike_query_background(as_client, &err, write_policy_p, &query, &job_id) == AEROSPIKE_OK) {
+		ZVAL_LONG(z_job_id, job_id);
+	}
+
+CLEANUP:
+
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	if (query_initialized) {
+		as_query_destroy(&query);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
 typedef struct _aggregate_cb_data {
 	as_error* err;
 	zval* aggregate_ary;
-} aggregate_cb_data ;
-
+	pthread_mutex_t lock;
+} aggregate_cb_data;
 
-bool aggregate_callback_wrapper(const as_val *val, void *udata) {
-	zval retval;
-	ZVAL_NULL(&retval);
+/* Converts each result as the C client hands it over, see as_php_record_stream_needs_thread */
+static bool aggregate_callback_wrapper(const as_val* val, void* udata) {
 	aggregate_cb_data* cb_data = (aggregate_cb_data*)udata;
-	zval* aggregate_list = cb_data->aggregate_ary;
+	zval retval;
 
 	if (!val) {
 		return false;
 	}
 
+	pthread_mutex_lock(&cb_data->lock);
+	if (cb_data->err->code != AEROSPIKE_OK) {
+		pthread_mutex_unlock(&cb_data->lock);
+		return false;
+	}
+
+	ZVAL_NULL(&retval);
 	as_val_to_zval(val, &retval, cb_data->err);
 	// The conversion failed, bail out
 	if (cb_data->err->code != AEROSPIKE_OK) {
+		zval_dtor(&retval);
+		pthread_mutex_unlock(&cb_data->lock);
 		return false;
 	}
 
-	add_next_index_zval(aggregate_list, &retval);
+	add_next_index_zval(cb_data->aggregate_ary, &retval);
+	pthread_mutex_unlock(&cb_data->lock);
 	return true;
 }
 
-
 /* {{{ proto int Aerospike::aggregate( string ns, string set, array where, string module, string function, array args, mixed &returned [, array options ] )
     Applies a stream UDF to the records matching a query and aggregates the results  */
 PHP_METHOD(Aerospike, aggregate) {
@@ -327,19 +793,17 @@ PHP_METHOD(Aerospike, aggregate) {
 	as_policy_query query_policy;
 	as_policy_query* query_policy_p = NULL;
 
-	bool query_initialized = false;
+	bool stream_initialized = false;
 
-	int serializer_type = INI_INT("aerospike.serializer");
-	as_query query;
+	int serializer_type;
+	as_php_record_stream stream;
 	aggregate_cb_data cb_data;
+	as_error run_err;
+	as_val* value = NULL;
+	zval z_value;
 
 	reset_client_error(getThis());
 
-#ifdef ZTS
-	update_client_error(getThis(), AEROSPIKE_ERR_CLIENT, "aggregate is not supported in ZTS environments", false);
-	RETURN_LONG(AEROSPIKE_ERR_CLIENT);
-#endif
-
 	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, false);
 		RETURN_LONG(err.code);
@@ -347,6 +811,7 @@ PHP_METHOD(Aerospike, aggregate) {
 
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshsshz/|z",
 			&ns, &ns_len, &set, &set_len,
@@ -377,23 +842,25 @@ PHP_METHOD(Aerospike, aggregate) {
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-	if (z_policy && Z_TYPE_P(z_policy) != IS_NULL) {
-		if (zval_to_as_policy_query(z_policy, &query_policy,
-				&query_policy_p, &as_client->config.policies.query) != AEROSPIKE_OK) {
-			update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid query policy", false);
-			RETURN_LONG(AEROSPIKE_ERR_PARAM);
-		}
-		query_policy_p = &query_policy;
+	if (zval_to_as_policy_query(z_policy, &query_policy,
+			&query_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->query, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid query policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-	if (!as_query_init(&query, ns, set)) {
+	as_php_record_stream_init(&stream, as_client, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream_initialized = true;
+	stream.is_query = true;
+	stream.query_policy = query_policy;
+
+	if (!as_query_init(&stream.query, ns, set)) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to create query");
 		goto CLEANUP;
 	}
-	query_initialized = true;
+	stream.query_initialized = true;
 
 	if (zend_hash_num_elements(predicate_array)) {
-		if (add_predicate_to_query(&query, predicate_array, &err) != AEROSPIKE_OK) {
+		if (add_predicate_to_query(&stream.query, predicate_array, &err) != AEROSPIKE_OK) {
 			goto CLEANUP;
 		}
 	}
@@ -403,24 +870,49 @@ PHP_METHOD(Aerospike, aggregate) {
 		goto CLEANUP;
 	}
 
-	if (!as_query_apply(&query, module, function, as_args_list)){
+	if (!as_query_apply(&stream.query, module, function, as_args_list)){
 		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "Unable to initialize Argument list");
 		as_list_destroy(as_args_list);
 		goto CLEANUP;
 	}
 
-	cb_data.aggregate_ary = z_aggregate_result;
-	cb_data.err = &err;
 	array_init(z_aggregate_result);
 
-	if (aerospike_query_foreach(
-			as_client, &err, query_policy_p, &query, aggregate_callback_wrapper, (void*)&cb_data) != AEROSPIKE_OK) {
+	if (!as_php_record_stream_needs_thread(&stream)) {
+		cb_data.aggregate_ary = z_aggregate_result;
+		cb_data.err = &err;
+		pthread_mutex_init(&cb_data.lock, NULL);
+		as_error_init(&run_err);
+		as_php_record_stream_run(&stream, aggregate_callback_wrapper, &cb_data, &run_err);
+		pthread_mutex_destroy(&cb_data.lock);
+		/* A failed conversion wins over the abort it caused */
+		if (err.code == AEROSPIKE_OK) {
+			as_error_copy(&err, &run_err);
+		}
+		goto CLEANUP;
+	}
+
+	/* The results are converted here, the node threads only queue them */
+	if (as_php_record_stream_start(&stream, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	while ((value = as_php_record_stream_next(&stream, &err))) {
+		ZVAL_NULL(&z_value);
+		as_val_to_zval(value, &z_value, &err);
+		as_val_destroy(value);
+		// The conversion failed, bail out
+		if (err.code != AEROSPIKE_OK) {
+			zval_dtor(&z_value);
+			break;
+		}
+		add_next_index_zval(z_aggregate_result, &z_value);
 	}
 
 
 CLEANUP:
-	if (query_initialized) {
-		as_query_destroy(&query);
+	if (stream_initialized) {
+		as_php_record_stream_destroy(&stream);
 	}
 	if (err.code != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
@@ -434,13 +926,35 @@ CLEANUP:
  * returns AEROSPIKE_OK on success, error code on failure
  */
 as_status add_predicate_to_query(as_query* query, const HashTable* z_predicate_val, as_error* err) {
+	as_php_predicate predicate;
+
+	if (zend_hash_num_elements(z_predicate_val) < 3) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid predicate length");
+		return err->code;
+	}
+	if (parse_predicate_from_php(z_predicate_val, &predicate, err) != AEROSPIKE_OK) {
+		return err->code;
+	}
+	if (!predicate.val) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Predicate missing val entry");
+		return err->code;
+	}
+
+	return add_parsed_predicate_to_query(query, &predicate, predicate.val, err);
+}
+
+/*
+ * Read the bin, op and index type of a predicate array. The val entry is left NULL when missing,
+ * a prepared query can have it bound on each run instead.
+ */
+as_status parse_predicate_from_php(const HashTable* z_predicate_val, as_php_predicate* predicate,
+		as_error* err) {
 	zval* bin_val = NULL;
-	char* bin_name = NULL;
-	zval* val_value = NULL;
 	zval* op_val = NULL;
+	zval* index_val = NULL;
 	char* op_str = NULL;
 
-	if (zend_hash_num_elements(z_predicate_val) < 3) {
+	if (zend_hash_num_elements(z_predicate_val) < 2) {
 		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid predicate length");
 		return err->code;
 	}
@@ -454,7 +968,7 @@ as_status add_predicate_to_query(as_query* query, const HashTable* z_predicate_v
 		as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin name must be a string");
 		return err->code;
 	}
-	bin_name = Z_STRVAL_P(bin_val);
+	predicate->bin = Z_STRVAL_P(bin_val);
 
 	op_val = zend_hash_str_find(z_predicate_val, QUERY_WHERE_OP_KEY, strlen(QUERY_WHERE_OP_KEY));
 	if (!op_val) {
@@ -467,37 +981,27 @@ as_status add_predicate_to_query(as_query* query, const HashTable* z_predicate_v
 	}
 	op_str = Z_STRVAL_P(op_val);
 
-	val_value = zend_hash_str_find(z_predicate_val, QUERY_WHERE_VAL_KEY, strlen(QUERY_WHERE_VAL_KEY));
-	if (!val_value) {
-		as_error_update(err, AEROSPIKE_ERR_PARAM, "Predicate missing val entry");
-		return err->code;
-	}
-
-	// Setup the query to accept a where;
-	as_query_where_init(query, 1);
-	// Array had all required keys, delegate based on op type
+	predicate->val = zend_hash_str_find(z_predicate_val, QUERY_WHERE_VAL_KEY, strlen(QUERY_WHERE_VAL_KEY));
+	predicate->index_type = 0;
 
 	if (!strcmp(op_str, PHP_PREDICATE_EQUAL)) {
-		return add_equal_predicate_to_query(query, bin_name, val_value, err);
-	}
-	if (!strcmp(op_str, PHP_PREDICATE_BETWEEN)) {
-		return add_between_predicate_to_query(query, bin_name, val_value, err);
-	}
-	if (!strcmp(op_str, PHP_PREDICATE_CONTAINS)) {
-		zval* index_val = NULL;
-		index_val = zend_hash_str_find(z_predicate_val, QUERY_WHERE_INDEX_TYPE_KEY, strlen(QUERY_WHERE_INDEX_TYPE_KEY));
-		if (!index_val) {
-			as_error_update(err, AEROSPIKE_ERR_PARAM, "Contains predicate requires index_type");
-			return err->code;
-		}
-		if (Z_TYPE_P(index_val) != IS_LONG) {
-			as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid index_type");
-			return err->code;
-		}
-		return add_contains_predicate_to_query(query, bin_name, Z_LVAL_P(index_val), val_value, err);
+		predicate->op = AS_PHP_WHERE_EQUALS;
+	} else if (!strcmp(op_str, PHP_PREDICATE_BETWEEN)) {
+		predicate->op = AS_PHP_WHERE_BETWEEN;
+	} else if (!strcmp(op_str, PHP_PREDICATE_CONTAINS)) {
+		predicate->op = AS_PHP_WHERE_CONTAINS;
+	} else if (!strcmp(op_str, PHP_PREDICATE_RANGE)) {
+		predicate->op = AS_PHP_WHERE_RANGE;
+	} else if (!strcmp(op_str, PHP_PREDICATE_GEO_CONTAINS)) {
+		predicate->op = AS_PHP_WHERE_GEO_CONTAINS;
+	} else if (!strcmp(op_str, PHP_PREDICATE_GEO_WITHIN)) {
+		predicate->op = AS_PHP_WHERE_GEO_WITHIN;
+	} else {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid predicate op");
+		return err->code;
 	}
-	if (!strcmp(op_str, PHP_PREDICATE_RANGE)) {
-		zval* index_val = NULL;
+
+	if (predicate->op == AS_PHP_WHERE_CONTAINS || predicate->op == AS_PHP_WHERE_RANGE) {
 		index_val = zend_hash_str_find(z_predicate_val, QUERY_WHERE_INDEX_TYPE_KEY, strlen(QUERY_WHERE_INDEX_TYPE_KEY));
 		if (!index_val) {
 			as_error_update(err, AEROSPIKE_ERR_PARAM, "Contains predicate requires index_type");
@@ -507,18 +1011,35 @@ as_status add_predicate_to_query(as_query* query, const HashTable* z_predicate_v
 			as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid index_type");
 			return err->code;
 		}
-		return add_range_predicate_to_query(query, bin_name, Z_LVAL_P(index_val), val_value, err);
-	}
-	if (!strcmp(op_str, PHP_PREDICATE_GEO_CONTAINS)) {
-		return add_geo_contains_predicate_to_query(query, bin_name, val_value, err);
-	}
-	if (!strcmp(op_str, PHP_PREDICATE_GEO_WITHIN)) {
-		return add_geo_within_predicate_to_query(query, bin_name, val_value, err);
+		predicate->index_type = Z_LVAL_P(index_val);
 	}
 
-	as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid predicate op");
-	return err->code;
+	return AEROSPIKE_OK;
+}
 
+/* Add a parsed predicate to the query, with val as its value */
+as_status add_parsed_predicate_to_query(as_query* query, const as_php_predicate* predicate, zval* val,
+		as_error* err) {
+	// Setup the query to accept a where;
+	as_query_where_init(query, 1);
+
+	switch (predicate->op) {
+		case AS_PHP_WHERE_EQUALS:
+			return add_equal_predicate_to_query(query, predicate->bin, val, err);
+		case AS_PHP_WHERE_BETWEEN:
+			return add_between_predicate_to_query(query, predicate->bin, val, err);
+		case AS_PHP_WHERE_CONTAINS:
+			return add_contains_predicate_to_query(query, predicate->bin, predicate->index_type, val, err);
+		case AS_PHP_WHERE_RANGE:
+			return add_range_predicate_to_query(query, predicate->bin, predicate->index_type, val, err);
+		case AS_PHP_WHERE_GEO_CONTAINS:
+			return add_geo_contains_predicate_to_query(query, predicate->bin, val, err);
+		case AS_PHP_WHERE_GEO_WITHIN:
+			return add_geo_within_predicate_to_query(query, predicate->bin, val, err);
+		default:
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid predicate op");
+			return err->code;
+	}
 }
 
 as_status add_equal_predicate_to_query(as_query* query, char* bin_name, zval* val, as_error* err) {
@@ -0,0 +1,241 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "php_aerospike.h"
+#include "zend_interfaces.h"
+#include "aerospike/as_error.h"
+#include "aerospike_class.h"
+#include "record_iterator.h"
+#include "php_aerospike_types.h"
+#include "conversions.h"
+
+/*
+ * Pull based scans and queries.
+ *
+ * scan() and query() drain their record stream into the callback in a single call, an iterator
+ * instead takes one record each time the application asks for the next one. The node threads are
+ * held back only when the application is slower than the cluster. Leaving a foreach early cancels
+ * the scan at the next record.
+ */
+
+zend_class_entry* aerospike_record_iterator_ce;
+static zend_object_handlers aerospike_record_iterator_handlers;
+
+static zend_object* aerospike_record_iterator_create_object(zend_class_entry* ce);
+static void aerospike_record_iterator_free_storage(zend_object* object);
+static AerospikeRecordIterator* get_aerospike_record_iterator_from_zobj(zend_object* zobj);
+static void record_iterator_fetch(AerospikeRecordIterator* iterator);
+
+PHP_METHOD(AerospikeRecordIterator, __construct) {}
+
+static zend_function_entry aerospike_record_iterator_class_functions[] =
+{
+	PHP_ME(AerospikeRecordIterator, __construct, NULL, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+	PHP_ME(AerospikeRecordIterator, current, record_iterator_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeRecordIterator, key, record_iterator_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeRecordIterator, next, record_iterator_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeRecordIterator, rewind, record_iterator_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_ME(AerospikeRecordIterator, valid, record_iterator_no_arg_info, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+bool register_aerospike_record_iterator_class(void) {
+	zend_class_entry ce;
+	INIT_NS_CLASS_ENTRY(ce, "Aerospike", "RecordIterator", aerospike_record_iterator_class_functions);
+	aerospike_record_iterator_ce = zend_register_internal_class(&ce);
+	aerospike_record_iterator_ce->ce_flags |= ZEND_ACC_FINAL;
+	aerospike_record_iterator_ce->create_object = aerospike_record_iterator_create_object;
+	aerospike_record_iterator_ce->serialize = zend_class_serialize_deny;
+	aerospike_record_iterator_ce->unserialize = zend_class_unserialize_deny;
+	zend_class_implements(aerospike_record_iterator_ce, 1, zend_ce_iterator);
+
+	memcpy(&aerospike_record_iterator_handlers, zend_get_std_object_handlers(),
+			sizeof(aerospike_record_iterator_handlers));
+	aerospike_record_iterator_handlers.free_obj = aerospike_record_iterator_free_storage;
+	aerospike_record_iterator_handlers.clone_obj = NULL;
+	aerospike_record_iterator_handlers.offset = XtOffsetOf(AerospikeRecordIterator, zobj);
+
+	return true;
+}
+
+static AerospikeRecordIterator* get_aerospike_record_iterator_from_zobj(zend_object* zobj) {
+	return (AerospikeRecordIterator*)((char*)zobj - XtOffsetOf(AerospikeRecordIterator, zobj));
+}
+
+static zend_object* aerospike_record_iterator_create_object(zend_class_entry* ce) {
+	AerospikeRecordIterator* iterator = ecalloc(1, sizeof(*iterator) + zend_object_properties_size(ce));
+
+	ZVAL_UNDEF(&iterator->z_client);
+	ZVAL_UNDEF(&iterator->z_where);
+	ZVAL_UNDEF(&iterator->z_policy);
+	ZVAL_UNDEF(&iterator->z_current);
+
+	zend_object_std_init(&iterator->zobj, ce);
+	object_properties_init(&iterator->zobj, ce);
+	iterator->zobj.handlers = &aerospike_record_iterator_handlers;
+
+	return &iterator->zobj;
+}
+
+static void aerospike_record_iterator_free_storage(zend_object* object) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(object);
+
+	/* The stream is set up along with the client */
+	if (Z_TYPE(iterator->z_client) != IS_UNDEF) {
+		as_php_record_stream_destroy(&iterator->stream);
+	}
+
+	zval_ptr_dtor(&iterator->z_current);
+	zval_ptr_dtor(&iterator->z_where);
+	zval_ptr_dtor(&iterator->z_policy);
+	zval_ptr_dtor(&iterator->z_client);
+	zend_object_std_dtor(object);
+}
+
+/* Create the iterator object in z_iterator, the caller then sets up the scan or query of its stream */
+AerospikeRecordIterator* aerospike_record_iterator_new(zval* z_iterator, zval* z_client, uint32_t queue_size) {
+	AerospikeRecordIterator* iterator = NULL;
+
+	object_init_ex(z_iterator, aerospike_record_iterator_ce);
+	iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(z_iterator));
+
+	as_php_record_stream_init(&iterator->stream, get_aerospike_from_zobj(Z_OBJ_P(z_client))->as_client, queue_size);
+	ZVAL_COPY(&iterator->z_client, z_client);
+
+	return iterator;
+}
+
+/* Move to the next record. Once the scan or query is over its error, if any, is reported on the client */
+static void record_iterator_fetch(AerospikeRecordIterator* iterator) {
+	as_record* record = NULL;
+	as_error err;
+
+	zval_ptr_dtor(&iterator->z_current);
+	ZVAL_UNDEF(&iterator->z_current);
+
+	if (iterator->finished) {
+		return;
+	}
+
+	as_error_init(&err);
+	record = (as_record*)as_php_record_stream_next(&iterator->stream, &err);
+
+	if (record) {
+		as_record_to_zval(record, &iterator->z_current, NULL, true, &err);
+		as_record_destroy(record);
+		if (err.code == AEROSPIKE_OK) {
+			return;
+		}
+		zval_ptr_dtor(&iterator->z_current);
+		ZVAL_UNDEF(&iterator->z_current);
+	}
+
+	iterator->finished = true;
+	as_php_record_stream_stop(&iterator->stream);
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(&iterator->z_client, err.code, err.message, err.in_doubt);
+	}
+}
+
+/* {{{ proto void Aerospike\RecordIterator::rewind( )
+    Starts the scan or query. An iterator can only be walked once, later calls do nothing */
+PHP_METHOD(AerospikeRecordIterator, rewind) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(getThis()));
+	as_error err;
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if (iterator->stream.thread_started || iterator->finished) {
+		return;
+	}
+
+	as_error_init(&err);
+	if (as_php_record_stream_start(&iterator->stream, &err) != AEROSPIKE_OK) {
+		iterator->finished = true;
+		update_client_error(&iterator->z_client, err.code, err.message, err.in_doubt);
+		return;
+	}
+
+	iterator->position = 0;
+	record_iterator_fetch(iterator);
+}
+/* }}} */
+
+/* {{{ proto bool Aerospike\RecordIterator::valid( ) */
+PHP_METHOD(AerospikeRecordIterator, valid) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(Z_TYPE(iterator->z_current) != IS_UNDEF);
+}
+/* }}} */
+
+/* {{{ proto array Aerospike\RecordIterator::current( )
+    The record, in the form passed to the callback of scan() */
+PHP_METHOD(AerospikeRecordIterator, current) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE(iterator->z_current) == IS_UNDEF) {
+		RETURN_NULL();
+	}
+
+	RETURN_ZVAL(&iterator->z_current, 1, 0);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\RecordIterator::key( )
+    The position of the record in the iteration */
+PHP_METHOD(AerospikeRecordIterator, key) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (Z_TYPE(iterator->z_current) == IS_UNDEF) {
+		RETURN_NULL();
+	}
+
+	RETURN_LONG(iterator->position);
+}
+/* }}} */
+
+/* {{{ proto void Aerospike\RecordIterator::next( ) */
+PHP_METHOD(AerospikeRecordIterator, next) {
+	AerospikeRecordIterator* iterator = get_aerospike_record_iterator_from_zobj(Z_OBJ_P(getThis()));
+
+	if (zend_parse_parameters_none() == FAILURE) {
+		return;
+	}
+
+	if (!iterator->stream.thread_started) {
+		return;
+	}
+
+	iterator->position++;
+	record_iterator_fetch(iterator);
+}
+/* }}} */
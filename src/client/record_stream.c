@@ -0,0 +1,274 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "aerospike/aerospike_scan.h"
+#include "aerospike/aerospike_query.h"
+#include "aerospike/as_nil.h"
+#include "aerospike/as_record.h"
+#include "aerospike_async.h"
+#include "record_stream.h"
+
+/*
+ * Nothing in here may use the Zend engine: besides the PHP thread, it runs on the stream
+ * thread and on the C client node threads, which have no PHP context even in ZTS builds.
+ * Only scanIterator(), queryIterator() and the callbacks that cannot run on the calling thread
+ * start a stream thread, the rest run the scan or query with as_php_record_stream_run.
+ */
+
+static void* record_stream_thread(void* udata);
+static bool record_stream_callback(const as_val* val, void* udata);
+static as_val* copy_stream_value(const as_val* val);
+static void copy_record_key(as_key* dst, const as_key* src);
+
+/*
+ * The caller then sets up the scan or query of the stream. The queue is malloc'd,
+ * since node threads write to it.
+ */
+void as_php_record_stream_init(as_php_record_stream* stream, aerospike* as, uint32_t capacity) {
+	memset(stream, 0, sizeof(*stream));
+
+	pthread_mutex_init(&stream->lock, NULL);
+	pthread_cond_init(&stream->not_empty, NULL);
+	pthread_cond_init(&stream->not_full, NULL);
+	as_error_init(&stream->err);
+
+	stream->as = as;
+	stream->capacity = capacity;
+	stream->values = (as_val**)calloc(capacity, sizeof(as_val*));
+}
+
+as_status as_php_record_stream_start(as_php_record_stream* stream, as_error* err) {
+	if (!stream->values) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to allocate the record queue");
+	}
+
+	/* A stream runs again once the previous run was stopped */
+	stream->producer_done = false;
+	stream->cancelled = false;
+	as_error_reset(&stream->err);
+
+	if (pthread_create(&stream->thread, NULL, record_stream_thread, stream) != 0) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to start the scan thread");
+	}
+
+	stream->thread_started = true;
+	return AEROSPIKE_OK;
+}
+
+/*
+ * Take the next value, waiting for one if the queue is empty. NULL once the scan or query is over,
+ * with its error, if any, in err. The caller owns the value returned.
+ */
+as_val* as_php_record_stream_next(as_php_record_stream* stream, as_error* err) {
+	as_val* value = NULL;
+
+	if (!stream->thread_started) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&stream->lock);
+	while (!stream->count && !stream->producer_done) {
+		pthread_cond_wait(&stream->not_empty, &stream->lock);
+	}
+	if (stream->count) {
+		value = stream->values[stream->head];
+		stream->head = (stream->head + 1) % stream->capacity;
+		stream->count--;
+		pthread_cond_signal(&stream->not_full);
+	} else {
+		as_error_copy(err, &stream->err);
+	}
+	pthread_mutex_unlock(&stream->lock);
+
+	return value;
+}
+
+/* Cancel the scan or query, wait for its thread and drop the values nobody will read */
+void as_php_record_stream_stop(as_php_record_stream* stream) {
+	if (!stream->thread_started) {
+		return;
+	}
+
+	pthread_mutex_lock(&stream->lock);
+	stream->cancelled = true;
+	pthread_cond_broadcast(&stream->not_full);
+	pthread_mutex_unlock(&stream->lock);
+
+	pthread_join(stream->thread, NULL);
+	stream->thread_started = false;
+
+	while (stream->count) {
+		as_val_destroy(stream->values[stream->head]);
+		stream->head = (stream->head + 1) % stream->capacity;
+		stream->count--;
+	}
+}
+
+void as_php_record_stream_destroy(as_php_record_stream* stream) {
+	as_php_record_stream_stop(stream);
+
+	if (stream->values) {
+		free(stream->values);
+		stream->values = NULL;
+	}
+	if (stream->scan_initialized) {
+		as_scan_destroy(&stream->scan);
+		stream->scan_initialized = false;
+	}
+	if (stream->query_initialized) {
+		as_query_destroy(&stream->query);
+		stream->query_initialized = false;
+	}
+	pthread_cond_destroy(&stream->not_full);
+	pthread_cond_destroy(&stream->not_empty);
+	pthread_mutex_destroy(&stream->lock);
+}
+
+/*
+ * Run the scan or query on the calling thread, handing each value to callback. Where callback
+ * runs depends on the C client, see as_php_record_stream_needs_thread.
+ */
+as_status as_php_record_stream_run(as_php_record_stream* stream, aerospike_scan_foreach_callback callback,
+		void* udata, as_error* err) {
+	if (stream->is_query && stream->use_partition_filter) {
+		return aerospike_query_partitions(stream->as, err, &stream->query_policy, &stream->query,
+				&stream->partition_filter, callback, udata);
+	}
+	if (stream->is_query) {
+		return aerospike_query_foreach(stream->as, err, &stream->query_policy, &stream->query,
+				callback, udata);
+	}
+	if (stream->use_partition_filter) {
+		return aerospike_scan_partitions(stream->as, err, &stream->scan_policy, &stream->scan,
+				&stream->partition_filter, callback, udata);
+	}
+	return aerospike_scan_foreach(stream->as, err, &stream->scan_policy, &stream->scan,
+			callback, udata);
+}
+
+/*
+ * Whether the values have to go through the queue of a stream thread for a callback into PHP.
+ * The C client calls back on the calling thread, except for queries and concurrent scans, which
+ * it spreads over its thread pool. NTS builds can still enter PHP from those threads one at a
+ * time, ZTS builds cannot.
+ */
+bool as_php_record_stream_needs_thread(as_php_record_stream* stream) {
+#ifdef ZTS
+	return stream->is_query || stream->scan.concurrent;
+#else
+	return false;
+#endif
+}
+
+static void* record_stream_thread(void* udata) {
+	as_php_record_stream* stream = (as_php_record_stream*)udata;
+	as_error err;
+
+	as_error_init(&err);
+
+	as_php_record_stream_run(stream, record_stream_callback, stream, &err);
+
+	pthread_mutex_lock(&stream->lock);
+	stream->producer_done = true;
+	as_error_copy(&stream->err, &err);
+	pthread_cond_broadcast(&stream->not_empty);
+	pthread_mutex_unlock(&stream->lock);
+
+	return NULL;
+}
+
+/* Runs on the C client node threads, possibly several at once */
+static bool record_stream_callback(const as_val* val, void* udata) {
+	as_php_record_stream* stream = (as_php_record_stream*)udata;
+	as_val* value = NULL;
+	uint32_t tail;
+
+	/* The end of the scan or query */
+	if (!val) {
+		return false;
+	}
+
+	/* Copy before taking the lock, so node threads only contend for the queue slot */
+	value = copy_stream_value(val);
+
+	pthread_mutex_lock(&stream->lock);
+	while (stream->count == stream->capacity && !stream->cancelled) {
+		pthread_cond_wait(&stream->not_full, &stream->lock);
+	}
+
+	if (stream->cancelled) {
+		pthread_mutex_unlock(&stream->lock);
+		as_val_destroy(value);
+		return false;
+	}
+
+	tail = (stream->head + stream->count) % stream->capacity;
+	stream->values[tail] = value;
+	stream->count++;
+	pthread_cond_signal(&stream->not_empty);
+	pthread_mutex_unlock(&stream->lock);
+
+	return true;
+}
+
+/* Records point into the response buffer, aggregation results are copied like bin values */
+static as_val* copy_stream_value(const as_val* val) {
+	as_record* record = as_record_fromval(val);
+	as_record* record_copy = NULL;
+	as_val* value_copy = NULL;
+
+	if (record) {
+		record_copy = as_php_copy_record(record);
+		copy_record_key(&record_copy->key, &record->key);
+		return (as_val*)record_copy;
+	}
+
+	value_copy = as_php_copy_val((as_val*)val);
+	return value_copy ? value_copy : as_val_reserve(&as_nil);
+}
+
+/* The digest and namespace are enough for as_record_to_zval, the user key is copied if it was sent */
+static void copy_record_key(as_key* dst, const as_key* src) {
+	as_val* value = (as_val*)src->valuep;
+	as_bytes* bytes = NULL;
+	uint8_t* bytes_copy = NULL;
+
+	as_key_init_digest(dst, src->ns, src->set, src->digest.value);
+
+	if (!value) {
+		return;
+	}
+
+	switch (as_val_type(value)) {
+		case AS_INTEGER:
+			as_integer_init((as_integer*)&dst->value, as_integer_get((as_integer*)value));
+			dst->valuep = &dst->value;
+			break;
+		case AS_STRING:
+			as_string_init((as_string*)&dst->value, strdup(as_string_get((as_string*)value)), true);
+			dst->valuep = &dst->value;
+			break;
+		case AS_BYTES:
+			bytes = (as_bytes*)value;
+			bytes_copy = (uint8_t*)malloc(bytes->size);
+			memcpy(bytes_copy, bytes->value, bytes->size);
+			as_bytes_init_wrap((as_bytes*)&dst->value, bytes_copy, bytes->size, true);
+			dst->valuep = &dst->value;
+			break;
+		default:
+			break;
+	}
+}
@@ -46,13 +46,17 @@ PHP_METHOD(Aerospike, remove)
 	}
 	as_ptr = client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|z", &z_key, &z_remove_options) != SUCCESS) {
+	ZEND_PARSE_PARAMETERS_START_EX(0, 1, 2)
+		Z_PARAM_ARRAY_HT(z_key)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_ZVAL(z_remove_options)
+	ZEND_PARSE_PARAMETERS_END_EX(
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid Parameters for remove", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
-	}
+	);
 
 	if (zval_to_as_policy_remove(z_remove_options, &remove_policy,
-			&remove_policy_p, &as_ptr->config.policies.remove) != AEROSPIKE_OK) {
+			&remove_policy_p, &get_key_policies(client, z_key)->remove, client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid remove policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -66,6 +70,7 @@ PHP_METHOD(Aerospike, remove)
 	key_initialized = true;
 
 	as_status status = aerospike_key_remove(as_ptr, &err, remove_policy_p, &key);
+	deliver_pending_log_events();
 
 	if (key_initialized) {
 		as_key_destroy(&key);
@@ -61,7 +61,7 @@ PHP_METHOD(Aerospike, removeBin)
 	}
 
 	if (zval_to_as_policy_write(z_write_policy, &write_policy,
-			&write_policy_p, &as_ptr->config.policies.write) != AEROSPIKE_OK) {
+			&write_policy_p, &get_key_policies(client, z_key)->write, client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid policy to removeBin", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
@@ -21,7 +21,14 @@
 #include "user_callbacks.h"
 #include "aerospike/aerospike_scan.h"
 #include "policy_conversions.h"
+#include "record_iterator.h"
+#include "scan_partitions.h"
+#include "prepared_query.h"
 
+static as_status init_scan_from_php(as_scan* scan, char* ns, char* set, HashTable* select_bins,
+		zval* z_policy, int serializer_type, as_error* err);
+static void scan_partitions_from_cursor(aerospike* as, as_scan* scan, as_policy_scan* scan_policy,
+		zend_long begin, zend_long count, user_callback_function* callback_function_data, zval* z_cursor);
 
 /* {{{ proto int Aerospike::scan( string ns, string set, callback record_cb [, array select [, array options ]] )
     Returns all the records in a set to a callback method  */
@@ -37,12 +44,11 @@ PHP_METHOD(Aerospike, scan) {
 	size_t set_len = 0;
 	size_t ns_len = 0;
 	HashTable* select_bins = NULL;
-	uint32_t select_count = 0;
 	user_callback_function callback_function_data;
 	zval* z_policy = NULL; //Figure this out need as_policy_scan converter
 	as_policy_scan scan_policy;
 	as_policy_scan* scan_policy_p = NULL;
-	bool scan_initialized = false;
+	as_php_record_stream stream;
 
 	reset_client_error(getThis());
 
@@ -68,58 +74,518 @@ PHP_METHOD(Aerospike, scan) {
 	}
 
 	if (zval_to_as_policy_scan(z_policy, &scan_policy,
-			&scan_policy_p, &as_client->config.policies.scan) != AEROSPIKE_OK) {
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid scan policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+
+	callback_info.retval = NULL;
+	callback_function_data.err = &err;
+	callback_function_data.callback = callback_info;
+	callback_function_data.callback_cache = callback_cache;
+	callback_function_data.cursor = NULL;
+
+	as_php_record_stream_init(&stream, as_client, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream.scan_policy = scan_policy;
+
+	if (init_scan_from_php(&stream.scan, ns, set, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	stream.scan_initialized = true;
+
+	execute_user_callback_on_stream(&stream, &callback_function_data);
+
+CLEANUP:
+	as_php_record_stream_destroy(&stream);
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike::scanPartitions( string ns, string set, int begin, int count, callback record_cb [, array select [, array options [, string &cursor ]]] )
+    Returns the records of the partitions begin to begin + count - 1 to a callback method, resuming from cursor if it is set */
+PHP_METHOD(Aerospike, scanPartitions) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	as_error err;
+	zend_fcall_info callback_info;
+	zend_fcall_info_cache callback_cache;
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+	zend_long begin = 0;
+	zend_long count = 0;
+	HashTable* select_bins = NULL;
+	zval* z_policy = NULL;
+	zval* z_cursor = NULL;
+	user_callback_function callback_function_data;
+	as_policy_scan scan_policy;
+	as_policy_scan* scan_policy_p = NULL;
+	as_scan scan;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_LONG(err.code);
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ssllf|h!zz/",
+			&ns, &ns_len, &set, &set_len, &begin, &count, &callback_info, &callback_cache,
+			&select_bins, &z_policy, &z_cursor) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to scanPartitions", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (zval_to_as_policy_scan(z_policy, &scan_policy,
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid scan policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
-	scan_policy_p = &scan_policy;
 
+	if (init_scan_from_php(&scan, ns, set, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_LONG(err.code);
+	}
+
+	callback_info.retval = NULL;
+	callback_function_data.err = &err;
+	callback_function_data.callback = callback_info;
+	callback_function_data.callback_cache = callback_cache;
+
+	scan_partitions_from_cursor(as_client, &scan, &scan_policy, begin, count, &callback_function_data, z_cursor);
+
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/*
+ * Shared by scanPartitions() and Aerospike\Scan::partitions(). Runs the scan over the partitions
+ * begin to begin + count - 1, resuming from the cursor if it is set, then sets the cursor to the
+ * progress made. The scan is handed over and always destroyed.
+ */
+static void scan_partitions_from_cursor(aerospike* as, as_scan* scan, as_policy_scan* scan_policy,
+		zend_long begin, zend_long count, user_callback_function* callback_function_data, zval* z_cursor) {
+	as_error* err = callback_function_data->err;
+	as_php_scan_cursor cursor;
+	as_php_record_stream stream;
+	as_digest digest;
+
+	if (begin < 0 || begin >= AS_PHP_PARTITION_COUNT || count < 1 || count > AS_PHP_PARTITION_COUNT - begin) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid partition range");
+		as_scan_destroy(scan);
+		return;
+	}
+
+	if (z_cursor && Z_TYPE_P(z_cursor) != IS_NULL && Z_TYPE_P(z_cursor) != IS_STRING) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "The scan cursor must be a string");
+		as_scan_destroy(scan);
+		return;
+	}
+
+	as_php_scan_cursor_init(&cursor, (uint16_t)begin, (uint16_t)count);
+	if (z_cursor && Z_TYPE_P(z_cursor) == IS_STRING && Z_STRLEN_P(z_cursor)) {
+		if (as_php_scan_cursor_from_string(&cursor, Z_STRVAL_P(z_cursor), Z_STRLEN_P(z_cursor),
+				err) != AEROSPIKE_OK) {
+			as_php_scan_cursor_destroy(&cursor);
+			as_scan_destroy(scan);
+			return;
+		}
+	}
+
+	/* A finished cursor stays as it is */
+	if (as_php_scan_cursor_is_done(&cursor)) {
+		as_scan_destroy(scan);
+		goto SET_CURSOR;
+	}
+
+	callback_function_data->cursor = &cursor;
+
+	as_php_record_stream_init(&stream, as, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream.scan_policy = *scan_policy;
+	stream.use_partition_filter = true;
+	stream.scan = *scan;
+	stream.scan_initialized = true;
+
+	/*
+	 * Resumed through the public partition filters: a range for each run of partitions not started
+	 * yet, and each started partition on its own, after the last digest the callback was given.
+	 */
+	for (uint16_t i = 0; i < cursor.count && err->code == AEROSPIKE_OK && !callback_function_data->stopped; ) {
+		as_php_partition_progress* progress = &cursor.partitions[i];
+		uint16_t run = 1;
+
+		if (progress->state == AS_PHP_PARTITION_DONE) {
+			i++;
+			continue;
+		}
+
+		if (progress->state == AS_PHP_PARTITION_STARTED) {
+			digest.init = true;
+			memcpy(digest.value, progress->digest, AS_DIGEST_VALUE_SIZE);
+			as_partition_filter_set_digest(&stream.partition_filter, &digest);
+		} else {
+			while (i + run < cursor.count && cursor.partitions[i + run].state == AS_PHP_PARTITION_PENDING) {
+				run++;
+			}
+			as_partition_filter_set_range(&stream.partition_filter, (uint32_t)(cursor.begin + i), run);
+		}
+
+		execute_user_callback_on_stream(&stream, callback_function_data);
+		if (err->code == AEROSPIKE_OK && !callback_function_data->stopped) {
+			as_php_scan_cursor_finish(&cursor, i, run);
+		}
+		i += run;
+	}
+	callback_function_data->cursor = NULL;
+
+	as_php_record_stream_destroy(&stream);
+
+SET_CURSOR:
+	/* The progress is kept even when the scan failed part way */
+	if (z_cursor) {
+		zval_dtor(z_cursor);
+		as_php_scan_cursor_to_zval(&cursor, z_cursor);
+	}
+	as_php_scan_cursor_destroy(&cursor);
+}
+
+/* {{{ proto Aerospike\RecordIterator Aerospike::scanIterator( string ns, string set [, array select [, array options ]] )
+    Returns an iterator over the records of a set, read as the application iterates */
+PHP_METHOD(Aerospike, scanIterator) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	AerospikeRecordIterator* iterator = NULL;
+	as_error err;
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+	HashTable* select_bins = NULL;
+	zval* z_policy = NULL;
+	as_policy_scan scan_policy;
+	as_policy_scan* scan_policy_p = NULL;
+	uint32_t queue_size = 0;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_NULL();
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ss|h!z",
+			&ns, &ns_len, &set, &set_len, &select_bins, &z_policy) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to scanIterator", false);
+		RETURN_NULL();
+	}
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_NULL();
+	}
+
+	if (zval_to_as_policy_scan(z_policy, &scan_policy,
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid scan policy", false);
+		RETURN_NULL();
+	}
+
+	if (set_iterator_queue_size_from_policy_hash(&queue_size, z_policy) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid value for OPT_ITERATOR_QUEUE_SIZE", false);
+		RETURN_NULL();
+	}
+
+	iterator = aerospike_record_iterator_new(return_value, getThis(), queue_size);
+	iterator->stream.scan_policy = scan_policy;
+	/* The policy points to the filter expression of the options */
+	if (z_policy) {
+		ZVAL_COPY(&iterator->z_policy, z_policy);
+	}
+
+	if (init_scan_from_php(&iterator->stream.scan, ns, set, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+	iterator->stream.scan_initialized = true;
+}
+/* }}} */
+
+/* {{{ proto Aerospike\Scan Aerospike::prepareScan( string ns, string set [, array select [, array options ]] )
+    Prepares a scan to run repeatedly */
+PHP_METHOD(Aerospike, prepareScan) {
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	AerospikePreparedQuery* prepared = NULL;
+	as_error err;
+	char* set = NULL;
+	char* ns = NULL;
+	size_t set_len = 0;
+	size_t ns_len = 0;
+	HashTable* select_bins = NULL;
+	zval* z_policy = NULL;
+	as_policy_scan* scan_policy_p = NULL;
+
+	as_error_init(&err);
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_NULL();
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "ss|h!z",
+			&ns, &ns_len, &set, &set_len, &select_bins, &z_policy) != SUCCESS) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid arguments to prepareScan", false);
+		RETURN_NULL();
+	}
+
+	if (!ns_len) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid namespace", false);
+		RETURN_NULL();
+	}
+
+	object_init_ex(return_value, aerospike_scan_ce);
+	prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(return_value));
+	ZVAL_COPY(&prepared->z_client, getThis());
+	/* The policy points to the filter expression of the options */
+	if (z_policy) {
+		ZVAL_COPY(&prepared->z_policy, z_policy);
+	}
+
+	if (zval_to_as_policy_scan(z_policy, &prepared->scan_policy,
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid scan policy");
+		goto CLEANUP;
+	}
+
+	if (set_iterator_queue_size_from_policy_hash(&prepared->queue_size, z_policy) != AEROSPIKE_OK) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid value for OPT_ITERATOR_QUEUE_SIZE");
+		goto CLEANUP;
+	}
+
+	if (init_scan_from_php(&prepared->scan, ns, set, select_bins, z_policy,
+			php_client->serializer_type, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	prepared->initialized = true;
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+		zval_ptr_dtor(return_value);
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Scan::execute( callback record_cb )
+    Runs the scan, returning all the records of the set to a callback method */
+PHP_METHOD(AerospikeScan, execute) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* php_client = NULL;
+	as_error err;
+	zend_fcall_info callback_info;
+	zend_fcall_info_cache callback_cache;
+	user_callback_function callback_function_data;
+	as_php_record_stream stream;
+	bool stream_initialized = false;
+
+	as_error_init(&err);
+
+	if (!(php_client = get_prepared_query_client(prepared, &err))) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "f", &callback_info, &callback_cache) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to Aerospike\\Scan::execute");
+		goto CLEANUP;
+	}
 
 	callback_info.retval = NULL;
 	callback_function_data.err = &err;
 	callback_function_data.callback = callback_info;
 	callback_function_data.callback_cache = callback_cache;
-	callback_function_data.cb_mutex = &AEROSPIKE_G(query_cb_mutex);
+	callback_function_data.cursor = NULL;
+
+	as_php_record_stream_init(&stream, php_client->as_client, AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE);
+	stream_initialized = true;
+	stream.scan_policy = prepared->scan_policy;
 
-	as_scan user_scan;
-	as_scan_init(&user_scan, ns, set);
-	scan_initialized = true;
+	if (as_php_prepared_scan_copy(prepared, &stream.scan, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+	stream.scan_initialized = true;
 
-	as_status status = set_scan_options_from_policy_hash(&user_scan, z_policy);
+	execute_user_callback_on_stream(&stream, &callback_function_data);
 
-	if (status != AEROSPIKE_OK) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
+CLEANUP:
+	if (stream_initialized) {
+		as_php_record_stream_destroy(&stream);
+	}
+	if (err.code != AEROSPIKE_OK && Z_TYPE(prepared->z_client) == IS_OBJECT) {
+		update_client_error(&prepared->z_client, err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto int Aerospike\Scan::partitions( int begin, int count, callback record_cb [, string &cursor ] )
+    Runs the scan over the partitions begin to begin + count - 1, resuming from cursor if it is set,
+    as Aerospike::scanPartitions() does */
+PHP_METHOD(AerospikeScan, partitions) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeClient* php_client = NULL;
+	as_error err;
+	zend_fcall_info callback_info;
+	zend_fcall_info_cache callback_cache;
+	zend_long begin = 0;
+	zend_long count = 0;
+	zval* z_cursor = NULL;
+	user_callback_function callback_function_data;
+	as_scan scan;
+
+	as_error_init(&err);
+
+	if (!(php_client = get_prepared_query_client(prepared, &err))) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "llf|z/",
+			&begin, &count, &callback_info, &callback_cache, &z_cursor) != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to Aerospike\\Scan::partitions");
+		goto CLEANUP;
+	}
+
+	if (as_php_prepared_scan_copy(prepared, &scan, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	callback_info.retval = NULL;
+	callback_function_data.err = &err;
+	callback_function_data.callback = callback_info;
+	callback_function_data.callback_cache = callback_cache;
+
+	scan_partitions_from_cursor(php_client->as_client, &scan, &prepared->scan_policy, begin, count,
+			&callback_function_data, z_cursor);
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK && Z_TYPE(prepared->z_client) == IS_OBJECT) {
+		update_client_error(&prepared->z_client, err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
+
+/* {{{ proto Aerospike\RecordIterator Aerospike\Scan::iterator( )
+    Returns an iterator over the records of the set, read as the application iterates */
+PHP_METHOD(AerospikeScan, iterator) {
+	AerospikePreparedQuery* prepared = get_aerospike_prepared_query_from_zobj(Z_OBJ_P(getThis()));
+	AerospikeRecordIterator* iterator = NULL;
+	as_error err;
+
+	as_error_init(&err);
+
+	if (!get_prepared_query_client(prepared, &err)) {
+		goto CLEANUP;
+	}
+
+	if (zend_parse_parameters_none() != SUCCESS) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid arguments to Aerospike\\Scan::iterator");
+		goto CLEANUP;
+	}
+
+	iterator = aerospike_record_iterator_new(return_value, &prepared->z_client, prepared->queue_size);
+	iterator->stream.scan_policy = prepared->scan_policy;
+	/* The prepared scan holds the options the policy points to */
+	ZVAL_COPY(&iterator->z_policy, getThis());
+
+	if (as_php_prepared_scan_copy(prepared, &iterator->stream.scan, &err) != AEROSPIKE_OK) {
+		zval_ptr_dtor(return_value);
+		goto CLEANUP;
+	}
+	iterator->stream.scan_initialized = true;
+
+CLEANUP:
+	if (err.code != AEROSPIKE_OK) {
+		if (Z_TYPE(prepared->z_client) == IS_OBJECT) {
+			update_client_error(&prepared->z_client, err.code, err.message, err.in_doubt);
+		}
+		RETURN_NULL();
+	}
+}
+/* }}} */
+
+/*
+ * Shared by scan(), scanPartitions(), scanIterator() and prepareScan(). The bin list is heap
+ * allocated, since the scan of an iterator outlives the call. On failure the scan is left destroyed.
+ */
+static as_status init_scan_from_php(as_scan* scan, char* ns, char* set, HashTable* select_bins,
+		zval* z_policy, int serializer_type, as_error* err) {
+	uint32_t select_count = 0;
+	zval* entry = NULL;
+
+	as_scan_init(scan, ns, set);
+
+	if (set_scan_options_from_policy_hash(scan, z_policy, err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (set_read_operations_from_policy_hash(&scan->ops, z_policy, err, serializer_type) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
 	if (select_bins) {
 		select_count = zend_hash_num_elements(select_bins);
+		if (select_count > 0 && scan->ops) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "Bins can not be selected along with OPT_READ_OPERATIONS");
+			goto CLEANUP;
+		}
 		if (select_count > 0) {
-			as_scan_select_inita(&user_scan, select_count);
-
-			zval* entry = NULL;
+			as_scan_select_init(scan, select_count);
 
 			ZEND_HASH_FOREACH_VAL(select_bins, entry)
 			{
 				if (Z_TYPE_P(entry) != IS_STRING) {
-					as_error_update(&err, AEROSPIKE_ERR_PARAM, "Bin names must be strings");
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "Bin names must be strings");
 					goto CLEANUP;
 				}
 				//TODO Validate bin length?
-				as_scan_select(&user_scan, Z_STRVAL_P(entry));
+				as_scan_select(scan, Z_STRVAL_P(entry));
 			} ZEND_HASH_FOREACH_END();
 		}
 	}
 
-	aerospike_scan_foreach(as_client, &err, scan_policy_p, &user_scan, user_callback_wrapper, (void*)&callback_function_data);
-
 CLEANUP:
-	if (scan_initialized) {
-		as_scan_destroy(&user_scan);
-	}
-	if (err.code != AEROSPIKE_OK) {
-		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	if (err->code != AEROSPIKE_OK) {
+		as_scan_destroy(scan);
 	}
-	RETURN_LONG(err.code);
+	return err->code;
 }
-/* }}} */
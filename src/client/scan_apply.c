@@ -49,7 +49,7 @@ PHP_METHOD(Aerospike, scanApply) {
 	aerospike* as_client = NULL;
 	uint64_t scan_id = 0;
 
-	int serializer_type = INI_INT("aerospike.serializer");
+	int serializer_type;
 
 	reset_client_error(getThis());
 
@@ -60,6 +60,7 @@ PHP_METHOD(Aerospike, scanApply) {
 
 	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
 	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
 
 	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sssshz/|z",
 			&ns, &ns_len, &set, &set_len,
@@ -83,15 +84,12 @@ PHP_METHOD(Aerospike, scanApply) {
 	}
 
 	if (zval_to_as_policy_scan(z_policy, &scan_policy,
-			&scan_policy_p, &as_client->config.policies.scan) != AEROSPIKE_OK) {
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
 		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid scan policy", false);
 		RETURN_LONG(AEROSPIKE_ERR_PARAM);
 	}
 
-	as_status status = set_scan_options_from_policy_hash(&user_scan, z_policy);
-
-	if (status != AEROSPIKE_OK) {
-		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
+	if (set_scan_options_from_policy_hash(&user_scan, z_policy, &err) != AEROSPIKE_OK) {
 		goto CLEANUP;
 	}
 
@@ -132,3 +130,102 @@ CLEANUP:
 	RETURN_LONG(err.code);
 }
 /* }}} */
+
+/* {{{ proto int Aerospike::scanOperate( string ns, string set, array operations, int &job_id [, array options ] )
+    Applies write operations to each record of a set using a background scan, without waiting for it */
+PHP_METHOD(Aerospike, scanOperate) {
+	as_error err;
+	as_error_init(&err);
+
+	char* ns = NULL;
+	char* set = NULL;
+	size_t ns_len, set_len;
+	HashTable* z_ops = NULL;
+
+	zval* job_id = NULL; // Reference to be filled with the scan's id
+	as_policy_scan scan_policy;
+	as_policy_scan* scan_policy_p = NULL;
+	zval* z_policy = NULL;
+
+	as_scan user_scan;
+	bool scan_initialized = false;
+
+	AerospikeClient* php_client = NULL;
+	aerospike* as_client = NULL;
+	uint64_t scan_id = 0;
+
+	int serializer_type;
+
+	reset_client_error(getThis());
+
+	if (check_object_and_connection(getThis(), &err) != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, false);
+		RETURN_LONG(err.code);
+	}
+
+	php_client = get_aerospike_from_zobj(Z_OBJ_P(getThis()));
+	as_client = php_client->as_client;
+	serializer_type = php_client->serializer_type;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS(), "sshz/|z",
+			&ns, &ns_len, &set, &set_len,
+			&z_ops, &job_id, &z_policy) == FAILURE) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid parameters to scanOperate", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	// Free the old value of the parameter by reference
+	zval_dtor(job_id);
+	ZVAL_NULL(job_id);
+
+	if (ns_len == 0) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Empty Namespace", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	if (!zend_hash_num_elements(z_ops)) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Empty operations array", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+
+	if (zval_to_as_policy_scan(z_policy, &scan_policy,
+			&scan_policy_p, &get_set_policies(php_client, ns, ns_len, set, set_len)->scan, php_client) != AEROSPIKE_OK) {
+		update_client_error(getThis(), AEROSPIKE_ERR_PARAM, "Invalid scan policy", false);
+		RETURN_LONG(AEROSPIKE_ERR_PARAM);
+	}
+	set_serializer_from_policy_hash(&serializer_type, z_policy);
+
+	if (!as_scan_init(&user_scan, ns, set)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to create scan");
+		goto CLEANUP;
+	}
+	scan_initialized = true;
+
+	if (set_scan_options_from_policy_hash(&user_scan, z_policy, &err) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	/* The scan owns its operations, the ttl of a touch or of OPT_TTL applies to every record */
+	user_scan.ops = as_operations_new(zend_hash_num_elements(z_ops));
+	if (z_hashtable_to_as_operations(z_ops, z_policy, user_scan.ops, &err, serializer_type) != AEROSPIKE_OK) {
+		goto CLEANUP;
+	}
+
+	if (!as_php_operations_write_only(user_scan.ops)) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "A background scan only accepts write operations");
+		goto CLEANUP;
+	}
+
+	/* Unlike scanApply the job is left running, its progress is reported by jobInfo() */
+	if (aerospike_scan_background(as_client, &err, scan_policy_p, &user_scan, &scan_id) == AEROSPIKE_OK) {
+		ZVAL_LONG(job_id, scan_id);
+	}
+
+CLEANUP:
+	if (scan_initialized) {
+		as_scan_destroy(&user_scan);
+	}
+	if (err.code != AEROSPIKE_OK) {
+		update_client_error(getThis(), err.code, err.message, err.in_doubt);
+	}
+	RETURN_LONG(err.code);
+}
+/* }}} */
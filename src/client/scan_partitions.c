@@ -0,0 +1,218 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#include "php.h"
+#include "citrusleaf/alloc.h"
+#include "scan_partitions.h"
+
+/*
+ * The cursor of scanPartitions().
+ *
+ * The C client tracks the progress of a partition scan as records arrive on the node threads, ahead
+ * of the records the callback was actually given. Resuming from its state could skip records the
+ * callback never saw, so the cursor is built from the records the callback was given instead. The
+ * server returns the records of a partition in digest order, so the last digest seen is where the
+ * partition resumes.
+ *
+ * The cursor string is binary:
+ *   "ASPC", a version byte, begin and count as 16 bit big endian integers,
+ *   then for each partition a state byte, followed by the last digest for started partitions.
+ */
+
+#define CURSOR_MAGIC "ASPC"
+#define CURSOR_MAGIC_SIZE 4
+#define CURSOR_VERSION 1
+#define CURSOR_HEADER_SIZE (CURSOR_MAGIC_SIZE + 1 + 2 + 2)
+
+/*
+ * The cursor of a paginated query() is the query as the C client serializes it, with the partition
+ * status it kept, as only the server knows where a secondary index query stands in a partition.
+ * A page is handed to the callback as a whole, so that status never gets ahead of the application.
+ *
+ *   "ASQC", a version byte, then the bytes of as_query_to_bytes.
+ */
+#define QUERY_CURSOR_MAGIC "ASQC"
+#define QUERY_CURSOR_VERSION 2
+#define QUERY_CURSOR_HEADER_SIZE (CURSOR_MAGIC_SIZE + 1)
+
+void as_php_scan_cursor_init(as_php_scan_cursor* cursor, uint16_t begin, uint16_t count) {
+	cursor->begin = begin;
+	cursor->count = count;
+	cursor->partitions = ecalloc(count, sizeof(as_php_partition_progress));
+}
+
+void as_php_scan_cursor_destroy(as_php_scan_cursor* cursor) {
+	if (cursor->partitions) {
+		efree(cursor->partitions);
+		cursor->partitions = NULL;
+	}
+}
+
+/* Restore a cursor written by as_php_scan_cursor_to_zval, for the range cursor was initialized with */
+as_status as_php_scan_cursor_from_string(as_php_scan_cursor* cursor, const char* bytes, size_t len, as_error* err) {
+	const uint8_t* pos = (const uint8_t*)bytes;
+	const uint8_t* end = pos + len;
+	uint16_t begin;
+	uint16_t count;
+
+	if (len < CURSOR_HEADER_SIZE || memcmp(pos, CURSOR_MAGIC, CURSOR_MAGIC_SIZE) != 0 ||
+			pos[CURSOR_MAGIC_SIZE] != CURSOR_VERSION) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan cursor");
+	}
+	pos += CURSOR_MAGIC_SIZE + 1;
+
+	begin = (uint16_t)((pos[0] << 8) | pos[1]);
+	count = (uint16_t)((pos[2] << 8) | pos[3]);
+	pos += 4;
+
+	if (begin != cursor->begin || count != cursor->count) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "The scan cursor is for partitions %u to %u",
+				begin, begin + count - 1);
+	}
+
+	for (uint16_t i = 0; i < count; i++) {
+		if (pos >= end || *pos > AS_PHP_PARTITION_DONE) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan cursor");
+		}
+		cursor->partitions[i].state = *pos++;
+
+		if (cursor->partitions[i].state == AS_PHP_PARTITION_STARTED) {
+			if (end - pos < AS_DIGEST_VALUE_SIZE) {
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan cursor");
+			}
+			memcpy(cursor->partitions[i].digest, pos, AS_DIGEST_VALUE_SIZE);
+			pos += AS_DIGEST_VALUE_SIZE;
+		}
+	}
+
+	if (pos != end) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan cursor");
+	}
+
+	return AEROSPIKE_OK;
+}
+
+void as_php_scan_cursor_to_zval(as_php_scan_cursor* cursor, zval* z_cursor) {
+	zend_string* bytes = NULL;
+	size_t len = CURSOR_HEADER_SIZE;
+	uint8_t* pos = NULL;
+
+	for (uint16_t i = 0; i < cursor->count; i++) {
+		len += 1;
+		if (cursor->partitions[i].state == AS_PHP_PARTITION_STARTED) {
+			len += AS_DIGEST_VALUE_SIZE;
+		}
+	}
+
+	bytes = zend_string_alloc(len, 0);
+	pos = (uint8_t*)ZSTR_VAL(bytes);
+
+	memcpy(pos, CURSOR_MAGIC, CURSOR_MAGIC_SIZE);
+	pos += CURSOR_MAGIC_SIZE;
+	*pos++ = CURSOR_VERSION;
+	*pos++ = (uint8_t)(cursor->begin >> 8);
+	*pos++ = (uint8_t)cursor->begin;
+	*pos++ = (uint8_t)(cursor->count >> 8);
+	*pos++ = (uint8_t)cursor->count;
+
+	for (uint16_t i = 0; i < cursor->count; i++) {
+		*pos++ = cursor->partitions[i].state;
+		if (cursor->partitions[i].state == AS_PHP_PARTITION_STARTED) {
+			memcpy(pos, cursor->partitions[i].digest, AS_DIGEST_VALUE_SIZE);
+			pos += AS_DIGEST_VALUE_SIZE;
+		}
+	}
+	ZSTR_VAL(bytes)[len] = '\0';
+
+	ZVAL_STR(z_cursor, bytes);
+}
+
+/* The callback was given the record with this digest */
+void as_php_scan_cursor_record(as_php_scan_cursor* cursor, const as_digest* digest) {
+	uint32_t part_id = (digest->value[0] | (digest->value[1] << 8)) & (AS_PHP_PARTITION_COUNT - 1);
+	as_php_partition_progress* progress = NULL;
+
+	if (part_id < cursor->begin || part_id >= (uint32_t)cursor->begin + cursor->count) {
+		return;
+	}
+
+	progress = &cursor->partitions[part_id - cursor->begin];
+	progress->state = AS_PHP_PARTITION_STARTED;
+	memcpy(progress->digest, digest->value, AS_DIGEST_VALUE_SIZE);
+}
+
+/* The scan went through the count partitions from the first, counted from the cursor's begin */
+void as_php_scan_cursor_finish(as_php_scan_cursor* cursor, uint16_t first, uint16_t count) {
+	for (uint16_t i = first; i < first + count; i++) {
+		cursor->partitions[i].state = AS_PHP_PARTITION_DONE;
+	}
+}
+
+bool as_php_scan_cursor_is_done(as_php_scan_cursor* cursor) {
+	for (uint16_t i = 0; i < cursor->count; i++) {
+		if (cursor->partitions[i].state != AS_PHP_PARTITION_DONE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* The partition status to resume a paginated query from, released with as_partitions_status_release */
+as_status as_php_query_cursor_from_string(const char* bytes, size_t len, as_partitions_status** parts_all,
+		as_error* err) {
+	as_query* query = NULL;
+
+	if (len <= QUERY_CURSOR_HEADER_SIZE || len - QUERY_CURSOR_HEADER_SIZE > UINT32_MAX ||
+			memcmp(bytes, QUERY_CURSOR_MAGIC, CURSOR_MAGIC_SIZE) != 0 ||
+			(uint8_t)bytes[CURSOR_MAGIC_SIZE] != QUERY_CURSOR_VERSION) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid query cursor");
+	}
+
+	query = as_query_from_bytes_new((const uint8_t*)bytes + QUERY_CURSOR_HEADER_SIZE,
+			(uint32_t)(len - QUERY_CURSOR_HEADER_SIZE));
+	if (!query) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid query cursor");
+	}
+	if (!query->parts_all) {
+		as_query_destroy(query);
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid query cursor");
+	}
+
+	*parts_all = as_partitions_status_reserve(query->parts_all);
+	as_query_destroy(query);
+	return AEROSPIKE_OK;
+}
+
+/* The cursor of the page following the one query just returned */
+as_status as_php_query_cursor_to_zval(const as_query* query, zval* z_cursor, as_error* err) {
+	zend_string* cursor = NULL;
+	uint8_t* bytes = NULL;
+	uint32_t size = 0;
+
+	if (!as_query_to_bytes(query, &bytes, &size)) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unable to serialize the query cursor");
+	}
+
+	cursor = zend_string_alloc(QUERY_CURSOR_HEADER_SIZE + size, 0);
+	memcpy(ZSTR_VAL(cursor), QUERY_CURSOR_MAGIC, CURSOR_MAGIC_SIZE);
+	ZSTR_VAL(cursor)[CURSOR_MAGIC_SIZE] = QUERY_CURSOR_VERSION;
+	memcpy(ZSTR_VAL(cursor) + QUERY_CURSOR_HEADER_SIZE, bytes, size);
+	ZSTR_VAL(cursor)[QUERY_CURSOR_HEADER_SIZE + size] = '\0';
+	cf_free(bytes);
+
+	ZVAL_STR(z_cursor, cursor);
+	return AEROSPIKE_OK;
+}
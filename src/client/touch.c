@@ -51,10 +51,12 @@ PHP_METHOD(Aerospike, touch)
 	}
 	aerospike* as_ptr = client->as_client;
 
-	if (zend_parse_parameters(ZEND_NUM_ARGS(), "h|lz", &z_key, &ttl_value, &z_operations_policy)
-		!= SUCCESS) {
-		return;
-	}
+	ZEND_PARSE_PARAMETERS_START(1, 3)
+		Z_PARAM_ARRAY_HT(z_key)
+		Z_PARAM_OPTIONAL
+		Z_PARAM_LONG(ttl_value)
+		Z_PARAM_ZVAL(z_operations_policy)
+	ZEND_PARSE_PARAMETERS_END();
 
 	if (z_hashtable_to_as_key(z_key, &key, &err) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Unable to convert key");
@@ -64,7 +66,7 @@ PHP_METHOD(Aerospike, touch)
 	key_initialized = true;
 
 	if (zval_to_as_policy_operate(z_operations_policy, &operate_policy,
-			&operate_policy_p, &as_ptr->config.policies.operate) != AEROSPIKE_OK) {
+			&operate_policy_p, &get_key_policies(client, z_key)->operate, client) != AEROSPIKE_OK) {
 		as_error_update(&err, AEROSPIKE_ERR_PARAM, "Invalid operate policy");
 		err.code = AEROSPIKE_ERR_PARAM;
 		goto CLEANUP;
@@ -84,6 +86,7 @@ PHP_METHOD(Aerospike, touch)
 	}
 
 	as_status status = aerospike_key_operate(as_ptr, &err, operate_policy_p, &key, &operations, &rec);
+	deliver_pending_log_events();
 	if (status != AEROSPIKE_OK) {
 		update_client_error(getThis(), err.code, err.message, err.in_doubt);
 		goto CLEANUP;
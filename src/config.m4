@@ -21,12 +21,17 @@ if test "$PHP_AEROSPIKE" != "no"; then
                     client/admin.c\
                     client/append.c\
                     client/apply.c\
+                    client/async.c\
+                    client/compiled_operations.c\
+                    client/compiled_policy.c\
                     client/exists.c\
                     client/exists_many.c\
+                    client/expressions.c\
                     client/get.c\
                     client/get_many.c\
                     client/get_key_digest.c\
                     client/get_nodes.c\
+                    client/hll_operations.c\
 					client/increment.c\
 					client/info.c\
 					client/job_info.c\
@@ -34,15 +39,21 @@ if test "$PHP_AEROSPIKE" != "no"; then
 					client/log_handlers.c\
 					client/operate.c\
 					client/php_client_utils.c\
+                    client/pipeline.c\
+                    client/poll.c\
                     client/predicate.c\
+                    client/prepared_query.c\
                     client/prepend.c\
                     client/put.c\
                     client/query.c\
+                    client/record_iterator.c\
+                    client/record_stream.c\
                     client/remove.c\
                     client/remove_bin.c\
                     client/scan.c\
                     client/scan_apply.c\
                     client/scan_info.c\
+                    client/scan_partitions.c\
                     client/secondary_index.c\
                     client/touch.c\
                     client/truncate.c\
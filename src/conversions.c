@@ -947,6 +947,84 @@ CLEANUP:
 	return AEROSPIKE_OK;
 }
 
+/*
+ * Converts a php ctx path, a list of [CDT_CTX_* type, value] pairs going from the bin down to the
+ * element an operation works on, into ctx. ctx is initialized here and owns the converted values,
+ * the caller destroys it once the operation has been added, on failure it is already destroyed.
+ */
+as_status z_hashtable_to_as_cdt_ctx(HashTable* z_ctx, as_cdt_ctx* ctx, as_error* err, int serializer_type) {
+	zval* z_step = NULL;
+	zval* z_type = NULL;
+	zval* z_value = NULL;
+	as_val* value = NULL;
+
+	if (!hashtable_is_list(z_ctx) || !zend_hash_num_elements(z_ctx)) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "ctx must be a non empty list of [type, value] pairs");
+	}
+
+	as_cdt_ctx_init(ctx, zend_hash_num_elements(z_ctx));
+
+	ZEND_HASH_FOREACH_VAL(z_ctx, z_step)
+	{
+		if (Z_TYPE_P(z_step) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(z_step)) != 2) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "ctx entries must be [type, value] pairs");
+			goto CLEANUP;
+		}
+		z_type = zend_hash_index_find(Z_ARRVAL_P(z_step), 0);
+		z_value = zend_hash_index_find(Z_ARRVAL_P(z_step), 1);
+		if (!z_type || !z_value || Z_TYPE_P(z_type) != IS_LONG) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "ctx entries must be [type, value] pairs");
+			goto CLEANUP;
+		}
+
+		switch (Z_LVAL_P(z_type)) {
+			case CDT_CTX_LIST_INDEX:
+			case CDT_CTX_LIST_RANK:
+			case CDT_CTX_MAP_INDEX:
+			case CDT_CTX_MAP_RANK:
+				if (Z_TYPE_P(z_value) != IS_LONG) {
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "ctx index and rank must be integers");
+					goto CLEANUP;
+				}
+				if (Z_LVAL_P(z_type) == CDT_CTX_LIST_INDEX) {
+					as_cdt_ctx_add_list_index(ctx, Z_LVAL_P(z_value));
+				} else if (Z_LVAL_P(z_type) == CDT_CTX_LIST_RANK) {
+					as_cdt_ctx_add_list_rank(ctx, Z_LVAL_P(z_value));
+				} else if (Z_LVAL_P(z_type) == CDT_CTX_MAP_INDEX) {
+					as_cdt_ctx_add_map_index(ctx, Z_LVAL_P(z_value));
+				} else {
+					as_cdt_ctx_add_map_rank(ctx, Z_LVAL_P(z_value));
+				}
+				break;
+			case CDT_CTX_LIST_VALUE:
+			case CDT_CTX_MAP_KEY:
+			case CDT_CTX_MAP_VALUE:
+				value = NULL;
+				if (zval_to_as_val(z_value, &value, err, serializer_type) != AEROSPIKE_OK || !value) {
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "Unable to convert ctx value");
+					goto CLEANUP;
+				}
+				if (Z_LVAL_P(z_type) == CDT_CTX_LIST_VALUE) {
+					as_cdt_ctx_add_list_value(ctx, value);
+				} else if (Z_LVAL_P(z_type) == CDT_CTX_MAP_KEY) {
+					as_cdt_ctx_add_map_key(ctx, value);
+				} else {
+					as_cdt_ctx_add_map_value(ctx, value);
+				}
+				break;
+			default:
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "Unknown ctx type");
+				goto CLEANUP;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return AEROSPIKE_OK;
+
+CLEANUP:
+	as_cdt_ctx_destroy(ctx);
+	return err->code;
+}
+
 /*
  * Takes a php hashtable and an allocated as_privileges** and fills it with as_privilege entries
  * returns err, and fills err param on failure
@@ -1304,6 +1382,7 @@ as_status serialize_php_object(zval* zval_to_convert, as_bytes** out_bytes, as_e
  * Convert as_bytes to a zval
  * If the type is AS_BYTES_PHP, use the php deserializer
  * If the type is AS_BYTES_BLOB use the user deserializer if registered, else return a string
+ * If the type is AS_BYTES_HLL return an Aerospike\Bytes, which can be passed back to the HLL operations
  * If the type is a different AS_BYTES_* error
  *
  * @param bytes				as_bytes to deserialize.
@@ -1323,6 +1402,9 @@ as_status unserialize_as_bytes(const as_bytes* bytes, zval* retval, as_error* er
 			return unserialize_with_user_function(bytes, retval, err);
 		}
 	}
+	if (as_bytes_get_type(bytes) == AS_BYTES_HLL) {
+		return as_bytes_to_zval_bytes(bytes, retval, err);
+	}
 	if (as_bytes_get_type(bytes) != AS_BYTES_PHP) {
 		as_error_update(err, AEROSPIKE_ERR_CLIENT, "Unsupported bytes type");
 		return AEROSPIKE_ERR_CLIENT;
@@ -0,0 +1,168 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_ASYNC_H
+#define AS_PHP_ASYNC_H
+#include "php.h"
+#include "php_aerospike_types.h"
+#include "aerospike/as_event.h"
+#include "aerospike/as_listener.h"
+#include "pthread.h"
+
+/*
+ * State of one command issued on the C client event loops.
+ *
+ * It is shared between the PHP thread, which owns the Aerospike\Future wrapping it,
+ * and the event loop thread which completes it, so it is malloc'd rather than emalloc'd
+ * and freed by whichever side drops the last reference.
+ * The event loop thread never touches a zval, it only stores the error and a copy of
+ * the record; the conversion into PHP values happens when the future is awaited.
+ */
+/*
+ * Commands whose future has a completion callback are pushed here by the event loop thread,
+ * and one byte is written to the socket pair whenever the queue goes from empty to non empty.
+ * Aerospike::poll() drains both and runs the callbacks. There is one queue per PHP thread,
+ * shared with the commands in flight, which hold a reference on it.
+ */
+typedef struct _as_php_completion_queue {
+	pthread_mutex_t lock;
+	int ref_cnt;
+	int read_fd;
+	int write_fd;
+	struct _as_php_async_command* head;
+	struct _as_php_async_command* tail;
+} as_php_completion_queue;
+
+typedef struct _as_php_async_command {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int ref_cnt;
+	bool done;
+	bool show_pk;
+	bool key_initialized;
+	as_key key;
+	as_error err;
+	as_record* record;
+	/* Completion callback bookkeeping, see poll.c. The waiter is only touched on the PHP thread */
+	as_php_completion_queue* queue;
+	struct _as_php_async_command* next;
+	zend_object* waiter;
+} as_php_async_command;
+
+typedef struct _AerospikeFuture {
+	as_php_async_command* cmd;
+	/* The converted result, filled the first time the future is awaited */
+	zval z_result;
+	/* Run by Aerospike::poll() once the command completed */
+	zval z_callback;
+	zend_object zobj;
+} AerospikeFuture;
+
+/*
+ * Commands sent through an Aerospike\Pipeline, in the order they were issued.
+ * All of them use one event loop, so those to the same node share a pipelined connection.
+ */
+typedef struct _AerospikePipeline {
+	zval z_client;
+	as_event_loop* event_loop;
+	as_php_async_command** cmds;
+	uint32_t cmd_count;
+	uint32_t cmd_capacity;
+	zend_object zobj;
+} AerospikePipeline;
+
+extern zend_class_entry* aerospike_future_ce;
+extern zend_class_entry* aerospike_pipeline_ce;
+
+bool register_aerospike_future_class(void);
+bool register_aerospike_pipeline_class(void);
+void init_async_event_loops(void);
+void shutdown_async_event_loops(void);
+as_status check_async_event_loops(as_error* err);
+
+as_php_async_command* as_php_async_command_new(void);
+void as_php_async_command_release(as_php_async_command* cmd);
+void as_php_async_command_complete(as_php_async_command* cmd, const as_error* err, const as_record* record);
+bool as_php_async_command_wait(as_php_async_command* cmd, struct timespec* deadline);
+as_record* as_php_copy_record(const as_record* record);
+as_val* as_php_copy_val(as_val* val);
+bool as_php_async_command_to_zval(as_php_async_command* cmd, zval* z_entry, as_status* status, struct timespec* deadline);
+
+void as_php_async_command_notify(as_php_async_command* cmd, as_php_completion_queue* queue);
+void as_php_completion_queue_push(as_php_completion_queue* queue, as_php_async_command* cmd);
+void as_php_completion_queue_release(as_php_completion_queue* queue);
+
+void as_php_async_record_listener(as_error* err, as_record* record, void* udata, as_event_loop* event_loop);
+void as_php_async_write_listener(as_error* err, void* udata, as_event_loop* event_loop);
+as_status as_php_async_get(AerospikeClient* client, as_error* err, as_php_async_command* cmd, HashTable* z_key_hash,
+		zval* z_filter, zval* z_read_policy, as_event_loop* event_loop, as_pipe_listener pipe_listener);
+
+void aerospike_future_from_command(zval* z_future, as_php_async_command* cmd);
+AerospikeFuture* get_aerospike_future_from_zobj(zend_object* zobj);
+bool aerospike_future_result(AerospikeFuture* future, zval* z_result, as_status* status, struct timespec* deadline);
+void async_deadline_from_timeout(struct timespec* deadline, zend_long timeout_ms);
+
+PHP_METHOD(AerospikeFuture, isReady);
+ZEND_BEGIN_ARG_INFO_EX(future_is_ready_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikeFuture, wait);
+ZEND_BEGIN_ARG_INFO_EX(future_wait_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(1, result)
+    ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikeFuture, onComplete);
+ZEND_BEGIN_ARG_INFO_EX(future_on_complete_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(0, callback)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikePipeline, put);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_put_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, key)
+    ZEND_ARG_INFO(0, bins)
+    ZEND_ARG_INFO(0, ttl)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikePipeline, get);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_get_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(0, key)
+    ZEND_ARG_INFO(0, filter)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikePipeline, operate);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_operate_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, key)
+    ZEND_ARG_INFO(0, operations)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikePipeline, remove);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_remove_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(0, key)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(AerospikePipeline, flush);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_flush_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(1, results)
+    ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO();
+
+#endif
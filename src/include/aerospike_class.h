@@ -104,6 +104,14 @@ ZEND_BEGIN_ARG_INFO_EX(exists_arg_info, 0, 0, 2)
     ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, existsManyCompact);
+ZEND_BEGIN_ARG_INFO_EX(exists_many_compact_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, keys)
+    ZEND_ARG_INFO(1, exists)
+    ZEND_ARG_INFO(0, options)
+    ZEND_ARG_INFO(1, generations)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, get);
 ZEND_BEGIN_ARG_INFO_EX(get_arg_info, 0, 0, 2)
     ZEND_ARG_INFO(0, key)
@@ -123,6 +131,22 @@ PHP_METHOD(Aerospike, isConnected);
 ZEND_BEGIN_ARG_INFO_EX(is_connected_arg_info, 0, 0, 0)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, hllGetUnion);
+ZEND_BEGIN_ARG_INFO_EX(hll_get_union_arg_info, 0, 0, 3)
+    ZEND_ARG_INFO(0, keys)
+    ZEND_ARG_INFO(0, bin)
+    ZEND_ARG_INFO(1, hll)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, hllGetUnionCount);
+ZEND_BEGIN_ARG_INFO_EX(hll_get_union_count_arg_info, 0, 0, 3)
+    ZEND_ARG_INFO(0, keys)
+    ZEND_ARG_INFO(0, bin)
+    ZEND_ARG_INFO(1, count)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, increment);
 ZEND_BEGIN_ARG_INFO_EX(increment_arg_info, 0, 0, 3)
     ZEND_ARG_INFO(0, key)
@@ -337,6 +361,10 @@ PHP_METHOD(Aerospike, shmKey);
 ZEND_BEGIN_ARG_INFO_EX(shm_key_arg_info, 0, 0, 0)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, persistentStats);
+ZEND_BEGIN_ARG_INFO_EX(persistent_stats_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, setDeserializer);
 ZEND_BEGIN_ARG_INFO_EX(set_deserializer_arg_info, 0, 0, 1)
     ZEND_ARG_INFO(0, unserialize_cb)
@@ -469,6 +497,18 @@ ZEND_BEGIN_ARG_INFO_EX(scan_arg_info, 0, 0, 3)
     ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, scanPartitions);
+ZEND_BEGIN_ARG_INFO_EX(scan_partitions_arg_info, 0, 0, 5)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, begin)
+    ZEND_ARG_INFO(0, count)
+    ZEND_ARG_INFO(0, record_cb)
+    ZEND_ARG_INFO(0, select)
+    ZEND_ARG_INFO(0, options)
+    ZEND_ARG_INFO(1, cursor)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, scanApply);
 ZEND_BEGIN_ARG_INFO_EX(scan_apply_arg_info, 0, 0, 6)
     ZEND_ARG_INFO(0, ns)
@@ -480,6 +520,15 @@ ZEND_BEGIN_ARG_INFO_EX(scan_apply_arg_info, 0, 0, 6)
     ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, scanOperate);
+ZEND_BEGIN_ARG_INFO_EX(scan_operate_arg_info, 0, 0, 4)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, operations)
+    ZEND_ARG_INFO(1, job_id)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, scanInfo);
 ZEND_BEGIN_ARG_INFO_EX(scan_info_arg_info, 0, 0, 2)
     ZEND_ARG_PASS_INFO(0)
@@ -495,6 +544,7 @@ ZEND_BEGIN_ARG_INFO_EX(query_arg_info, 0, 0, 4)
     ZEND_ARG_INFO(0, record_cb)
     ZEND_ARG_INFO(0, select)
     ZEND_ARG_INFO(0, options)
+    ZEND_ARG_INFO(1, cursor)
 ZEND_END_ARG_INFO();
 
 PHP_METHOD(Aerospike, queryApply);
@@ -509,6 +559,16 @@ ZEND_BEGIN_ARG_INFO_EX(query_apply_arg_info, 0, 0, 7)
     ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, queryOperate);
+ZEND_BEGIN_ARG_INFO_EX(query_operate_arg_info, 0, 0, 5)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, where)
+    ZEND_ARG_INFO(0, operations)
+    ZEND_ARG_INFO(1, job_id)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, aggregate);
 ZEND_BEGIN_ARG_INFO_EX(aggregate_arg_info, 0, 0, 7)
     ZEND_ARG_INFO(0, ns)
@@ -529,6 +589,66 @@ ZEND_BEGIN_ARG_INFO_EX(exists_many_arg_info, 0, 0, 2)
     ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO();
 
+PHP_METHOD(Aerospike, getAsync);
+ZEND_BEGIN_ARG_INFO_EX(get_async_arg_info, 0, 0, 1)
+    ZEND_ARG_INFO(0, key)
+    ZEND_ARG_INFO(0, filter)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, awaitAll);
+ZEND_BEGIN_ARG_INFO_EX(await_all_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, futures)
+    ZEND_ARG_INFO(1, results)
+    ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, pipeline);
+ZEND_BEGIN_ARG_INFO_EX(pipeline_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, scanIterator);
+ZEND_BEGIN_ARG_INFO_EX(scan_iterator_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, select)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, queryIterator);
+ZEND_BEGIN_ARG_INFO_EX(query_iterator_arg_info, 0, 0, 3)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, where)
+    ZEND_ARG_INFO(0, select)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, prepareScan);
+ZEND_BEGIN_ARG_INFO_EX(prepare_scan_arg_info, 0, 0, 2)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, select)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, prepareQuery);
+ZEND_BEGIN_ARG_INFO_EX(prepare_query_arg_info, 0, 0, 3)
+    ZEND_ARG_INFO(0, ns)
+    ZEND_ARG_INFO(0, set)
+    ZEND_ARG_INFO(0, where)
+    ZEND_ARG_INFO(0, select)
+    ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, completionStream);
+ZEND_BEGIN_ARG_INFO_EX(completion_stream_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+PHP_METHOD(Aerospike, poll);
+ZEND_BEGIN_ARG_INFO_EX(poll_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
 PHP_METHOD(Aerospike, getMany);
 ZEND_BEGIN_ARG_INFO_EX(get_many_arg_info, 0, 0, 2)
     ZEND_ARG_INFO(0, keys)
@@ -0,0 +1,72 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_COMPILED_OPERATIONS_H
+#define AS_PHP_COMPILED_OPERATIONS_H
+#include "php.h"
+#include "aerospike/as_operations.h"
+
+/*
+ * An operation of an Aerospike\Operations template. Without a parameter it was added to the
+ * compiled operations once, with one its array is completed with the bound value on each call.
+ */
+typedef struct _as_php_compiled_op {
+	uint32_t binop;
+	HashTable* op_array;
+	uint32_t param;
+} as_php_compiled_op;
+
+/*
+ * An Aerospike\Operations is either a template made by compile(), or the template with the values
+ * of its parameters, made by bind()
+ */
+typedef struct _AerospikeOperations {
+	as_operations* compiled;
+	/* The array compiled from, the strings of an append or a prepend point into it */
+	HashTable* source;
+	as_php_compiled_op* entries;
+	uint32_t entry_count;
+	uint32_t param_count;
+
+	/* Set on the operations made by bind() */
+	zval z_template;
+	zval z_params;
+
+	zend_object zobj;
+} AerospikeOperations;
+
+extern zend_class_entry* aerospike_operations_ce;
+
+bool register_aerospike_operations_class(void);
+uint32_t as_php_operations_count(zval* z_ops);
+as_status zval_to_as_operations(zval* z_ops, zval* z_operate_policy, as_operations* ops,
+		as_error* err, int serializer_type);
+bool add_compiled_binop(as_operations* ops, const as_binop* binop);
+
+PHP_METHOD(AerospikeOperations, compile);
+PHP_METHOD(AerospikeOperations, bind);
+
+ZEND_BEGIN_ARG_INFO_EX(operations_compile_arg_info, 0, 0, 1)
+	ZEND_ARG_ARRAY_INFO(0, operations, 0)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(operations_bind_arg_info, 0, 0, 1)
+	ZEND_ARG_ARRAY_INFO(0, params, 0)
+ZEND_END_ARG_INFO();
+
+#endif
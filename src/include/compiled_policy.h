@@ -0,0 +1,116 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_COMPILED_POLICY_H
+#define AS_PHP_COMPILED_POLICY_H
+#include "php.h"
+#include "aerospike/as_policy.h"
+#include "php_aerospike_types.h"
+
+/* Policies resolved for this many clients are kept, the least recently used one makes room */
+#define AS_PHP_POLICY_MAX_CLIENTS 4
+
+/*
+ * The policies of each kind resolved against the defaults of one client, or of its profiles. The
+ * addresses of a client's defaults do not change while it lives, and its id is never reused.
+ */
+typedef struct _as_php_policy_resolved {
+	/* The id of the client, 0 if the slot is unused */
+	uint64_t client_id;
+	/* The uses of the policy when the slot was last used */
+	uint64_t last_use;
+	/* Per kind, the address of the defaults => the as_policy_* resolved against them */
+	HashTable* read;
+	HashTable* write;
+	HashTable* operate;
+	HashTable* remove;
+	HashTable* batch;
+	HashTable* apply;
+	HashTable* scan;
+	HashTable* query;
+} as_php_policy_resolved;
+
+/*
+ * An Aerospike\Policy holds the options array it was created from, along with each kind of C
+ * policy resolved from it. A kind is resolved once for each set of defaults of a client it is used
+ * with, those of the client or of one of its profiles.
+ */
+typedef struct _AerospikePolicy {
+	/* Options which are not resolved ahead are still looked up in the array */
+	zval z_options;
+
+	as_php_policy_resolved resolved[AS_PHP_POLICY_MAX_CLIENTS];
+	uint64_t uses;
+
+	/* OPT_SERIALIZER, the generation of OPT_POLICY_GEN and OPT_TTL */
+	bool has_serializer;
+	int serializer;
+	bool has_generation;
+	uint16_t generation;
+	bool has_ttl;
+	uint32_t ttl;
+
+	zend_object zobj;
+} AerospikePolicy;
+
+extern zend_class_entry* aerospike_policy_ce;
+
+bool register_aerospike_policy_class(void);
+
+static inline AerospikePolicy* as_php_policy_from_zval(zval* z_policy) {
+	if (!z_policy || Z_TYPE_P(z_policy) != IS_OBJECT || Z_OBJCE_P(z_policy) != aerospike_policy_ce) {
+		return NULL;
+	}
+	return (AerospikePolicy*)((char*)Z_OBJ_P(z_policy) - XtOffsetOf(AerospikePolicy, zobj));
+}
+
+/* The options array of an Aerospike\Policy, any other value is returned as is */
+static inline zval* as_php_policy_options(zval* z_policy) {
+	AerospikePolicy* policy = as_php_policy_from_zval(z_policy);
+	return policy ? &policy->z_options : z_policy;
+}
+
+as_status as_php_policy_copy_read(AerospikePolicy* policy, as_policy_read* read_policy, as_policy_read* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_write(AerospikePolicy* policy, as_policy_write* write_policy, as_policy_write* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_operate(AerospikePolicy* policy, as_policy_operate* operate_policy, as_policy_operate* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_remove(AerospikePolicy* policy, as_policy_remove* remove_policy, as_policy_remove* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_batch(AerospikePolicy* policy, as_policy_batch* batch_policy, as_policy_batch* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_apply(AerospikePolicy* policy, as_policy_apply* apply_policy, as_policy_apply* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_scan(AerospikePolicy* policy, as_policy_scan* scan_policy, as_policy_scan* default_policy,
+		AerospikeClient* client);
+as_status as_php_policy_copy_query(AerospikePolicy* policy, as_policy_query* query_policy, as_policy_query* default_policy,
+		AerospikeClient* client);
+
+PHP_METHOD(AerospikePolicy, create);
+PHP_METHOD(AerospikePolicy, options);
+PHP_METHOD(AerospikePolicy, error);
+PHP_METHOD(AerospikePolicy, errorno);
+
+ZEND_BEGIN_ARG_INFO_EX(policy_create_arg_info, 0, 0, 1)
+	ZEND_ARG_ARRAY_INFO(0, options, 0)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(policy_no_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+#endif
@@ -21,6 +21,7 @@
 #include "ext/standard/info.h"
 #include "php_aerospike.h"
 #include "c_aerospike_types.h"
+#include "aerospike/as_cdt_ctx.h"
 #include <stdbool.h>
 
 /* All of these need an error entry so it can be checked on return
@@ -43,6 +44,13 @@ as_status z_hashtable_to_as_key(HashTable* z_key_hash, as_key* key, as_error* er
 as_status z_hashtable_to_as_list(HashTable* php_hash, as_list** list, as_error* err, int serializer_type);
 as_status z_hashtable_to_as_map(HashTable* php_hash, as_map** c_map, as_error* err, int serializer_type);
 as_status z_hashtable_to_as_record(HashTable* z_record_hash, as_record** record, as_error* err, int serializer_type);
+as_status z_hashtable_to_as_operations(HashTable* z_ops, zval* z_operate_policy, as_operations* ops,
+		as_error* err, int serializer_type);
+as_status add_op_to_operations(HashTable* op_array, as_operations* ops, as_error* err, int serializer_type);
+bool as_php_operations_write_only(const as_operations* ops);
+as_status set_read_operations_from_policy_hash(as_operations** ops, zval* z_policy, as_error* err,
+		int serializer_type);
+as_status z_hashtable_to_as_cdt_ctx(HashTable* z_ctx, as_cdt_ctx* ctx, as_error* err, int serializer_type);
 as_status add_zval_to_record(zval* add_zval, as_record* record, const char* bin, as_error* err, int serializer_type);
 
 as_status z_hash_to_str_array(HashTable* z_roles, char** roles, int max_size, int roles_size, as_error* err);
@@ -0,0 +1,130 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_EXPRESSIONS_H
+#define AS_PHP_EXPRESSIONS_H
+#include "php.h"
+#include "aerospike/as_exp.h"
+#include "aerospike/as_val.h"
+
+#define AS_PHP_EXP_MAX_ENTRIES 3
+
+/*
+ * A node of an Aerospike\Exp tree. Its own entries are written around the entries of its
+ * operands, the way the as_exp_* macros of the C client lay them out.
+ */
+typedef struct _AerospikeExp {
+	as_exp_entry entries[AS_PHP_EXP_MAX_ENTRIES];
+	uint32_t entry_count;
+	/* Entries written before the operands, the rest follow them */
+	uint32_t operands_at;
+	/* Operand lists of and, or and exclusive are closed by an end marker */
+	bool variadic;
+
+	/* The Aerospike\Exp operands */
+	zval z_operands;
+	/* Bin name, string, bytes or regex the entries point to */
+	zend_string* str;
+	/* AS_STRING or AS_BYTES for a string or bytes value, whose as_val is made for each compile */
+	as_val_t value_type;
+
+	/* Compiled the first time the expression is used as a filter */
+	as_exp* compiled;
+	zend_object zobj;
+} AerospikeExp;
+
+extern zend_class_entry* aerospike_exp_ce;
+
+bool register_aerospike_exp_class(void);
+as_exp* as_php_exp_compile(zval* z_exp);
+
+PHP_METHOD(AerospikeExp, int);
+PHP_METHOD(AerospikeExp, float);
+PHP_METHOD(AerospikeExp, str);
+PHP_METHOD(AerospikeExp, bool);
+PHP_METHOD(AerospikeExp, bytes);
+PHP_METHOD(AerospikeExp, nil);
+PHP_METHOD(AerospikeExp, intBin);
+PHP_METHOD(AerospikeExp, floatBin);
+PHP_METHOD(AerospikeExp, strBin);
+PHP_METHOD(AerospikeExp, blobBin);
+PHP_METHOD(AerospikeExp, listBin);
+PHP_METHOD(AerospikeExp, mapBin);
+PHP_METHOD(AerospikeExp, geoBin);
+PHP_METHOD(AerospikeExp, hllBin);
+PHP_METHOD(AerospikeExp, binExists);
+PHP_METHOD(AerospikeExp, binType);
+PHP_METHOD(AerospikeExp, keyInt);
+PHP_METHOD(AerospikeExp, keyStr);
+PHP_METHOD(AerospikeExp, keyBlob);
+PHP_METHOD(AerospikeExp, keyExists);
+PHP_METHOD(AerospikeExp, setName);
+PHP_METHOD(AerospikeExp, deviceSize);
+PHP_METHOD(AerospikeExp, lastUpdate);
+PHP_METHOD(AerospikeExp, sinceUpdate);
+PHP_METHOD(AerospikeExp, voidTime);
+PHP_METHOD(AerospikeExp, ttl);
+PHP_METHOD(AerospikeExp, isTombstone);
+PHP_METHOD(AerospikeExp, digestModulo);
+PHP_METHOD(AerospikeExp, eq);
+PHP_METHOD(AerospikeExp, ne);
+PHP_METHOD(AerospikeExp, gt);
+PHP_METHOD(AerospikeExp, ge);
+PHP_METHOD(AerospikeExp, lt);
+PHP_METHOD(AerospikeExp, le);
+PHP_METHOD(AerospikeExp, regex);
+PHP_METHOD(AerospikeExp, geoCompare);
+PHP_METHOD(AerospikeExp, not);
+PHP_METHOD(AerospikeExp, and);
+PHP_METHOD(AerospikeExp, or);
+PHP_METHOD(AerospikeExp, exclusive);
+
+ZEND_BEGIN_ARG_INFO_EX(exp_no_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_value_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, value)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_bin_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, bin)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_digest_modulo_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, modulo)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_compare_arg_info, 0, 0, 2)
+	ZEND_ARG_INFO(0, left)
+	ZEND_ARG_INFO(0, right)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_regex_arg_info, 0, 0, 2)
+	ZEND_ARG_INFO(0, regex)
+	ZEND_ARG_INFO(0, exp)
+	ZEND_ARG_INFO(0, flags)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_not_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, exp)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(exp_variadic_arg_info, 0, 0, 1)
+	ZEND_ARG_VARIADIC_INFO(0, exps)
+ZEND_END_ARG_INFO();
+
+#endif
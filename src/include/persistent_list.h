@@ -20,17 +20,25 @@
 #include "php.h"
 #include "php_aerospike_types.h"
 
+#include <time.h>
+
 typedef struct _persistent_host {
 	aerospike* as_client;
+	/* Clients currently using the host */
 	int ref_cnt;
+	/* Clients which have used the host since it was created */
 	int conn_cnt;
 	bool is_connected;
+	time_t created;
+	/* When a client last started or stopped using the host */
+	time_t last_used;
 } persistent_host;
 
-char* get_persistent_search_string(aerospike* as);
-persistent_host* add_persistent_host(const char* host_key, aerospike* as_client);
-persistent_host* get_persistent_host(const char* host_key);
+persistent_host* add_persistent_host(zend_string* host_key, aerospike* as_client);
+persistent_host* get_persistent_host(zend_string* host_key);
+void release_persistent_host(persistent_host* host);
 void persistent_host_dtor(zval* zval);
+void persistent_hosts_to_zval(zval* return_value);
 as_status persistent_connect(AerospikeClient* client);
 as_status non_persistent_connect(AerospikeClient* client);
 #endif
@@ -43,13 +43,32 @@
 
 #define SERIALIZER_DEFAULT "php"
 
+// Records buffered by a scan or query iterator unless OPT_ITERATOR_QUEUE_SIZE is given
+#define AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE 256
+
+/*
+ * The default policies of the records of a namespace, or of a set in it, given by the
+ * OPT_POLICY_PROFILES of the constructor
+ */
+typedef struct _as_php_policy_profile {
+	as_policies policies;
+	/* Set name => as_php_policy_profile, NULL if the namespace profile has no set profiles */
+	HashTable* set_profiles;
+} as_php_policy_profile;
+
 typedef struct aerospike_client_z {
 	aerospike* as_client;
+	/* Never reused in the process, the Aerospike\Policy objects keep what they resolved per client */
+	uint64_t id;
 	bool is_connected;
 	bool is_valid;
 	as_error client_error;
 	bool is_persistent;
 	int serializer_type;
+	/* Namespace => as_php_policy_profile, NULL without OPT_POLICY_PROFILES */
+	HashTable* policy_profiles;
+	/* The entry of the persistent list the client shares its aerospike with */
+	struct _persistent_host* persistent_host;
 	zend_object zobj;
 }AerospikeClient;
 
@@ -59,11 +78,23 @@ enum Aerospike_serializer_values {
 	SERIALIZER_USER,
 };
 
+enum Aerospike_exists_format_values {
+	EXISTS_FORMAT_BITMAP, /* default, bit i of the string is set when key i exists */
+	EXISTS_FORMAT_BOOL,
+};
+
 AerospikeClient* get_aerospike_from_zobj(zend_object* zval_wrapper);
 void update_client_error(zval* client_obj, int code, const char* msg, bool in_doubt);
 void reset_client_error(zval* client_obj);
+void deliver_pending_log_events(void);
+void as_php_log_queue_init(void);
+void as_php_log_queue_destroy(void);
 as_status check_object_and_connection(zval* aerospike_container, as_error* err);
 void set_policy_defaults_from_ini(as_config* config, AerospikeClient* client);
+as_policies* get_set_policies(AerospikeClient* client, const char* ns, size_t ns_len, const char* set,
+		size_t set_len);
+as_policies* get_key_policies(AerospikeClient* client, HashTable* z_key);
+as_policies* get_batch_policies(AerospikeClient* client, HashTable* z_keys);
 
 enum Aerospike_list_operations {
 	OP_LIST_APPEND = 1001,
@@ -79,7 +110,24 @@ enum Aerospike_list_operations {
 	OP_LIST_GET,
 	OP_LIST_GET_RANGE,
 	OP_LIST_TRIM,
-	OP_LIST_SIZE
+	OP_LIST_SIZE,
+	OP_LIST_SET_ORDER,
+	OP_LIST_SORT,
+	OP_LIST_INCREMENT,
+	OP_LIST_GET_BY_INDEX,
+	OP_LIST_GET_BY_INDEX_RANGE,
+	OP_LIST_GET_BY_RANK,
+	OP_LIST_GET_BY_RANK_RANGE,
+	OP_LIST_GET_BY_VALUE,
+	OP_LIST_GET_BY_VALUE_LIST,
+	OP_LIST_GET_BY_VALUE_RANGE,
+	OP_LIST_REMOVE_BY_INDEX,
+	OP_LIST_REMOVE_BY_INDEX_RANGE,
+	OP_LIST_REMOVE_BY_RANK,
+	OP_LIST_REMOVE_BY_RANK_RANGE,
+	OP_LIST_REMOVE_BY_VALUE,
+	OP_LIST_REMOVE_BY_VALUE_LIST,
+	OP_LIST_REMOVE_BY_VALUE_RANGE
 };
 
 enum Aerospike_map_operations {
@@ -108,6 +156,54 @@ enum Aerospike_map_operations {
 	OP_MAP_GET_BY_INDEX_RANGE,
 	OP_MAP_GET_BY_RANK,
 	OP_MAP_GET_BY_RANK_RANGE,
+	OP_MAP_GET_BY_KEY_LIST,
+	OP_MAP_GET_BY_VALUE_LIST,
+};
+
+enum Aerospike_bit_operations {
+	OP_BIT_RESIZE = 1301,
+	OP_BIT_INSERT,
+	OP_BIT_REMOVE,
+	OP_BIT_SET,
+	OP_BIT_OR,
+	OP_BIT_XOR,
+	OP_BIT_AND,
+	OP_BIT_NOT,
+	OP_BIT_LSHIFT,
+	OP_BIT_RSHIFT,
+	OP_BIT_ADD,
+	OP_BIT_SUBTRACT,
+	OP_BIT_SET_INT,
+	OP_BIT_GET,
+	OP_BIT_COUNT,
+	OP_BIT_LSCAN,
+	OP_BIT_RSCAN,
+	OP_BIT_GET_INT
+};
+
+enum Aerospike_hll_operations {
+	OP_HLL_INIT = 1401,
+	OP_HLL_ADD,
+	OP_HLL_SET_UNION,
+	OP_HLL_REFRESH_COUNT,
+	OP_HLL_FOLD,
+	OP_HLL_GET_COUNT,
+	OP_HLL_GET_UNION,
+	OP_HLL_GET_UNION_COUNT,
+	OP_HLL_GET_INTERSECT_COUNT,
+	OP_HLL_GET_SIMILARITY,
+	OP_HLL_DESCRIBE
+};
+
+/* Steps of the "ctx" path of a list or map operation, each one selects an element of the CDT above it */
+enum Aerospike_cdt_ctx_types {
+	CDT_CTX_LIST_INDEX = 1201,
+	CDT_CTX_LIST_RANK,
+	CDT_CTX_LIST_VALUE,
+	CDT_CTX_MAP_INDEX,
+	CDT_CTX_MAP_RANK,
+	CDT_CTX_MAP_KEY,
+	CDT_CTX_MAP_VALUE
 };
 
 enum Aerospike_opt_keys {
@@ -117,9 +213,9 @@ enum Aerospike_opt_keys {
 	OPT_POLICY_RETRY,        /* set to a Aerospike::POLICY_RETRY_* value                                      */
 	OPT_POLICY_EXISTS,       /* set to a Aerospike::POLICY_EXISTS_* value                                     */
 	OPT_SERIALIZER,          /* set the unsupported type handler                                              */
-	OPT_SCAN_PRIORITY,       /* set to a Aerospike::SCAN_PRIORITY_* value                                     */
+	OPT_SCAN_PRIORITY,       /* deprecated, only SCAN_PRIORITY_AUTO is accepted since the C client 6.x         */
 	OPT_SCAN_RPS_LIMIT,      /* set the results per second(RPS) limit */
-	OPT_SCAN_PERCENTAGE,     /* integer value 1-100, default: 100                                             */
+	OPT_SCAN_PERCENTAGE,     /* deprecated, only 100 is accepted since the C client 6.x                       */
 	OPT_SCAN_CONCURRENTLY,   /* boolean value, default: false                                                 */
 	OPT_SCAN_NOBINS,         /* boolean value, default: false                                                 */
 	OPT_SCAN_INCLUDELDT,     /* Include large data type bin values in addition to large data type bin names   */
@@ -140,7 +236,7 @@ enum Aerospike_opt_keys {
 	OPT_MAP_WRITE_FLAGS,     /* Write flags for as_maps */
 	OPT_TOTAL_TIMEOUT,
 	OPT_MAX_RETRIES,
-	OPT_FAIL_ON_CLUSTER_CHANGE,
+	OPT_FAIL_ON_CLUSTER_CHANGE, /* deprecated, ignored since the C client 6.x */
 	OPT_BATCH_CONCURRENT,
 	OPT_ALLOW_INLINE,
 	OPT_SEND_SET_NAME,
@@ -164,7 +260,20 @@ enum Aerospike_opt_keys {
 	OPT_QUERY_DEFAULT_POL,
 	OPT_SCAN_DEFAULT_POL,
 	OPT_APPLY_DEFAULT_POL,
-	OPT_QUERY_NOBINS
+	OPT_QUERY_NOBINS,
+	OPT_BATCH_RETRY_FAILED_KEYS, /* number of extra rounds for keys whose sub-batch hit a timeout or node failure */
+	OPT_EXISTS_FORMAT,
+	OPT_ITERATOR_QUEUE_SIZE, /* records buffered between the node threads and the PHP thread of an iterator */
+	OPT_MAX_RECORDS, /* approximate number of records a query returns, the page size of a paginated query */
+	OPT_FILTER_EXP, /* an Aerospike\Exp the server evaluates on each record before the command applies to it */
+	OPT_CDT_CTX, /* the nested list or map element a list* method works on, in the "ctx" format of operate() */
+	OPT_LIST_ORDER,          /* Ordering for an as_list */
+	OPT_LIST_WRITE_FLAGS,    /* Write flags for as_lists */
+	OPT_BIT_WRITE_FLAGS,     /* Write flags for the bit operations */
+	OPT_HLL_WRITE_FLAGS,     /* Write flags for the HyperLogLog operations */
+	OPT_READ_OPERATIONS,     /* read operations a scan or query applies to each record, returning their results as the bins */
+	OPT_POLICY_PROFILES,     /* constructor defaults of the records of a namespace or set, overriding the client ones */
+	OPT_BATCH_RESULTS        /* whether getMany() adds the status of each key to its record under "result" */
 };
 
 #endif
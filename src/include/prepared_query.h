@@ -0,0 +1,114 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_PREPARED_QUERY_H
+#define AS_PHP_PREPARED_QUERY_H
+#include "php.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_query.h"
+#include "aerospike/as_scan.h"
+#include "aerospike/as_policy.h"
+#include "php_aerospike_types.h"
+
+typedef enum {
+	AS_PHP_WHERE_EQUALS,
+	AS_PHP_WHERE_BETWEEN,
+	AS_PHP_WHERE_CONTAINS,
+	AS_PHP_WHERE_RANGE,
+	AS_PHP_WHERE_GEO_CONTAINS,
+	AS_PHP_WHERE_GEO_WITHIN
+} as_php_where_op;
+
+/* A where predicate once its array was parsed, the bin and value point into the array */
+typedef struct _as_php_predicate {
+	as_php_where_op op;
+	long index_type;
+	char* bin;
+	zval* val;
+} as_php_predicate;
+
+/*
+ * An Aerospike\Query or Aerospike\Scan. The scan or query, its policy and the shape of its
+ * predicate are built once, each run then gets a copy of them with the value of the predicate
+ * bound, since the C client keeps the progress of a paginated run in the query it is given.
+ */
+typedef struct _AerospikePreparedQuery {
+	/* Runs use the client the scan or query was prepared with, and report their errors on it */
+	zval z_client;
+	/* The where array and options the prepared query points to */
+	zval z_where;
+	zval z_policy;
+
+	bool is_query;
+	bool initialized;
+	as_query query;
+	as_policy_query query_policy;
+	bool has_predicate;
+	as_php_predicate predicate;
+	as_scan scan;
+	as_policy_scan scan_policy;
+	uint32_t queue_size;
+
+	zend_object zobj;
+} AerospikePreparedQuery;
+
+extern zend_class_entry* aerospike_query_ce;
+extern zend_class_entry* aerospike_scan_ce;
+
+bool register_aerospike_prepared_query_classes(void);
+AerospikePreparedQuery* get_aerospike_prepared_query_from_zobj(zend_object* zobj);
+AerospikeClient* get_prepared_query_client(AerospikePreparedQuery* prepared, as_error* err);
+as_status as_php_prepared_query_copy(AerospikePreparedQuery* prepared, zval* z_val, as_query* query,
+		as_error* err);
+as_status as_php_prepared_scan_copy(AerospikePreparedQuery* prepared, as_scan* scan, as_error* err);
+
+as_status parse_predicate_from_php(const HashTable* z_predicate_val, as_php_predicate* predicate,
+		as_error* err);
+as_status add_parsed_predicate_to_query(as_query* query, const as_php_predicate* predicate, zval* val,
+		as_error* err);
+
+PHP_METHOD(AerospikeQuery, execute);
+PHP_METHOD(AerospikeQuery, iterator);
+PHP_METHOD(AerospikeScan, execute);
+PHP_METHOD(AerospikeScan, partitions);
+PHP_METHOD(AerospikeScan, iterator);
+
+ZEND_BEGIN_ARG_INFO_EX(prepared_query_execute_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, record_cb)
+	ZEND_ARG_INFO(0, val)
+	ZEND_ARG_INFO(1, cursor)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(prepared_query_iterator_arg_info, 0, 0, 0)
+	ZEND_ARG_INFO(0, val)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(prepared_scan_execute_arg_info, 0, 0, 1)
+	ZEND_ARG_INFO(0, record_cb)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(prepared_scan_partitions_arg_info, 0, 0, 3)
+	ZEND_ARG_INFO(0, begin)
+	ZEND_ARG_INFO(0, count)
+	ZEND_ARG_INFO(0, record_cb)
+	ZEND_ARG_INFO(1, cursor)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(prepared_scan_iterator_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+#endif
@@ -0,0 +1,54 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_RECORD_ITERATOR_H
+#define AS_PHP_RECORD_ITERATOR_H
+#include "php.h"
+#include "record_stream.h"
+
+/*
+ * An Aerospike\RecordIterator hands the records of its stream to PHP as the application iterates
+ * over it, converting them only then.
+ */
+typedef struct _AerospikeRecordIterator {
+	as_php_record_stream stream;
+
+	/* Keeps the client, the predicate values and the filter expression the stream points to, alive */
+	zval z_client;
+	zval z_where;
+	zval z_policy;
+
+	zval z_current;
+	zend_long position;
+	bool finished;
+	zend_object zobj;
+} AerospikeRecordIterator;
+
+extern zend_class_entry* aerospike_record_iterator_ce;
+
+bool register_aerospike_record_iterator_class(void);
+AerospikeRecordIterator* aerospike_record_iterator_new(zval* z_iterator, zval* z_client, uint32_t queue_size);
+
+PHP_METHOD(AerospikeRecordIterator, current);
+PHP_METHOD(AerospikeRecordIterator, key);
+PHP_METHOD(AerospikeRecordIterator, next);
+PHP_METHOD(AerospikeRecordIterator, rewind);
+PHP_METHOD(AerospikeRecordIterator, valid);
+ZEND_BEGIN_ARG_INFO_EX(record_iterator_no_arg_info, 0, 0, 0)
+ZEND_END_ARG_INFO();
+
+#endif
@@ -0,0 +1,76 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_RECORD_STREAM_H
+#define AS_PHP_RECORD_STREAM_H
+#include "aerospike/aerospike.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_val.h"
+#include "aerospike/as_scan.h"
+#include "aerospike/aerospike_scan.h"
+#include "aerospike/as_query.h"
+#include "aerospike/as_partition_filter.h"
+#include "aerospike/as_policy.h"
+#include "pthread.h"
+
+/*
+ * A scan or query, either run directly with as_php_record_stream_run, or started on a thread of
+ * its own. Started, the C client node threads copy each record, or aggregation result, into a
+ * bounded queue and return, waiting only while the queue is full. The PHP request thread takes
+ * the values out, so the node threads never touch the Zend engine and can run in parallel in ZTS
+ * builds as well.
+ */
+typedef struct _as_php_record_stream {
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty;
+	pthread_cond_t not_full;
+	as_val** values;
+	uint32_t capacity;
+	uint32_t head;
+	uint32_t count;
+	/* The scan or query returned, its error is in err */
+	bool producer_done;
+	/* The PHP side went away, node threads stop at their next value */
+	bool cancelled;
+	as_error err;
+
+	pthread_t thread;
+	bool thread_started;
+
+	aerospike* as;
+	bool is_query;
+	bool scan_initialized;
+	bool query_initialized;
+	as_scan scan;
+	as_policy_scan scan_policy;
+	as_query query;
+	as_policy_query query_policy;
+	/* Scans or queries only the partitions of partition_filter */
+	bool use_partition_filter;
+	as_partition_filter partition_filter;
+} as_php_record_stream;
+
+void as_php_record_stream_init(as_php_record_stream* stream, aerospike* as, uint32_t capacity);
+as_status as_php_record_stream_run(as_php_record_stream* stream, aerospike_scan_foreach_callback callback,
+		void* udata, as_error* err);
+bool as_php_record_stream_needs_thread(as_php_record_stream* stream);
+as_status as_php_record_stream_start(as_php_record_stream* stream, as_error* err);
+as_val* as_php_record_stream_next(as_php_record_stream* stream, as_error* err);
+void as_php_record_stream_stop(as_php_record_stream* stream);
+void as_php_record_stream_destroy(as_php_record_stream* stream);
+
+#endif
@@ -0,0 +1,62 @@
+// *****************************************************************************
+// Copyright 2017 Aerospike, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License")
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// *****************************************************************************
+
+#pragma once
+#ifndef AS_PHP_SCAN_PARTITIONS_H
+#define AS_PHP_SCAN_PARTITIONS_H
+#include "php.h"
+#include "aerospike/as_error.h"
+#include "aerospike/as_key.h"
+#include "aerospike/as_partition_filter.h"
+#include "aerospike/as_query.h"
+
+#define AS_PHP_PARTITION_COUNT 4096
+
+enum as_php_partition_state {
+	AS_PHP_PARTITION_PENDING,
+	/* Records up to digest were handed to the application */
+	AS_PHP_PARTITION_STARTED,
+	AS_PHP_PARTITION_DONE,
+};
+
+typedef struct _as_php_partition_progress {
+	uint8_t state;
+	as_digest_value digest;
+} as_php_partition_progress;
+
+/*
+ * The progress of scanPartitions() over its partition range, as far as the application has seen it.
+ * Lives on the PHP thread only, and travels between calls as the cursor string.
+ */
+typedef struct _as_php_scan_cursor {
+	uint16_t begin;
+	uint16_t count;
+	as_php_partition_progress* partitions;
+} as_php_scan_cursor;
+
+void as_php_scan_cursor_init(as_php_scan_cursor* cursor, uint16_t begin, uint16_t count);
+as_status as_php_scan_cursor_from_string(as_php_scan_cursor* cursor, const char* bytes, size_t len, as_error* err);
+void as_php_scan_cursor_to_zval(as_php_scan_cursor* cursor, zval* z_cursor);
+void as_php_scan_cursor_record(as_php_scan_cursor* cursor, const as_digest* digest);
+void as_php_scan_cursor_finish(as_php_scan_cursor* cursor, uint16_t first, uint16_t count);
+bool as_php_scan_cursor_is_done(as_php_scan_cursor* cursor);
+void as_php_scan_cursor_destroy(as_php_scan_cursor* cursor);
+
+as_status as_php_query_cursor_from_string(const char* bytes, size_t len, as_partitions_status** parts_all,
+		as_error* err);
+as_status as_php_query_cursor_to_zval(const as_query* query, zval* z_cursor, as_error* err);
+
+#endif
@@ -17,14 +17,20 @@
 #include "aerospike/as_error.h"
 #include "php.h"
 #include "aerospike/as_record.h"
-#include "pthread.h"
+#include "record_stream.h"
+#include "scan_partitions.h"
 
 typedef struct _user_callback_function {
 	as_error* err;
 	zend_fcall_info callback;
 	zend_fcall_info_cache callback_cache;
-	pthread_mutex_t* cb_mutex;
+	/* When set, tracks which records the callback was given */
+	as_php_scan_cursor* cursor;
+	/* The callback returned false */
+	bool stopped;
+	/* Lets one C client node thread at a time into the callback */
+	pthread_mutex_t lock;
 } user_callback_function;
 
 as_status execute_user_callback(as_record* record, user_callback_function* callback);
-bool user_callback_wrapper(const as_val *val, void *udata);
+as_status execute_user_callback_on_stream(as_php_record_stream* stream, user_callback_function* callback_info);
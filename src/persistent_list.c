@@ -1,82 +1,192 @@
 #include "persistent_list.h"
 #include "php_aerospike.h"
-
-#define MAX_PORT_SIZE 6
-#define MAX_SHM_SIZE 19
-
-char* get_persistent_search_string(aerospike* as) {
-	char* alias_to_search = NULL;
-	char port_str[MAX_PORT_SIZE];
-
-	int tot_address_size = 0;
-	int tot_port_size = 0;
-	int delimiter_size = 0;
-	int tot_user_size = 0;
-	int tot_shm_size = 0;
-	int i = 0;
-
-	//Calculate total size for search string
-	for (i = 0; i < (int)as->config.hosts->size; i++)
-	{
-		as_host *host = (as_host *)as_vector_get(as->config.hosts, i);
-		tot_address_size = tot_address_size + strlen(host->name);
-		tot_port_size = tot_port_size + MAX_PORT_SIZE;
-		delimiter_size = delimiter_size + 3;
-		tot_user_size = tot_user_size + strlen(as->config.user);
+#include <zend_smart_str.h>
+#include "ext/standard/sha1.h"
+#include <time.h>
+#include "aerospike/aerospike_stats.h"
+#include "aerospike/as_node.h"
+
+static void append_config_string(smart_str* key, const char* value);
+static void append_password_digest(smart_str* key, const char* password);
+static void append_base_policy(smart_str* key, const as_policy_base* base);
+static void append_policies(smart_str* key, const as_policies* policies);
+static void append_persistent_key(smart_str* key, const as_config* config);
+static void reap_idle_persistent_hosts(time_t now);
+static int persistent_host_is_idle(zval* z_host, void* now);
+static void node_pools_to_zval(aerospike* as_client, zval* z_nodes);
+
+#define APPEND_KEY_FIELD(key, field) smart_str_appendl(key, (const char*)&(field), sizeof(field))
+
+/*
+ * The key of the persistent host of a configuration is the normalized form of everything the
+ * cluster connections depend on: seeds, credentials and auth mode, TLS, shm, sync and async pool
+ * settings, and the default policies. Two clients only share a host if all of them are the same,
+ * the host table compares the whole key on top of its hash. The key outlives the request, so it
+ * holds digests of the password and of the TLS key file password rather than the passwords.
+ */
+static void append_persistent_key(smart_str* key, const as_config* config) {
+	uint32_t i = 0;
+
+	for (i = 0; i < config->hosts->size; i++) {
+		as_host* host = (as_host*)as_vector_get(config->hosts, i);
+		append_config_string(key, host->name);
+		append_config_string(key, host->tls_name);
+		smart_str_appendl(key, (const char*)&host->port, sizeof(host->port));
 	}
-	if (as->config.use_shm) {
-		tot_shm_size = MAX_SHM_SIZE;
+	append_config_string(key, config->user);
+	append_password_digest(key, config->password);
+	APPEND_KEY_FIELD(key, config->auth_mode);
+	APPEND_KEY_FIELD(key, config->login_timeout_ms);
+	append_config_string(key, config->cluster_name);
+
+	smart_str_appendl(key, (const char*)&config->tls.enable, sizeof(config->tls.enable));
+	append_config_string(key, config->tls.cafile);
+	append_config_string(key, config->tls.capath);
+	append_config_string(key, config->tls.protocols);
+	append_config_string(key, config->tls.cipher_suite);
+	append_config_string(key, config->tls.cert_blacklist);
+	append_config_string(key, config->tls.keyfile);
+	append_config_string(key, config->tls.certfile);
+	append_password_digest(key, config->tls.keyfile_pw);
+	smart_str_appendl(key, (const char*)&config->tls.crl_check, sizeof(config->tls.crl_check));
+	smart_str_appendl(key, (const char*)&config->tls.crl_check_all, sizeof(config->tls.crl_check_all));
+	smart_str_appendl(key, (const char*)&config->tls.log_session_info, sizeof(config->tls.log_session_info));
+
+	smart_str_appendl(key, (const char*)&config->use_shm, sizeof(config->use_shm));
+	if (config->use_shm) {
+		smart_str_appendl(key, (const char*)&config->shm_key, sizeof(config->shm_key));
+		smart_str_appendl(key, (const char*)&config->shm_max_nodes, sizeof(config->shm_max_nodes));
+		smart_str_appendl(key, (const char*)&config->shm_max_namespaces, sizeof(config->shm_max_namespaces));
+		smart_str_appendl(key, (const char*)&config->shm_takeover_threshold_sec,
+				sizeof(config->shm_takeover_threshold_sec));
 	}
+	smart_str_appendl(key, (const char*)&config->conn_timeout_ms, sizeof(config->conn_timeout_ms));
+	smart_str_appendl(key, (const char*)&config->tender_interval, sizeof(config->tender_interval));
+	smart_str_appendl(key, (const char*)&config->max_conns_per_node, sizeof(config->max_conns_per_node));
+	smart_str_appendl(key, (const char*)&config->min_conns_per_node, sizeof(config->min_conns_per_node));
+	smart_str_appendl(key, (const char*)&config->thread_pool_size, sizeof(config->thread_pool_size));
+	smart_str_appendl(key, (const char*)&config->use_services_alternate, sizeof(config->use_services_alternate));
+	smart_str_appendl(key, (const char*)&config->rack_aware, sizeof(config->rack_aware));
+	smart_str_appendl(key, (const char*)&config->rack_id, sizeof(config->rack_id));
+	APPEND_KEY_FIELD(key, config->async_max_conns_per_node);
+	APPEND_KEY_FIELD(key, config->async_min_conns_per_node);
+	APPEND_KEY_FIELD(key, config->pipe_max_conns_per_node);
+	APPEND_KEY_FIELD(key, config->conn_pools_per_node);
+	APPEND_KEY_FIELD(key, config->max_socket_idle);
+	APPEND_KEY_FIELD(key, config->max_error_rate);
+	APPEND_KEY_FIELD(key, config->error_rate_window);
+	APPEND_KEY_FIELD(key, config->fail_if_not_connected);
+	append_config_string(key, config->lua.user_path);
+
+	append_policies(key, &config->policies);
+	smart_str_0(key);
+}
 
-	alias_to_search = (char*) malloc(tot_address_size + tot_user_size + tot_port_size + delimiter_size + tot_shm_size);
-	if (!alias_to_search) {
-		return NULL;
-	}
-	alias_to_search[0] = '\0';
-
-	for (i=0; i<as->config.hosts->size; i++) {
-		as_host *host = (as_host *)as_vector_get(as->config.hosts, i);
-		int port = host->port;
-		sprintf(port_str, "%d", port);
-		strcat(alias_to_search, host->name);
-		strcat(alias_to_search, ":");
-		strcat(alias_to_search, port_str);
-		strcat(alias_to_search, ":");
-		strcat(alias_to_search, as->config.user);
-		strcat(alias_to_search, ";");
+static void append_password_digest(smart_str* key, const char* password) {
+	PHP_SHA1_CTX context;
+	unsigned char digest[20];
+
+	PHP_SHA1Init(&context);
+	if (password) {
+		PHP_SHA1Update(&context, (const unsigned char*)password, strlen(password));
 	}
+	PHP_SHA1Final(digest, &context);
+	smart_str_appendl(key, (const char*)digest, sizeof(digest));
+}
 
-	if (as->config.use_shm) {
-		char shm_str[MAX_SHM_SIZE];
-		sprintf(shm_str, "%x", as->config.shm_key);
-		strcat(alias_to_search, shm_str);
+static void append_base_policy(smart_str* key, const as_policy_base* base) {
+	APPEND_KEY_FIELD(key, base->socket_timeout);
+	APPEND_KEY_FIELD(key, base->total_timeout);
+	APPEND_KEY_FIELD(key, base->max_retries);
+	APPEND_KEY_FIELD(key, base->sleep_between_retries);
+}
+
+/*
+ * The default policy fields the INI entries and the constructor options can set. They are appended
+ * one by one, the padding between them is not guaranteed to be zeroed.
+ */
+static void append_policies(smart_str* key, const as_policies* policies) {
+	append_base_policy(key, &policies->read.base);
+	APPEND_KEY_FIELD(key, policies->read.key);
+	APPEND_KEY_FIELD(key, policies->read.replica);
+	APPEND_KEY_FIELD(key, policies->read.read_mode_ap);
+	APPEND_KEY_FIELD(key, policies->read.read_mode_sc);
+	APPEND_KEY_FIELD(key, policies->read.deserialize);
+
+	append_base_policy(key, &policies->write.base);
+	APPEND_KEY_FIELD(key, policies->write.key);
+	APPEND_KEY_FIELD(key, policies->write.replica);
+	APPEND_KEY_FIELD(key, policies->write.commit_level);
+	APPEND_KEY_FIELD(key, policies->write.exists);
+	APPEND_KEY_FIELD(key, policies->write.compression_threshold);
+	APPEND_KEY_FIELD(key, policies->write.durable_delete);
+
+	append_base_policy(key, &policies->operate.base);
+	APPEND_KEY_FIELD(key, policies->operate.key);
+	APPEND_KEY_FIELD(key, policies->operate.replica);
+	APPEND_KEY_FIELD(key, policies->operate.commit_level);
+	APPEND_KEY_FIELD(key, policies->operate.exists);
+	APPEND_KEY_FIELD(key, policies->operate.read_mode_ap);
+	APPEND_KEY_FIELD(key, policies->operate.read_mode_sc);
+	APPEND_KEY_FIELD(key, policies->operate.deserialize);
+	APPEND_KEY_FIELD(key, policies->operate.durable_delete);
+
+	append_base_policy(key, &policies->remove.base);
+	APPEND_KEY_FIELD(key, policies->remove.key);
+	APPEND_KEY_FIELD(key, policies->remove.replica);
+	APPEND_KEY_FIELD(key, policies->remove.commit_level);
+	APPEND_KEY_FIELD(key, policies->remove.durable_delete);
+
+	append_base_policy(key, &policies->apply.base);
+	APPEND_KEY_FIELD(key, policies->apply.key);
+	APPEND_KEY_FIELD(key, policies->apply.replica);
+	APPEND_KEY_FIELD(key, policies->apply.commit_level);
+	APPEND_KEY_FIELD(key, policies->apply.durable_delete);
+
+	append_base_policy(key, &policies->batch.base);
+	APPEND_KEY_FIELD(key, policies->batch.concurrent);
+	APPEND_KEY_FIELD(key, policies->batch.allow_inline);
+	APPEND_KEY_FIELD(key, policies->batch.send_set_name);
+	APPEND_KEY_FIELD(key, policies->batch.deserialize);
+	APPEND_KEY_FIELD(key, policies->batch.read_mode_ap);
+	APPEND_KEY_FIELD(key, policies->batch.read_mode_sc);
+
+	append_base_policy(key, &policies->query.base);
+	APPEND_KEY_FIELD(key, policies->query.deserialize);
+
+	append_base_policy(key, &policies->scan.base);
+	APPEND_KEY_FIELD(key, policies->scan.durable_delete);
+	APPEND_KEY_FIELD(key, policies->scan.records_per_second);
+
+	APPEND_KEY_FIELD(key, policies->info.timeout);
+}
+
+/* Strings are appended with their terminator, so that consecutive ones can not run together */
+static void append_config_string(smart_str* key, const char* value) {
+	if (value) {
+		smart_str_appendl(key, value, strlen(value));
 	}
-	return alias_to_search;
+	smart_str_appendc(key, '\0');
 }
 
 
 /* This will only be called if the host does not already exist */
-persistent_host* add_persistent_host(const char* host_key, aerospike* as_client) {
-	size_t len;
-	len = strlen(host_key);
-
+persistent_host* add_persistent_host(zend_string* host_key, aerospike* as_client) {
 	persistent_host* host = (persistent_host*)malloc(sizeof(persistent_host));
-	host->ref_cnt = 1;
+	host->ref_cnt = 0;
 	host->conn_cnt = 0;
 	host->is_connected = false;
 	host->as_client = as_client;
-	zend_hash_str_add_ptr(AEROSPIKE_G(persistent_list_g), host_key, len, (void*)host);
+	host->created = time(NULL);
+	host->last_used = host->created;
+	/* The list is persistent, the str variant copies host_key, a request string, into it */
+	zend_hash_str_add_ptr(AEROSPIKE_G(persistent_list_g), ZSTR_VAL(host_key), ZSTR_LEN(host_key), (void*)host);
 	return host;
 }
 
 
-persistent_host* get_persistent_host(const char* host_key) {
-	persistent_host* host = NULL;
-	size_t len;
-	len = strlen(host_key);
-
-	host = (persistent_host*)zend_hash_str_find_ptr(AEROSPIKE_G(persistent_list_g), host_key, len);
-	return host;
+persistent_host* get_persistent_host(zend_string* host_key) {
+	return (persistent_host*)zend_hash_find_ptr(AEROSPIKE_G(persistent_list_g), host_key);
 }
 
 void persistent_host_dtor(zval* zval) {
@@ -94,23 +204,58 @@ void persistent_host_dtor(zval* zval) {
 	}
 }
 
+/* Called when a client using the host is freed */
+void release_persistent_host(persistent_host* host) {
+	host->ref_cnt--;
+	host->last_used = time(NULL);
+}
+
+/*
+ * Close the hosts no client has used for longer than aerospike.persistent.max_idle seconds. Only
+ * hosts without a client referencing them are closed, 0 keeps all of them open.
+ */
+static void reap_idle_persistent_hosts(time_t now) {
+	if (AEROSPIKE_G(persistent_max_idle) <= 0) {
+		return;
+	}
+	zend_hash_apply_with_argument(AEROSPIKE_G(persistent_list_g), persistent_host_is_idle, &now);
+}
+
+static int persistent_host_is_idle(zval* z_host, void* now) {
+	persistent_host* host = (persistent_host*)Z_PTR_P(z_host);
+
+	if (host->ref_cnt <= 0 && *(time_t*)now - host->last_used > AEROSPIKE_G(persistent_max_idle)) {
+		return ZEND_HASH_APPLY_REMOVE;
+	}
+	return ZEND_HASH_APPLY_KEEP;
+}
+
 as_status persistent_connect(AerospikeClient* client) {
 	as_error err;
 	as_error_init(&err);
 	as_status status = AEROSPIKE_OK;
+	smart_str host_key = {0};
+	time_t now = time(NULL);
 	client->is_persistent = true;
-	char* alias_to_search = get_persistent_search_string(client->as_client);
+	client->persistent_host = NULL;
+
+	reap_idle_persistent_hosts(now);
 
-	if (!alias_to_search) {
+	append_persistent_key(&host_key, &client->as_client->config);
+	if (!host_key.s) {
 		status = AEROSPIKE_ERR_CLIENT;
 		goto CLEANUP;
 	}
 
-	persistent_host* persistent_host = get_persistent_host(alias_to_search);
+	persistent_host* persistent_host = get_persistent_host(host_key.s);
 
 	if (persistent_host) {
 		aerospike_destroy(client->as_client);
 		client->as_client = persistent_host->as_client;
+		/* The client shares the host from here on, even if connecting fails */
+		client->persistent_host = persistent_host;
+		persistent_host->ref_cnt++;
+		persistent_host->last_used = now;
 
 		if (!persistent_host->is_connected) {
 
@@ -124,23 +269,22 @@ as_status persistent_connect(AerospikeClient* client) {
 		} else {
 			persistent_host->conn_cnt++;
 		}
-		persistent_host->ref_cnt++;
 	/* We didn't find an existing host, so create a new one, only if the connection succeeded*/
 	} else {
 		status = aerospike_connect(client->as_client, &err);
 		if (status == AEROSPIKE_OK) {
-			persistent_host = add_persistent_host(alias_to_search, client->as_client);
+			persistent_host = add_persistent_host(host_key.s, client->as_client);
+			persistent_host->ref_cnt = 1;
 			persistent_host->conn_cnt = 1;
 			persistent_host->is_connected = true;
+			client->persistent_host = persistent_host;
 		} else {
 			goto CLEANUP;
 		}
 	}
 
 CLEANUP:
-	if(alias_to_search) {
-		free(alias_to_search);
-	}
+	smart_str_free(&host_key);
 	return status;
 }
 
@@ -150,6 +294,7 @@ as_status non_persistent_connect(AerospikeClient* client) {
 
 	as_status status;
 	client->is_persistent = false;
+	client->persistent_host = NULL;
 	status = aerospike_connect(client->as_client, &err);
 	if (status == AEROSPIKE_OK) {
 		client->is_connected = true;
@@ -158,14 +303,69 @@ as_status non_persistent_connect(AerospikeClient* client) {
 	return status;
 }
 
+/* Add an entry per persistent host of the process to the array return_value */
+void persistent_hosts_to_zval(zval* return_value) {
+	persistent_host* host = NULL;
+	time_t now = time(NULL);
+	zval z_host;
+	zval z_nodes;
+	uint32_t i = 0;
+
+	ZEND_HASH_FOREACH_PTR(AEROSPIKE_G(persistent_list_g), host) {
+		smart_str seeds = {0};
+		as_config* config = &host->as_client->config;
+
+		for (i = 0; i < config->hosts->size; i++) {
+			as_host* seed = (as_host*)as_vector_get(config->hosts, i);
+			if (i) {
+				smart_str_appendc(&seeds, ',');
+			}
+			smart_str_appends(&seeds, seed->name);
+			smart_str_appendc(&seeds, ':');
+			smart_str_append_unsigned(&seeds, seed->port);
+		}
+		smart_str_0(&seeds);
+
+		array_init(&z_host);
+		add_assoc_stringl(&z_host, "hosts", seeds.s ? ZSTR_VAL(seeds.s) : "", seeds.s ? ZSTR_LEN(seeds.s) : 0);
+		add_assoc_string(&z_host, "user", config->user);
+		add_assoc_bool(&z_host, "is_connected", host->is_connected);
+		add_assoc_long(&z_host, "ref_cnt", host->ref_cnt);
+		add_assoc_long(&z_host, "conn_cnt", host->conn_cnt);
+		add_assoc_long(&z_host, "age", (zend_long)(now - host->created));
+		add_assoc_long(&z_host, "last_used", (zend_long)host->last_used);
+		add_assoc_long(&z_host, "min_conns_per_node", config->min_conns_per_node);
+		add_assoc_long(&z_host, "max_conns_per_node", config->max_conns_per_node);
+		node_pools_to_zval(host->is_connected ? host->as_client : NULL, &z_nodes);
+		add_assoc_zval(&z_host, "nodes", &z_nodes);
+		add_next_index_zval(return_value, &z_host);
+		smart_str_free(&seeds);
+	} ZEND_HASH_FOREACH_END();
+}
 
+/*
+ * The fill level of the synchronous connection pool of each node, the idle connections in the pool
+ * and the ones taken out of it by a command
+ */
+static void node_pools_to_zval(aerospike* as_client, zval* z_nodes) {
+	as_cluster_stats stats;
+	zval z_node;
+	uint32_t i = 0;
+
+	array_init(z_nodes);
+	if (!as_client || !as_client->cluster) {
+		return;
+	}
 
+	aerospike_stats(as_client, &stats);
+	for (i = 0; i < stats.nodes_size; i++) {
+		as_node_stats* node_stats = &stats.nodes[i];
 
-
-
-
-
-
-
-
-
+		array_init(&z_node);
+		add_assoc_string(&z_node, "name", node_stats->node->name);
+		add_assoc_long(&z_node, "in_pool", node_stats->sync.in_pool);
+		add_assoc_long(&z_node, "in_use", node_stats->sync.in_use);
+		add_next_index_zval(z_nodes, &z_node);
+	}
+	aerospike_stats_destroy(&stats);
+}
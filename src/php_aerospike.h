@@ -32,13 +32,14 @@ ZEND_BEGIN_MODULE_GLOBALS(aerospike)
 	int write_timeout;
 	char *log_path;
 	char *log_level;
-	int serializer;
+	zend_long serializer;
 	char *lua_user_path;
 	int key_policy;
 	int key_gen;
 	zend_bool shm_use;
 	zend_bool use_batch_direct;
 	int max_threads;
+	zend_long min_conns_per_node;
 	int thread_pool_size;
 	int shm_max_nodes;
 	int shm_max_namespaces;
@@ -46,8 +47,12 @@ ZEND_BEGIN_MODULE_GLOBALS(aerospike)
 	int shm_key;
 	int shm_key_counter;
 	int compression_threshold;
+	zend_long async_event_loops;
+	struct _as_php_completion_queue* completion_queue;
+	HashTable* pending_callbacks;
 	as_error global_error;
 	HashTable *persistent_list_g;
+	zend_long persistent_max_idle;
 	HashTable *shm_key_list_g;
 	int persistent_ref_count;
 	int shm_key_ref_count;
@@ -60,8 +65,7 @@ ZEND_BEGIN_MODULE_GLOBALS(aerospike)
 	uint32_t is_log_callback_registered;
 	zend_fcall_info log_callback_call_info;
 	zend_fcall_info_cache log_callback_call_info_cache;
-
-	pthread_mutex_t query_cb_mutex;
+	zend_bool delivering_logs;
 ZEND_END_MODULE_GLOBALS(aerospike)
 
 ZEND_EXTERN_MODULE_GLOBALS(aerospike);
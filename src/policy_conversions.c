@@ -4,10 +4,13 @@
 #include "php_ini.h"
 #include "php_aerospike.h"
 #include "php_aerospike_types.h"
+#include "expressions.h"
+#include "compiled_policy.h"
 
 /* Static functions */
 
 static as_status set_base_policy_from_hash(HashTable* z_policy_hash, as_policy_base* base_policy);
+static as_status set_filter_exp_from_hash(HashTable* z_policy_hash, as_policy_base* base_policy);
 
 static inline void set_uint32t_policy_value_from_hash_index(HashTable* z_policy_hash, uint32_t* target, int policy_index);
 static inline void set_uint32t_policy_value_from_hash_key(HashTable* z_policy_hash, uint32_t* target, const char* policy_key);
@@ -31,7 +34,7 @@ static inline void set_commit_level_policy_value_from_hash(HashTable* z_policy_h
 // uint32_t 	timeout
 
 as_status zval_to_as_policy_read(zval* z_policy, as_policy_read* read_policy,
-		as_policy_read** read_policy_p, as_policy_read* default_policy) {
+		as_policy_read** read_policy_p, as_policy_read* default_policy, AerospikeClient* client) {
 	as_policy_read_init(read_policy);
 
 	HashTable* z_policy_hash = NULL;
@@ -39,6 +42,12 @@ as_status zval_to_as_policy_read(zval* z_policy, as_policy_read* read_policy,
 	as_policy_read_copy(default_policy, read_policy);
 	*read_policy_p = read_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_read(compiled_policy, read_policy, default_policy, client);
+	}
+
 	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
 		return AEROSPIKE_OK;
 	}
@@ -56,6 +65,11 @@ as_status zval_to_as_policy_read(zval* z_policy, as_policy_read* read_policy,
 		read_policy->base.total_timeout = (uint32_t)Z_LVAL_P(setting_val);
 		setting_val = NULL;
 	}
+
+	if (set_filter_exp_from_hash(z_policy_hash, &read_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_read_policy_from_hash(z_policy_hash, read_policy);
 	return AEROSPIKE_OK;
 }
@@ -72,13 +86,19 @@ as_status zval_to_as_policy_read(zval* z_policy, as_policy_read* read_policy,
 // uint32_t 	timeout
 
 as_status zval_to_as_policy_remove(zval* z_policy, as_policy_remove* remove_policy,
-								   as_policy_remove** remove_policy_p, as_policy_remove* default_policy)
+								   as_policy_remove** remove_policy_p, as_policy_remove* default_policy, AerospikeClient* client)
 {
 	as_policy_remove_init(remove_policy);
 
 	as_policy_remove_copy(default_policy, remove_policy);
 	*remove_policy_p = remove_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_remove(compiled_policy, remove_policy, default_policy, client);
+	}
+
 	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
 		return AEROSPIKE_OK;
 	}
@@ -117,6 +137,10 @@ as_status zval_to_as_policy_remove(zval* z_policy, as_policy_remove* remove_poli
 
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &remove_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_remove_policy_from_hash(z_policy_hash, remove_policy);
 	return AEROSPIKE_OK;
 
@@ -134,12 +158,18 @@ as_status zval_to_as_policy_remove(zval* z_policy, as_policy_remove* remove_poli
 // bool retry_on_timeout;
 // bool durable_delete;
 as_status zval_to_as_policy_write(zval* z_policy, as_policy_write* write_policy,
-								  as_policy_write** write_policy_p, as_policy_write* default_policy) {
+								  as_policy_write** write_policy_p, as_policy_write* default_policy, AerospikeClient* client) {
 
 	as_policy_write_init(write_policy);
 	as_policy_write_copy(default_policy, write_policy);
 	*write_policy_p = write_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_write(compiled_policy, write_policy, default_policy, client);
+	}
+
 	HashTable* z_policy_hash = NULL;
 
 	// IF null was explicitly passed, just return the defaults
@@ -174,6 +204,10 @@ as_status zval_to_as_policy_write(zval* z_policy, as_policy_write* write_policy,
 		setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &write_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_write_policy_from_hash(z_policy_hash, write_policy);
 
 	return AEROSPIKE_OK;
@@ -194,13 +228,19 @@ as_status zval_to_as_policy_write(zval* z_policy, as_policy_write* write_policy,
 // uint32_t 	timeout
 
 as_status zval_to_as_policy_operate(zval* z_policy, as_policy_operate* operate_policy,
-									as_policy_operate** operate_policy_p, as_policy_operate* default_policy) {
+									as_policy_operate** operate_policy_p, as_policy_operate* default_policy, AerospikeClient* client) {
 
 	as_policy_operate_init(operate_policy);
 
-	as_policy_operate_copy(operate_policy, default_policy);
+	as_policy_operate_copy(default_policy, operate_policy);
 	*operate_policy_p = operate_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_operate(compiled_policy, operate_policy, default_policy, client);
+	}
+
 	if (!z_policy) {
 		return AEROSPIKE_OK;
 	}
@@ -237,12 +277,17 @@ as_status zval_to_as_policy_operate(zval* z_policy, as_policy_operate* operate_p
 		setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &operate_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_operate_policy_from_hash(z_policy_hash, operate_policy);
 	return AEROSPIKE_OK;
 }
 
 as_status zval_to_as_policy_info(zval* z_info_policy, as_policy_info* info_policy,
 								 as_policy_info** info_policy_p, as_policy_info* default_policy) {
+	z_info_policy = as_php_policy_options(z_info_policy);
 	zval* setting_val;
 	HashTable* z_policy_hash;
 	as_policy_info_init(info_policy);
@@ -272,7 +317,7 @@ as_status zval_to_as_policy_info(zval* z_info_policy, as_policy_info* info_polic
 }
 
 as_status zval_to_as_policy_apply(zval* z_apply_policy, as_policy_apply* apply_policy,
-								  as_policy_apply** apply_policy_p, as_policy_apply* default_policy) {
+								  as_policy_apply** apply_policy_p, as_policy_apply* default_policy, AerospikeClient* client) {
 	zval* setting_val;
 	HashTable* z_policy_hash;
 
@@ -280,6 +325,12 @@ as_status zval_to_as_policy_apply(zval* z_apply_policy, as_policy_apply* apply_p
 	as_policy_apply_copy(default_policy, apply_policy);
 	*apply_policy_p = apply_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_apply_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_apply(compiled_policy, apply_policy, default_policy, client);
+	}
+
 	if (!z_apply_policy || (Z_TYPE_P(z_apply_policy) == IS_NULL)) {
 		return AEROSPIKE_OK;
 	}
@@ -294,18 +345,28 @@ as_status zval_to_as_policy_apply(zval* z_apply_policy, as_policy_apply* apply_p
 		setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &apply_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_apply_policy_from_hash(z_policy_hash, apply_policy);
 	return AEROSPIKE_OK;
 }
 
 as_status zval_to_as_policy_scan(zval* z_policy, as_policy_scan* scan_policy,
-		as_policy_scan** scan_policy_p, as_policy_scan* default_policy) {
+		as_policy_scan** scan_policy_p, as_policy_scan* default_policy, AerospikeClient* client) {
 
 	as_policy_scan_init(scan_policy);
 	as_policy_scan_copy(default_policy, scan_policy);
 
 	*scan_policy_p = scan_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_scan(compiled_policy, scan_policy, default_policy, client);
+	}
+
 	HashTable* z_policy_hash = NULL;
 
 	// IF null was explicitly passed, just return the defaults
@@ -356,18 +417,28 @@ as_status zval_to_as_policy_scan(zval* z_policy, as_policy_scan* scan_policy,
         setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &scan_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_scan_policy_from_hash(z_policy_hash, scan_policy);
 
 	return AEROSPIKE_OK;
 }
 
 as_status zval_to_as_policy_query(zval* z_policy, as_policy_query* query_policy,
-								  as_policy_query** query_policy_p, as_policy_query* default_policy) {
+								  as_policy_query** query_policy_p, as_policy_query* default_policy, AerospikeClient* client) {
 
 	as_policy_query_init(query_policy);
 	as_policy_query_copy(default_policy, query_policy);
 	*query_policy_p = query_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_query(compiled_policy, query_policy, default_policy, client);
+	}
+
 	HashTable* z_policy_hash = NULL;
 
 	// IF null was explicitly passed, just return the defaults
@@ -394,14 +465,20 @@ as_status zval_to_as_policy_query(zval* z_policy, as_policy_query* query_policy,
 		setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &query_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_query_policy_from_hash(z_policy_hash, query_policy);
 
 	return AEROSPIKE_OK;
 }
 
 as_status set_query_options_from_policy_hash(as_query* query, zval* z_policy) {
+	z_policy = as_php_policy_options(z_policy);
 
 	zval* nobins_val = NULL;
+	zval* max_records_val = NULL;
 	HashTable* z_policy_hash = NULL;
 
 	if (!z_policy ||  Z_TYPE_P(z_policy) == IS_NULL) {
@@ -423,15 +500,29 @@ as_status set_query_options_from_policy_hash(as_query* query, zval* z_policy) {
 		}
 	}
 
+	max_records_val = zend_hash_index_find(z_policy_hash, OPT_MAX_RECORDS);
+	if (max_records_val) {
+		if (Z_TYPE_P(max_records_val) != IS_LONG || Z_LVAL_P(max_records_val) < 0) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		query->max_records = (uint64_t)Z_LVAL_P(max_records_val);
+	}
+
 	return AEROSPIKE_OK;
 }
 
 as_status zval_to_as_policy_batch(zval* z_policy, as_policy_batch* batch_policy,
-								  as_policy_batch** batch_policy_p, as_policy_batch* default_policy) {
+								  as_policy_batch** batch_policy_p, as_policy_batch* default_policy, AerospikeClient* client) {
 	as_policy_batch_init(batch_policy);
 	as_policy_batch_copy(default_policy, batch_policy);
 	*batch_policy_p = batch_policy;
 
+	/* An Aerospike\Policy was resolved ahead */
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		return as_php_policy_copy_batch(compiled_policy, batch_policy, default_policy, client);
+	}
+
 	HashTable* z_policy_hash = NULL;
 
 	// IF null was explicitly passed, just return the defaults
@@ -457,6 +548,10 @@ as_status zval_to_as_policy_batch(zval* z_policy, as_policy_batch* batch_policy,
 		setting_val = NULL;
 	}
 
+	if (set_filter_exp_from_hash(z_policy_hash, &batch_policy->base) != AEROSPIKE_OK) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
 	set_batch_policy_from_hash(z_policy_hash, batch_policy);
 
 	return AEROSPIKE_OK;
@@ -464,6 +559,7 @@ as_status zval_to_as_policy_batch(zval* z_policy, as_policy_batch* batch_policy,
 
 as_status zval_to_as_policy_admin(zval* z_policy, as_policy_admin* admin_policy,
 								  as_policy_admin** admin_policy_p, as_policy_admin* default_policy) {
+	z_policy = as_php_policy_options(z_policy);
 
 	as_policy_admin_init(admin_policy);
 	as_policy_admin_copy(default_policy, admin_policy);
@@ -495,7 +591,8 @@ as_status zval_to_as_policy_admin(zval* z_policy, as_policy_admin* admin_policy,
 
 }
 
-as_status set_scan_options_from_policy_hash(as_scan* scan, zval* z_policy) {
+as_status set_scan_options_from_policy_hash(as_scan* scan, zval* z_policy, as_error* err) {
+	z_policy = as_php_policy_options(z_policy);
 
 	HashTable* z_policy_ary = NULL;
 	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
@@ -503,49 +600,49 @@ as_status set_scan_options_from_policy_hash(as_scan* scan, zval* z_policy) {
 	}
 
 	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
-		return AEROSPIKE_ERR_PARAM;
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
 	}
 
 	zval* setting_val = NULL;
 	z_policy_ary = Z_ARRVAL_P(z_policy);
 
+	/*
+	 * The C client 6.x scans every record of the set, with no priority. Only the values
+	 * which ask for exactly that are still accepted, anything else would be silently ignored.
+	 */
 	setting_val = zend_hash_index_find(z_policy_ary, OPT_SCAN_PRIORITY);
 	if (setting_val) {
-		if (Z_TYPE_P(setting_val) == IS_LONG) {
-			scan->priority = (as_scan_priority)Z_LVAL_P(setting_val);
-		} else {
-			return AEROSPIKE_ERR_PARAM;
+		if (Z_TYPE_P(setting_val) != IS_LONG) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
+		}
+		if (Z_LVAL_P(setting_val) != 0 /* SCAN_PRIORITY_AUTO */) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM,
+					"OPT_SCAN_PRIORITY is no longer supported, only SCAN_PRIORITY_AUTO is accepted");
 		}
 		setting_val = NULL;
 	}
 
 	setting_val = zend_hash_index_find(z_policy_ary, OPT_SCAN_PERCENTAGE);
 	if (setting_val) {
-		if (Z_TYPE_P(setting_val) == IS_LONG) {
-			scan->percent = (uint8_t)Z_LVAL_P(setting_val);
-		} else {
-			return AEROSPIKE_ERR_PARAM;
+		if (Z_TYPE_P(setting_val) != IS_LONG) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
+		}
+		if (Z_LVAL_P(setting_val) != 100) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM,
+					"OPT_SCAN_PERCENTAGE is no longer supported, a scan reads the whole set");
 		}
 		setting_val = NULL;
 	}
 
-/* Concurrent scans run into issues with thread local heap allocations,
- * run by threads not created by php, only allow them when running
- * in non ZTS environment. Run this block all the time to catch invalid
- * options, but in ZTS it will ignore the actual value.
- */
-
 	setting_val = zend_hash_index_find(z_policy_ary, OPT_SCAN_CONCURRENTLY);
 	if (setting_val) {
 		if ((Z_TYPE_P(setting_val) != IS_TRUE) && (Z_TYPE_P(setting_val) != IS_FALSE)) {
-			return AEROSPIKE_ERR_PARAM;
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
 		}
 
-#ifndef ZTS
 		if (Z_TYPE_P(setting_val) == IS_TRUE) {
 			scan->concurrent = true;
 		}
-#endif
 
 		setting_val = NULL;
 	}
@@ -554,7 +651,7 @@ as_status set_scan_options_from_policy_hash(as_scan* scan, zval* z_policy) {
 	if (setting_val) {
 
 		if ((Z_TYPE_P(setting_val) != IS_TRUE) && (Z_TYPE_P(setting_val) != IS_FALSE)) {
-			return AEROSPIKE_ERR_PARAM;
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "Invalid scan options");
 		}
 		if (Z_TYPE_P(setting_val) == IS_TRUE) {
 			scan->no_bins = true;
@@ -579,6 +676,14 @@ as_status set_scan_options_from_policy_hash(as_scan* scan, zval* z_policy) {
 
 /* change this later*/
 as_status set_record_generation_from_write_policy(as_record* record, zval* z_write_policy) {
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_write_policy);
+	if (compiled_policy) {
+		if (compiled_policy->has_generation) {
+			record->gen = compiled_policy->generation;
+		}
+		return AEROSPIKE_OK;
+	}
+
 	if (!z_write_policy || Z_TYPE_P(z_write_policy) != IS_ARRAY) {
 		return AEROSPIKE_OK;
 	}
@@ -609,6 +714,14 @@ as_status set_record_generation_from_write_policy(as_record* record, zval* z_wri
 }
 
 as_status set_operations_generation_from_operate_policy(as_operations* operations, zval* z_op_policy) {
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_op_policy);
+	if (compiled_policy) {
+		if (compiled_policy->has_generation) {
+			operations->gen = compiled_policy->generation;
+		}
+		return AEROSPIKE_OK;
+	}
+
 	if (!z_op_policy || Z_TYPE_P(z_op_policy) == IS_NULL) {
 		return AEROSPIKE_OK;
 	}
@@ -647,6 +760,14 @@ as_status set_operations_generation_from_operate_policy(as_operations* operation
  * Return error if the value is not an integer
  */
 as_status set_operations_ttl_from_operate_policy(as_operations* operations, zval* z_op_policy) {
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_op_policy);
+	if (compiled_policy) {
+		if (compiled_policy->has_ttl) {
+			operations->ttl = compiled_policy->ttl;
+		}
+		return AEROSPIKE_OK;
+	}
+
 	if (!z_op_policy || Z_TYPE_P(z_op_policy) == IS_NULL) {
 		return AEROSPIKE_OK;
 	}
@@ -671,10 +792,21 @@ as_status set_operations_ttl_from_operate_policy(as_operations* operations, zval
 	return AEROSPIKE_OK;
 }
 
+/*
+ * Set serializer_type from the OPT_SERIALIZER of the options. It is left as it is without one, callers
+ * set it to the serializer of the client beforehand.
+ */
 as_status set_serializer_from_policy_hash(int* serializer_type, zval* z_policy) {
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		if (compiled_policy->has_serializer) {
+			*serializer_type = compiled_policy->serializer;
+		}
+		return AEROSPIKE_OK;
+	}
+
 	HashTable* z_policy_ary = NULL;
 	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
-		*serializer_type = INI_INT("aerospike.serializer");
 		return AEROSPIKE_OK;
 	}
 	zval* z_serializer_type = NULL;
@@ -685,7 +817,6 @@ as_status set_serializer_from_policy_hash(int* serializer_type, zval* z_policy)
 
 	z_serializer_type = zend_hash_index_find(z_policy_ary, OPT_SERIALIZER);
 	if (!z_serializer_type) {
-		*serializer_type = INI_INT("aerospike.serializer");
 		return AEROSPIKE_OK;
 	}
 	// invalid policy value
@@ -697,7 +828,146 @@ as_status set_serializer_from_policy_hash(int* serializer_type, zval* z_policy)
 	return AEROSPIKE_OK;
 }
 
+/*
+ * Look for [Aerospike::OPT_BATCH_RETRY_FAILED_KEYS => ####] in a batch policy.
+ * retry_budget is left at -1 if the option was not provided
+ * Return error if the value is not a non negative integer
+ */
+as_status set_batch_retry_budget_from_policy_hash(int* retry_budget, zval* z_policy) {
+	z_policy = as_php_policy_options(z_policy);
+	HashTable* z_policy_ary = NULL;
+	zval* z_retry_budget = NULL;
+
+	*retry_budget = -1;
+	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+	z_policy_ary = Z_ARRVAL_P(z_policy);
+
+	z_retry_budget = zend_hash_index_find(z_policy_ary, OPT_BATCH_RETRY_FAILED_KEYS);
+	if (!z_retry_budget) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_retry_budget) != IS_LONG || Z_LVAL_P(z_retry_budget) < 0) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	*retry_budget = (int)Z_LVAL_P(z_retry_budget);
+	return AEROSPIKE_OK;
+}
+
+/*
+ * Look for [Aerospike::OPT_BATCH_RESULTS => true|false] in a batch policy.
+ * with_results is left false if the option was not provided
+ * Return error if the value is not a boolean
+ */
+as_status set_batch_results_from_policy_hash(bool* with_results, zval* z_policy) {
+	z_policy = as_php_policy_options(z_policy);
+	HashTable* z_policy_ary = NULL;
+	zval* z_with_results = NULL;
+
+	*with_results = false;
+	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+	z_policy_ary = Z_ARRVAL_P(z_policy);
+
+	z_with_results = zend_hash_index_find(z_policy_ary, OPT_BATCH_RESULTS);
+	if (!z_with_results) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_with_results) != IS_TRUE && Z_TYPE_P(z_with_results) != IS_FALSE) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	*with_results = Z_TYPE_P(z_with_results) == IS_TRUE;
+	return AEROSPIKE_OK;
+}
+
+as_status set_exists_format_from_policy_hash(int* exists_format, zval* z_policy) {
+	z_policy = as_php_policy_options(z_policy);
+	HashTable* z_policy_ary = NULL;
+	zval* z_exists_format = NULL;
+
+	*exists_format = EXISTS_FORMAT_BITMAP;
+	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+	z_policy_ary = Z_ARRVAL_P(z_policy);
+
+	z_exists_format = zend_hash_index_find(z_policy_ary, OPT_EXISTS_FORMAT);
+	if (!z_exists_format) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_exists_format) != IS_LONG) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	switch (Z_LVAL_P(z_exists_format)) {
+		case EXISTS_FORMAT_BITMAP:
+		case EXISTS_FORMAT_BOOL:
+			*exists_format = (int)Z_LVAL_P(z_exists_format);
+			return AEROSPIKE_OK;
+		default:
+			return AEROSPIKE_ERR_PARAM;
+	}
+}
+
+/*
+ * Look for [Aerospike::OPT_ITERATOR_QUEUE_SIZE => ####] in a scan or query policy.
+ * Return error if the value is not a positive integer
+ */
+as_status set_iterator_queue_size_from_policy_hash(uint32_t* queue_size, zval* z_policy) {
+	z_policy = as_php_policy_options(z_policy);
+	HashTable* z_policy_ary = NULL;
+	zval* z_queue_size = NULL;
+
+	*queue_size = AS_PHP_ITERATOR_DEFAULT_QUEUE_SIZE;
+	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+	z_policy_ary = Z_ARRVAL_P(z_policy);
+
+	z_queue_size = zend_hash_index_find(z_policy_ary, OPT_ITERATOR_QUEUE_SIZE);
+	if (!z_queue_size) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_queue_size) != IS_LONG || Z_LVAL_P(z_queue_size) <= 0 ||
+			Z_LVAL_P(z_queue_size) > UINT32_MAX) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	*queue_size = (uint32_t)Z_LVAL_P(z_queue_size);
+	return AEROSPIKE_OK;
+}
+
 as_status set_deserializer_from_policy_hash(int* deserializer_type, zval* z_policy) {
+	AerospikePolicy* compiled_policy = as_php_policy_from_zval(z_policy);
+	if (compiled_policy) {
+		*deserializer_type = compiled_policy->has_serializer ? compiled_policy->serializer : SERIALIZER_PHP;
+		return AEROSPIKE_OK;
+	}
+
 	HashTable* z_policy_ary = NULL;
 	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
 		*deserializer_type = SERIALIZER_PHP;
@@ -797,6 +1067,55 @@ zval_to_as_policy_map(zval* z_policy, as_map_policy* map_policy) {
 	return AEROSPIKE_OK;
 }
 
+as_status
+zval_to_as_policy_list(zval* z_policy, as_list_policy* list_policy) {
+
+	HashTable* policy_hash = NULL;
+	as_list_policy_init(list_policy);
+	long list_order = AS_LIST_UNORDERED;
+	long write_flags = AS_LIST_WRITE_DEFAULT;
+
+	if (!z_policy || Z_TYPE_P(z_policy) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	if (Z_TYPE_P(z_policy) != IS_ARRAY) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	policy_hash = Z_ARRVAL_P(z_policy);
+
+	zval* list_order_val = NULL;
+	zval* list_flags_val = NULL;
+
+	list_order_val = zend_hash_index_find(policy_hash, OPT_LIST_ORDER);
+	if (list_order_val) {
+		if (Z_TYPE_P(list_order_val) != IS_LONG) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		list_order = Z_LVAL_P(list_order_val);
+		if (list_order != AS_LIST_UNORDERED && list_order != AS_LIST_ORDERED) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+	}
+
+	list_flags_val = zend_hash_index_find(policy_hash, OPT_LIST_WRITE_FLAGS);
+	if (list_flags_val) {
+		if (Z_TYPE_P(list_flags_val) != IS_LONG) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+		write_flags = Z_LVAL_P(list_flags_val);
+		if (write_flags & ~(AS_LIST_WRITE_ADD_UNIQUE | AS_LIST_WRITE_INSERT_BOUNDED |
+				AS_LIST_WRITE_NO_FAIL | AS_LIST_WRITE_PARTIAL)) {
+			return AEROSPIKE_ERR_PARAM;
+		}
+	}
+
+	as_list_policy_set(list_policy, list_order, write_flags);
+
+	return AEROSPIKE_OK;
+}
+
 as_status set_read_policy_from_hash(HashTable* z_policy_hash, as_policy_read* read_policy) {
 
 	if (!z_policy_hash) {
@@ -900,7 +1219,6 @@ as_status set_scan_policy_from_hash(HashTable* z_policy_hash, as_policy_scan* sc
 	}
 
 	set_bool_policy_value_from_hash_index(z_policy_hash, &scan_policy->durable_delete, OPT_POLICY_DURABLE_DELETE);
-	set_bool_policy_value_from_hash_index(z_policy_hash, &scan_policy->fail_on_cluster_change, OPT_FAIL_ON_CLUSTER_CHANGE);
 	set_uint32t_policy_value_from_hash_index(z_policy_hash, &scan_policy->records_per_second, OPT_SCAN_RPS_LIMIT);
 	set_base_policy_from_hash(z_policy_hash, &scan_policy->base);
 	return AEROSPIKE_OK;
@@ -930,6 +1248,26 @@ static as_status set_base_policy_from_hash(HashTable* z_policy_hash, as_policy_b
 	return AEROSPIKE_OK;
 }
 
+/*
+ * Only per call policies take a filter expression, the compiled expression belongs to the
+ * Aerospike\Exp object, which lives in the options array for the duration of the call
+ */
+static as_status set_filter_exp_from_hash(HashTable* z_policy_hash, as_policy_base* base_policy) {
+	zval* setting_val = NULL;
+
+	setting_val = zend_hash_index_find(z_policy_hash, OPT_FILTER_EXP);
+	if (!setting_val || Z_TYPE_P(setting_val) == IS_NULL) {
+		return AEROSPIKE_OK;
+	}
+
+	base_policy->filter_exp = as_php_exp_compile(setting_val);
+	if (!base_policy->filter_exp) {
+		return AEROSPIKE_ERR_PARAM;
+	}
+
+	return AEROSPIKE_OK;
+}
+
 static inline void set_uint32t_policy_value_from_hash_index(HashTable* z_policy_hash, uint32_t* target, int policy_index) {
 	zval* setting_val = NULL;
 	setting_val = zend_hash_index_find(z_policy_hash, policy_index);
@@ -72,6 +72,23 @@ static AerospikeGeneralLongConstant aerospike_general_long_constants[] = {
 	{ OP_LIST_GET_RANGE,    		   "OP_LIST_GET_RANGE"            },
 	{ OP_LIST_TRIM,         		   "OP_LIST_TRIM"                 },
 	{ OP_LIST_SIZE,         		   "OP_LIST_SIZE"                 },
+	{ OP_LIST_SET_ORDER,               "OP_LIST_SET_ORDER"            },
+	{ OP_LIST_SORT,                    "OP_LIST_SORT"                 },
+	{ OP_LIST_INCREMENT,               "OP_LIST_INCREMENT"            },
+	{ OP_LIST_GET_BY_INDEX,            "OP_LIST_GET_BY_INDEX"         },
+	{ OP_LIST_GET_BY_INDEX_RANGE,      "OP_LIST_GET_BY_INDEX_RANGE"   },
+	{ OP_LIST_GET_BY_RANK,             "OP_LIST_GET_BY_RANK"          },
+	{ OP_LIST_GET_BY_RANK_RANGE,       "OP_LIST_GET_BY_RANK_RANGE"    },
+	{ OP_LIST_GET_BY_VALUE,            "OP_LIST_GET_BY_VALUE"         },
+	{ OP_LIST_GET_BY_VALUE_LIST,       "OP_LIST_GET_BY_VALUE_LIST"    },
+	{ OP_LIST_GET_BY_VALUE_RANGE,      "OP_LIST_GET_BY_VALUE_RANGE"   },
+	{ OP_LIST_REMOVE_BY_INDEX,         "OP_LIST_REMOVE_BY_INDEX"      },
+	{ OP_LIST_REMOVE_BY_INDEX_RANGE,   "OP_LIST_REMOVE_BY_INDEX_RANGE"},
+	{ OP_LIST_REMOVE_BY_RANK,          "OP_LIST_REMOVE_BY_RANK"       },
+	{ OP_LIST_REMOVE_BY_RANK_RANGE,    "OP_LIST_REMOVE_BY_RANK_RANGE" },
+	{ OP_LIST_REMOVE_BY_VALUE,         "OP_LIST_REMOVE_BY_VALUE"      },
+	{ OP_LIST_REMOVE_BY_VALUE_LIST,    "OP_LIST_REMOVE_BY_VALUE_LIST" },
+	{ OP_LIST_REMOVE_BY_VALUE_RANGE,   "OP_LIST_REMOVE_BY_VALUE_RANGE"},
 	{ OP_MAP_SET_POLICY,               "OP_MAP_SET_POLICY"            },
 	{ OP_MAP_PUT,                      "OP_MAP_PUT"                   },
 	{ OP_MAP_PUT_ITEMS,                "OP_MAP_PUT_ITEMS"             },
@@ -96,7 +113,45 @@ static AerospikeGeneralLongConstant aerospike_general_long_constants[] = {
 	{ OP_MAP_GET_BY_INDEX,             "OP_MAP_GET_BY_INDEX"          },
 	{ OP_MAP_GET_BY_INDEX_RANGE,       "OP_MAP_GET_BY_INDEX_RANGE"    },
 	{ OP_MAP_GET_BY_RANK,              "OP_MAP_GET_BY_RANK"           },
-	{ OP_MAP_GET_BY_RANK_RANGE,        "OP_MAP_GET_BY_RANK_RANGE"     }
+	{ OP_MAP_GET_BY_RANK_RANGE,        "OP_MAP_GET_BY_RANK_RANGE"     },
+	{ OP_MAP_GET_BY_KEY_LIST,          "OP_MAP_GET_BY_KEY_LIST"       },
+	{ OP_MAP_GET_BY_VALUE_LIST,        "OP_MAP_GET_BY_VALUE_LIST"     },
+	{ OP_BIT_RESIZE,                   "OP_BIT_RESIZE"                },
+	{ OP_BIT_INSERT,                   "OP_BIT_INSERT"                },
+	{ OP_BIT_REMOVE,                   "OP_BIT_REMOVE"                },
+	{ OP_BIT_SET,                      "OP_BIT_SET"                   },
+	{ OP_BIT_OR,                       "OP_BIT_OR"                    },
+	{ OP_BIT_XOR,                      "OP_BIT_XOR"                   },
+	{ OP_BIT_AND,                      "OP_BIT_AND"                   },
+	{ OP_BIT_NOT,                      "OP_BIT_NOT"                   },
+	{ OP_BIT_LSHIFT,                   "OP_BIT_LSHIFT"                },
+	{ OP_BIT_RSHIFT,                   "OP_BIT_RSHIFT"                },
+	{ OP_BIT_ADD,                      "OP_BIT_ADD"                   },
+	{ OP_BIT_SUBTRACT,                 "OP_BIT_SUBTRACT"              },
+	{ OP_BIT_SET_INT,                  "OP_BIT_SET_INT"               },
+	{ OP_BIT_GET,                      "OP_BIT_GET"                   },
+	{ OP_BIT_COUNT,                    "OP_BIT_COUNT"                 },
+	{ OP_BIT_LSCAN,                    "OP_BIT_LSCAN"                 },
+	{ OP_BIT_RSCAN,                    "OP_BIT_RSCAN"                 },
+	{ OP_BIT_GET_INT,                  "OP_BIT_GET_INT"               },
+	{ OP_HLL_INIT,                     "OP_HLL_INIT"                  },
+	{ OP_HLL_ADD,                      "OP_HLL_ADD"                   },
+	{ OP_HLL_SET_UNION,                "OP_HLL_SET_UNION"             },
+	{ OP_HLL_REFRESH_COUNT,            "OP_HLL_REFRESH_COUNT"         },
+	{ OP_HLL_FOLD,                     "OP_HLL_FOLD"                  },
+	{ OP_HLL_GET_COUNT,                "OP_HLL_GET_COUNT"             },
+	{ OP_HLL_GET_UNION,                "OP_HLL_GET_UNION"             },
+	{ OP_HLL_GET_UNION_COUNT,          "OP_HLL_GET_UNION_COUNT"       },
+	{ OP_HLL_GET_INTERSECT_COUNT,      "OP_HLL_GET_INTERSECT_COUNT"   },
+	{ OP_HLL_GET_SIMILARITY,           "OP_HLL_GET_SIMILARITY"        },
+	{ OP_HLL_DESCRIBE,                 "OP_HLL_DESCRIBE"              },
+	{ CDT_CTX_LIST_INDEX,              "CDT_CTX_LIST_INDEX"           },
+	{ CDT_CTX_LIST_RANK,               "CDT_CTX_LIST_RANK"            },
+	{ CDT_CTX_LIST_VALUE,              "CDT_CTX_LIST_VALUE"           },
+	{ CDT_CTX_MAP_INDEX,               "CDT_CTX_MAP_INDEX"            },
+	{ CDT_CTX_MAP_RANK,                "CDT_CTX_MAP_RANK"             },
+	{ CDT_CTX_MAP_KEY,                 "CDT_CTX_MAP_KEY"              },
+	{ CDT_CTX_MAP_VALUE,               "CDT_CTX_MAP_VALUE"            }
 };
 
 static AerospikeStatus aerospike_status[] = {
@@ -106,6 +161,7 @@ static AerospikeStatus aerospike_status[] = {
 		{ AEROSPIKE_ERR_NO_MORE_CONNECTIONS       ,   "ERR_NO_MORE_CONNECTIONS"            },
 		{ AEROSPIKE_ERR_ASYNC_CONNECTION          ,   "ERR_ASYNC_CONNECTION"               },
 		{ AEROSPIKE_ERR_CLIENT_ABORT              ,   "ERR_CLIENT_ABORT"                   },
+		{ AEROSPIKE_NO_RESPONSE                   ,   "ERR_NO_RESPONSE"                    },
 		{ AEROSPIKE_ERR_INVALID_HOST              ,   "ERR_INVALID_HOST"                   },
 		{ AEROSPIKE_ERR_PARAM                     ,   "ERR_PARAM"                          },
 		{ AEROSPIKE_ERR_CLIENT                    ,   "ERR_CLIENT"                         },
@@ -133,6 +189,7 @@ static AerospikeStatus aerospike_status[] = {
 		{ AEROSPIKE_ERR_FAIL_FORBIDDEN            ,   "ERR_FORBIDDEN"                      },
 		{ AEROSPIKE_ERR_FAIL_ELEMENT_NOT_FOUND    ,   "ERR_FAIL_NOT_FOUND"                 },
 		{ AEROSPIKE_ERR_FAIL_ELEMENT_EXISTS       ,   "ERR_FAIL_ELEMENT_EXISTS"            },
+		{ AEROSPIKE_FILTERED_OUT                  ,   "ERR_FILTERED_OUT"                   },
 		{ AEROSPIKE_QUERY_END                     ,   "ERR_QUERY_END"                      },
 		{ AEROSPIKE_ERR_UDF                       ,   "ERR_UDF"                            },
 		{ AEROSPIKE_ERR_BATCH_DISABLED            ,   "ERR_BATCH_DISABLED"                 },
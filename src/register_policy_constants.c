@@ -8,6 +8,9 @@
 #include "aerospike/as_admin.h"
 #include "aerospike/as_operations.h"
 #include "aerospike/as_map_operations.h"
+#include "aerospike/as_list_operations.h"
+#include "aerospike/as_bit_operations.h"
+#include "aerospike/as_hll_operations.h"
 
 #define AEROSPIKE_OPTION_CONSTANTS_ARR_SIZE (sizeof(aerospike_option_constants)/sizeof(AerospikeOptionConstant))
 #define AEROSPIKE_OPTION_STRCONSTANTS_ARR_SIZE (sizeof(aerospike_str_option_constants)/sizeof(AerospikeStrOptionConstant))
@@ -64,10 +67,11 @@ AerospikeOptionConstant aerospike_option_constants[] = {
 	{ SERIALIZER_PHP                        ,   "SERIALIZER_PHP"                    },
 	{ SERIALIZER_USER                       ,   "SERIALIZER_USER"                   },
 	{ AS_UDF_TYPE_LUA                       ,   "UDF_TYPE_LUA"                      },
-	{ AS_SCAN_PRIORITY_AUTO                 ,   "SCAN_PRIORITY_AUTO"                },
-	{ AS_SCAN_PRIORITY_LOW                  ,   "SCAN_PRIORITY_LOW"                 },
-	{ AS_SCAN_PRIORITY_MEDIUM               ,   "SCAN_PRIORITY_MEDIUM"              },
-	{ AS_SCAN_PRIORITY_HIGH                 ,   "SCAN_PRIORITY_HIGH"                },
+	/* Deprecated: as_scan_priority is gone from the C client 6.x, the values are kept for BC */
+	{ 0                                     ,   "SCAN_PRIORITY_AUTO"                },
+	{ 1                                     ,   "SCAN_PRIORITY_LOW"                 },
+	{ 2                                     ,   "SCAN_PRIORITY_MEDIUM"              },
+	{ 3                                     ,   "SCAN_PRIORITY_HIGH"                },
 	{ AS_SCAN_STATUS_UNDEF                  ,   "SCAN_STATUS_UNDEF"                 },
 	{ AS_SCAN_STATUS_INPROGRESS             ,   "SCAN_STATUS_INPROGRESS"            },
 	{ AS_SCAN_STATUS_ABORTED                ,   "SCAN_STATUS_ABORTED"               },
@@ -92,6 +96,9 @@ AerospikeOptionConstant aerospike_option_constants[] = {
 	{ AS_POLICY_READ_MODE_SC_ALLOW_UNAVAILABLE , "POLICY_READ_MODE_SC_ALLOW_UNAVAILABLE"},
 	{ AS_POLICY_COMMIT_LEVEL_ALL            ,   "POLICY_COMMIT_LEVEL_ALL"           },
 	{ AS_POLICY_COMMIT_LEVEL_MASTER         ,   "POLICY_COMMIT_LEVEL_MASTER"        },
+	{ AS_AUTH_INTERNAL                      ,   "AUTH_INTERNAL"                     },
+	{ AS_AUTH_EXTERNAL                      ,   "AUTH_EXTERNAL"                     },
+	{ AS_AUTH_EXTERNAL_INSECURE             ,   "AUTH_EXTERNAL_INSECURE"            },
 	{ AS_PRIVILEGE_USER_ADMIN               ,   "PRIV_USER_ADMIN"                   },
 	{ AS_PRIVILEGE_SYS_ADMIN                ,   "PRIV_SYS_ADMIN"                    },
 	{ AS_PRIVILEGE_READ                     ,   "PRIV_READ"                         },
@@ -123,6 +130,44 @@ AerospikeOptionConstant aerospike_option_constants[] = {
 	{AS_MAP_RETURN_KEY                      ,   "MAP_RETURN_KEY"                    },
 	{AS_MAP_RETURN_VALUE                    ,   "MAP_RETURN_VALUE"                  },
 	{AS_MAP_RETURN_KEY_VALUE                ,   "MAP_RETURN_KEY_VALUE"              },
+	{ OPT_LIST_ORDER                        ,   "OPT_LIST_ORDER"                    },
+	{ OPT_LIST_WRITE_FLAGS                  ,   "OPT_LIST_WRITE_FLAGS"              },
+	{ AS_LIST_UNORDERED                     ,   "AS_LIST_UNORDERED"                 },
+	{ AS_LIST_ORDERED                       ,   "AS_LIST_ORDERED"                   },
+	{ AS_LIST_WRITE_DEFAULT                 ,   "AS_LIST_WRITE_DEFAULT"             },
+	{ AS_LIST_WRITE_ADD_UNIQUE              ,   "AS_LIST_WRITE_ADD_UNIQUE"          },
+	{ AS_LIST_WRITE_INSERT_BOUNDED          ,   "AS_LIST_WRITE_INSERT_BOUNDED"      },
+	{ AS_LIST_WRITE_NO_FAIL                 ,   "AS_LIST_WRITE_NO_FAIL"             },
+	{ AS_LIST_WRITE_PARTIAL                 ,   "AS_LIST_WRITE_PARTIAL"             },
+	{ AS_LIST_SORT_DEFAULT                  ,   "AS_LIST_SORT_DEFAULT"              },
+	{ AS_LIST_SORT_DROP_DUPLICATES          ,   "AS_LIST_SORT_DROP_DUPLICATES"      },
+	{AS_LIST_RETURN_NONE                    ,   "LIST_RETURN_NONE"                  },
+	{AS_LIST_RETURN_INDEX                   ,   "LIST_RETURN_INDEX"                 },
+	{AS_LIST_RETURN_REVERSE_INDEX           ,   "LIST_RETURN_REVERSE_INDEX"         },
+	{AS_LIST_RETURN_RANK                    ,   "LIST_RETURN_RANK"                  },
+	{AS_LIST_RETURN_REVERSE_RANK            ,   "LIST_RETURN_REVERSE_RANK"          },
+	{AS_LIST_RETURN_COUNT                   ,   "LIST_RETURN_COUNT"                 },
+	{AS_LIST_RETURN_VALUE                   ,   "LIST_RETURN_VALUE"                 },
+	{AS_LIST_RETURN_INVERTED                ,   "LIST_RETURN_INVERTED"              },
+	{ OPT_BIT_WRITE_FLAGS                   ,   "OPT_BIT_WRITE_FLAGS"               },
+	{ AS_BIT_WRITE_DEFAULT                  ,   "AS_BIT_WRITE_DEFAULT"              },
+	{ AS_BIT_WRITE_CREATE_ONLY              ,   "AS_BIT_WRITE_CREATE_ONLY"          },
+	{ AS_BIT_WRITE_UPDATE_ONLY              ,   "AS_BIT_WRITE_UPDATE_ONLY"          },
+	{ AS_BIT_WRITE_NO_FAIL                  ,   "AS_BIT_WRITE_NO_FAIL"              },
+	{ AS_BIT_WRITE_PARTIAL                  ,   "AS_BIT_WRITE_PARTIAL"              },
+	{ AS_BIT_RESIZE_DEFAULT                 ,   "AS_BIT_RESIZE_DEFAULT"             },
+	{ AS_BIT_RESIZE_FROM_FRONT              ,   "AS_BIT_RESIZE_FROM_FRONT"          },
+	{ AS_BIT_RESIZE_GROW_ONLY               ,   "AS_BIT_RESIZE_GROW_ONLY"           },
+	{ AS_BIT_RESIZE_SHRINK_ONLY             ,   "AS_BIT_RESIZE_SHRINK_ONLY"         },
+	{ AS_BIT_OVERFLOW_FAIL                  ,   "AS_BIT_OVERFLOW_FAIL"              },
+	{ AS_BIT_OVERFLOW_SATURATE              ,   "AS_BIT_OVERFLOW_SATURATE"          },
+	{ AS_BIT_OVERFLOW_WRAP                  ,   "AS_BIT_OVERFLOW_WRAP"              },
+	{ OPT_HLL_WRITE_FLAGS                   ,   "OPT_HLL_WRITE_FLAGS"               },
+	{ AS_HLL_WRITE_DEFAULT                  ,   "AS_HLL_WRITE_DEFAULT"              },
+	{ AS_HLL_WRITE_CREATE_ONLY              ,   "AS_HLL_WRITE_CREATE_ONLY"          },
+	{ AS_HLL_WRITE_UPDATE_ONLY              ,   "AS_HLL_WRITE_UPDATE_ONLY"          },
+	{ AS_HLL_WRITE_NO_FAIL                  ,   "AS_HLL_WRITE_NO_FAIL"              },
+	{ AS_HLL_WRITE_ALLOW_FOLD               ,   "AS_HLL_WRITE_ALLOW_FOLD"           },
 	{ OPT_TOTAL_TIMEOUT                     ,   "OPT_TOTAL_TIMEOUT"                 },
 	{ OPT_MAX_RETRIES                       ,   "OPT_MAX_RETRIES"                   },
 	{ OPT_FAIL_ON_CLUSTER_CHANGE            ,   "OPT_FAIL_ON_CLUSTER_CHANGE"        },
@@ -149,7 +194,18 @@ AerospikeOptionConstant aerospike_option_constants[] = {
 	{OPT_QUERY_DEFAULT_POL                  ,   "OPT_QUERY_DEFAULT_POL"             },
 	{OPT_SCAN_DEFAULT_POL                   ,   "OPT_SCAN_DEFAULT_POL"              },
 	{OPT_APPLY_DEFAULT_POL                  ,   "OPT_APPLY_DEFAULT_POL"             },
-	{OPT_QUERY_NOBINS                       ,   "OPT_QUERY_NOBINS"                  }
+	{OPT_QUERY_NOBINS                       ,   "OPT_QUERY_NOBINS"                  },
+	{OPT_BATCH_RETRY_FAILED_KEYS            ,   "OPT_BATCH_RETRY_FAILED_KEYS"       },
+	{OPT_EXISTS_FORMAT                      ,   "OPT_EXISTS_FORMAT"                 },
+	{OPT_ITERATOR_QUEUE_SIZE                ,   "OPT_ITERATOR_QUEUE_SIZE"           },
+	{OPT_MAX_RECORDS                        ,   "OPT_MAX_RECORDS"                   },
+	{OPT_FILTER_EXP                         ,   "OPT_FILTER_EXP"                    },
+	{OPT_CDT_CTX                            ,   "OPT_CDT_CTX"                       },
+	{OPT_READ_OPERATIONS                    ,   "OPT_READ_OPERATIONS"               },
+	{OPT_POLICY_PROFILES                    ,   "OPT_POLICY_PROFILES"               },
+	{OPT_BATCH_RESULTS                      ,   "OPT_BATCH_RESULTS"                 },
+	{EXISTS_FORMAT_BITMAP                   ,   "EXISTS_FORMAT_BITMAP"              },
+	{EXISTS_FORMAT_BOOL                     ,   "EXISTS_FORMAT_BOOL"                }
 };
 
 static AerospikeStrOptionConstant aerospike_str_option_constants[] = {
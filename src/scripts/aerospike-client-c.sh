@@ -26,7 +26,7 @@ LIB_PATH=${PREFIX}
 DOWNLOAD=${DOWNLOAD_C_CLIENT:-1}
 COPY_FILES=1
 DOWNLOAD_DIR=${AEROSPIKE}/package
-AEROSPIKE_C_VERSION=${AEROSPIKE_C_VERSION:-'4.5.0'}
+AEROSPIKE_C_VERSION=${AEROSPIKE_C_VERSION:-'6.0.0'}
 unset PKG_TYPE PKG_VERSION PKG_SUFFIX PKG_ARTIFACT
 
 
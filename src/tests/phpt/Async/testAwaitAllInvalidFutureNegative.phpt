@@ -0,0 +1,11 @@
+--TEST--
+ awaitAll with an entry which is not a future.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Async", "testAwaitAllInvalidFutureNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,11 @@
+--TEST--
+ getAsync for several keys collected with awaitAll.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Async", "testGetAsyncAwaitAllPositive");
+--EXPECT--
+OK
@@ -0,0 +1,11 @@
+--TEST--
+ getAsync with a bin filter on a non-existent key.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Async", "testGetAsyncNonExistentKeyPositive");
+--EXPECT--
+OK
@@ -0,0 +1,11 @@
+--TEST--
+ onComplete with a callback which is not callable.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Async", "testOnCompleteNotCallableNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,11 @@
+--TEST--
+ onComplete callbacks run by Aerospike::poll() once the completion stream is readable.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Async", "testPollCompletionCallbacksPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ queryOperate() only writes the records matching its predicate.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("BackgroundOperate", "testQueryOperatePredicatePositive");
+--EXPECT--
+OK
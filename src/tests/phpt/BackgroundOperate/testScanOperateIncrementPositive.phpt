@@ -0,0 +1,9 @@
+--TEST--
+ scanOperate() increments a bin and removes another on every record of the set.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("BackgroundOperate", "testScanOperateIncrementPositive");
+--EXPECT--
+OK
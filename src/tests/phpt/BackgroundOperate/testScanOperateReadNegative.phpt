@@ -0,0 +1,9 @@
+--TEST--
+ scanOperate() refuses read operations.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("BackgroundOperate", "testScanOperateReadNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ A ctx step of an unknown type is refused.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CdtContext", "testCdtContextInvalidNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ The list* methods work on the nested list given by OPT_CDT_CTX.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CdtContext", "testCdtContextListMethodsPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ operate() updates and reads elements of a list nested in a map.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CdtContext", "testCdtContextOperatePositive");
+--EXPECT--
+OK
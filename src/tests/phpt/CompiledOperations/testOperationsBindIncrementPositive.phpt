@@ -0,0 +1,9 @@
+--TEST--
+ A template is bound to a new increment on each operate().
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledOperations", "testOperationsBindIncrementPositive");
+--EXPECT--
+OK
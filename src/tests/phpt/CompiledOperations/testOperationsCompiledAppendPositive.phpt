@@ -0,0 +1,9 @@
+--TEST--
+ A template appending a string built at runtime keeps it after the array is gone.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledOperations", "testOperationsCompiledAppendPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ operateOrdered() reuses a template without params, with its list operations.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledOperations", "testOperationsCompiledListPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ operate() refuses a template whose params were not bound.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledOperations", "testOperationsUnboundNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ A policy is reused across get() calls, its filter expression applying to each.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledPolicy", "testPolicyGetReusedPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ Policy::create() refuses an invalid ttl.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledPolicy", "testPolicyInvalidTtlNegative");
+--EXPECT--
+ERR_PARAM
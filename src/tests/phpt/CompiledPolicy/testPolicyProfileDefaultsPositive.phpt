@@ -0,0 +1,9 @@
+--TEST--
+ One policy used with the keys of two profiles, then with a new client, applies the defaults each key resolves to.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledPolicy", "testPolicyProfileDefaultsPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ put() applies the generation carried by a policy.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("CompiledPolicy", "testPolicyPutGenerationPositive");
+--EXPECT--
+OK
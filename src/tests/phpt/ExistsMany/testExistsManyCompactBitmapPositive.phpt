@@ -0,0 +1,9 @@
+--TEST--
+ existsManyCompact returning a bitmap with one non-existent key.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ExistsMany", "testExistsManyCompactBitmapPositive");
+--EXPECT--
+OK
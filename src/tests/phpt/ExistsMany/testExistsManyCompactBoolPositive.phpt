@@ -0,0 +1,9 @@
+--TEST--
+ existsManyCompact returning a packed array of bools.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ExistsMany", "testExistsManyCompactBoolPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ existsManyCompact with an invalid OPT_EXISTS_FORMAT.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ExistsMany", "testExistsManyCompactFormatNegative");
+--EXPECT--
+ERR_PARAM
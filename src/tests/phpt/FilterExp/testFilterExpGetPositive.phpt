@@ -0,0 +1,9 @@
+--TEST--
+ get() returns a record the expression accepts and refuses one it rejects.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("FilterExp", "testFilterExpGetPositive");
+--EXPECT--
+OK
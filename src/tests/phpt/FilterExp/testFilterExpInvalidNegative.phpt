@@ -0,0 +1,9 @@
+--TEST--
+ An OPT_FILTER_EXP which is not an Aerospike\Exp is refused.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("FilterExp", "testFilterExpInvalidNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ An extended, case insensitive regex matches the bin, not the regex itself.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("FilterExp", "testFilterExpRegexPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ scan() only returns the records the expression accepts.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("FilterExp", "testFilterExpScanPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ A string expression used by two filters matches in both of them.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("FilterExp", "testFilterExpSharedStrPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+GetMany - per key result codes
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("GetMany", "testGetManyPerKeyResultPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+GetMany - negative retry budget
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("GetMany", "testGetManyRetryFailedKeysNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+GetMany - retry budget for failed sub-batches
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("GetMany", "testGetManyRetryFailedKeysPositive");
+--EXPECT--
+OK
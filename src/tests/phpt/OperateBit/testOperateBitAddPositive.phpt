@@ -0,0 +1,9 @@
+--TEST--
+ OP_BIT_ADD increments a counter held in the bits of a bytes bin.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateBit", "testOperateBitAddPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ A bit operation without a bit_size is refused.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateBit", "testOperateBitNoSizeNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ Flags set with OP_BIT_OR are counted and found by OP_BIT_LSCAN.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateBit", "testOperateBitOrCountPositive");
+--EXPECT--
+OK
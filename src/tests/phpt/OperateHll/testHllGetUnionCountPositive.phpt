@@ -0,0 +1,9 @@
+--TEST--
+ hllGetUnionCount and hllGetUnion merge the HLL bins of several records.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateHll", "testHllGetUnionCountPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ OP_HLL_ADD skips values already seen and OP_HLL_GET_COUNT counts the distinct ones.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateHll", "testOperateHllAddCountPositive");
+--EXPECT--
+OK
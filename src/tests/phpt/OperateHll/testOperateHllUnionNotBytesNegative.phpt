@@ -0,0 +1,9 @@
+--TEST--
+ A union operation on values which are not HLLs is refused.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateHll", "testOperateHllUnionNotBytesNegative");
+--EXPECT--
+ERR_PARAM
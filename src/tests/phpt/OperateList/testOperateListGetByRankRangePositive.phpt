@@ -0,0 +1,9 @@
+--TEST--
+ OP_LIST_GET_BY_RANK_RANGE returns the largest values of the list.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateList", "testOperateListGetByRankRangePositive");
+--EXPECT--
+OK
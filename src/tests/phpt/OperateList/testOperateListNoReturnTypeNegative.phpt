@@ -0,0 +1,9 @@
+--TEST--
+ A list operation selecting elements without a return_type is refused.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateList", "testOperateListNoReturnTypeNegative");
+--EXPECT--
+ERR_PARAM
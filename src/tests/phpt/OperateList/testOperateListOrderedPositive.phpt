@@ -0,0 +1,9 @@
+--TEST--
+ An ordered list keeps appended values sorted and removes a value range.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("OperateList", "testOperateListOrderedPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ Two configs which only differ in their auth_mode do not share a connection.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testAuthModeSeparateHostPositive");
+--EXPECT--
+OK
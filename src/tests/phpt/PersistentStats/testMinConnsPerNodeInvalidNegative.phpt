@@ -0,0 +1,9 @@
+--TEST--
+ A min_conns_per_node which is not an integer is rejected by the constructor.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testMinConnsPerNodeInvalidNegative");
+--EXPECT--
+ERR_PARAM
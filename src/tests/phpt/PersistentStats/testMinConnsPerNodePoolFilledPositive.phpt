@@ -0,0 +1,9 @@
+--TEST--
+ The pool of each node holds min_conns_per_node connections once the client is connected.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testMinConnsPerNodePoolFilledPositive");
+--EXPECT--
+OK
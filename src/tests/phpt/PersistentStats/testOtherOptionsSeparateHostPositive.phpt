@@ -0,0 +1,9 @@
+--TEST--
+ A client with other options gets a connection of its own.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testOtherOptionsSeparateHostPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ The connection of a persistent client is listed as connected and in use.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testPersistentHostListedPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ A second client with the same config shares the connection of the first one.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testSameConfigSharesHostPositive");
+--EXPECT--
+OK
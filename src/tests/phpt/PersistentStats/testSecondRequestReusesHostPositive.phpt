@@ -0,0 +1,14 @@
+--TEST--
+ A persistent client created in a second request of the same process finds the host the first request left in the list.
+
+--SKIPIF--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_skipif("PersistentStats", "testSecondRequestReusesHostPositive");
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PersistentStats", "testSecondRequestReusesHostPositive");
+--EXPECT--
+OK
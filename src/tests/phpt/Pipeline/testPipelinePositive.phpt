@@ -0,0 +1,11 @@
+--TEST--
+ put, operate, get and remove through a pipeline, results in order.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Pipeline", "testPipelinePositive");
+--EXPECT--
+OK
@@ -0,0 +1,11 @@
+--TEST--
+ A put with an invalid key is refused and not queued.
+
+--INI--
+aerospike.async.event_loops=2
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Pipeline", "testPipelinePutInvalidKeyNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ A profile which is not an array of options is rejected by the constructor.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PolicyProfiles", "testInvalidProfileNegative");
+--EXPECT--
+ERR_PARAM
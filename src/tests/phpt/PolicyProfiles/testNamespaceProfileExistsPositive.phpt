@@ -0,0 +1,9 @@
+--TEST--
+ The namespace profile applies to its sets unless their own profile overrides it.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PolicyProfiles", "testNamespaceProfileExistsPositive");
+--EXPECT--
+OK
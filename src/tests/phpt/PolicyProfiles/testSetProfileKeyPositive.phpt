@@ -0,0 +1,9 @@
+--TEST--
+ The commands on the records of a set with a profile sending the key send it.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PolicyProfiles", "testSetProfileKeyPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ increment() and operate() on the records of a set with a profile sending the key send it, and leave the profile as it was.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PolicyProfiles", "testSetProfileOperatePositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ A prepared query runs again with a new value for its predicate.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PreparedQuery", "testPreparedQueryBindValuePositive");
+--EXPECT--
+OK
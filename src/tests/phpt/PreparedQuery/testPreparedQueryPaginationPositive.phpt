@@ -0,0 +1,9 @@
+--TEST--
+ A prepared query returns its pages through a cursor, and a prepared scan every record.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PreparedQuery", "testPreparedQueryPaginationPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+ Running a prepared query whose predicate has no value, without binding one.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("PreparedQuery", "testPreparedQueryUnboundValueNegative");
+--EXPECT--
+ERR_PARAM
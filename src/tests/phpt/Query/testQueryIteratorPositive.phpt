@@ -0,0 +1,9 @@
+--TEST--
+Query - queryIterator with a between predicate
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Query", "testQueryIteratorPositive");
+--EXPECT--
+OK
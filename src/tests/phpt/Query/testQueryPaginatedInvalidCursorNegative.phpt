@@ -0,0 +1,9 @@
+--TEST--
+Query - paginated query with an invalid cursor
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Query", "testQueryPaginatedInvalidCursorNegative");
+--EXPECT--
+ERR_PARAM
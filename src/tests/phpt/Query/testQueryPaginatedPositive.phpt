@@ -0,0 +1,9 @@
+--TEST--
+Query - query pages through OPT_MAX_RECORDS and a cursor
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Query", "testQueryPaginatedPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+Scan - leaving a scanIterator foreach early
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanIteratorBreakPositive");
+--EXPECT--
+OK
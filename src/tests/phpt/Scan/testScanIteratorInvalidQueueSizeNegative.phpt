@@ -0,0 +1,9 @@
+--TEST--
+Scan - scanIterator with an invalid queue size
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanIteratorInvalidQueueSizeNegative");
+--EXPECT--
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+Scan - scanIterator over a set
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanIteratorPositive");
+--EXPECT--
+OK
@@ -0,0 +1,9 @@
+--TEST--
+Scan - scanPartitions with the cursor of another range
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanPartitionsCursorMismatchNegative");
+--EXPECT--
+ERR_PARAM
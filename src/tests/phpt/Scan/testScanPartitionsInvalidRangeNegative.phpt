@@ -0,0 +1,9 @@
+--TEST--
+Scan - scanPartitions with an invalid partition range
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanPartitionsInvalidRangeNegative");
+--EXPECT--
+ERR_PARAM
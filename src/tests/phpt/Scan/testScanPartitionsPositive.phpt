@@ -0,0 +1,9 @@
+--TEST--
+Scan - scanPartitions over the whole partition range
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanPartitionsPositive");
+--EXPECT--
+OK
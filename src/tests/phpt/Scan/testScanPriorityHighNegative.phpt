@@ -0,0 +1,9 @@
+--TEST--
+Scan - priority other than SCAN_PRIORITY_AUTO is rejected
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("Scan", "testScanPriorityHighNegative");
+--EXPECT--
+ERR_PARAM
@@ -1,9 +1,9 @@
 --TEST--
-ScanApply - Percent is int
+ScanApply - Percent other than 100 is rejected
 
 --FILE--
 <?php
 include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
 aerospike_phpt_runtest("ScanApply", "testScanApplyPercentIsInt");
 --EXPECT--
-OK
+ERR_PARAM
@@ -0,0 +1,9 @@
+--TEST--
+ query() applies the read operations to the records matching its predicate.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ScanReadOperations", "testQueryListGetRangePositive");
+--EXPECT--
+OK
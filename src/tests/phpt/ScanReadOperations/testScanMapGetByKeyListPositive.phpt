@@ -0,0 +1,9 @@
+--TEST--
+ scan() returns the results of the read operations instead of the bins.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ScanReadOperations", "testScanMapGetByKeyListPositive");
+--EXPECT--
+OK
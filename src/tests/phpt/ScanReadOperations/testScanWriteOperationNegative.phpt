@@ -0,0 +1,9 @@
+--TEST--
+ scan() refuses write operations in OPT_READ_OPERATIONS.
+
+--FILE--
+<?php
+include dirname(__FILE__)."/../../astestframework/astest-phpt-loader.inc";
+aerospike_phpt_runtest("ScanReadOperations", "testScanWriteOperationNegative");
+--EXPECT--
+ERR_PARAM
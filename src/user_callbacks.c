@@ -1,5 +1,9 @@
 #include "user_callbacks.h"
 #include "conversions.h"
+#include "php_aerospike_types.h"
+
+static bool user_callback_wrapper(const as_val* val, void* udata);
+static as_status execute_user_callback_on_queue(as_php_record_stream* stream, user_callback_function* callback_info);
 
 as_status execute_user_callback(as_record* record, user_callback_function* callback) {
 
@@ -29,31 +33,117 @@ as_status execute_user_callback(as_record* record, user_callback_function* callb
 	return AEROSPIKE_OK;
 }
 
-bool user_callback_wrapper(const as_val *val, void *udata) {
+/*
+ * Run the scan or query of stream, calling the callback on each of its records. Returning false
+ * from the callback cancels the rest of it. The C client calls back directly, unless the records
+ * have to be queued for the calling PHP thread, see as_php_record_stream_needs_thread.
+ */
+as_status execute_user_callback_on_stream(as_php_record_stream* stream, user_callback_function* callback_info) {
+	as_error err;
+
+	callback_info->stopped = false;
+
+	if (as_php_record_stream_needs_thread(stream)) {
+		return execute_user_callback_on_queue(stream, callback_info);
+	}
+
+	as_error_init(&err);
+	pthread_mutex_init(&callback_info->lock, NULL);
+
+	as_php_record_stream_run(stream, user_callback_wrapper, callback_info, &err);
+
+	pthread_mutex_destroy(&callback_info->lock);
+
+	/* An error of the callback wins, stopping it early is not an error */
+	if (callback_info->err->code == AEROSPIKE_OK && !callback_info->stopped) {
+		as_error_copy(callback_info->err, &err);
+	}
+	deliver_pending_log_events();
+	return callback_info->err->code;
+}
+
+/* Called by the C client for each record, from several node threads at once in concurrent scans */
+static bool user_callback_wrapper(const as_val* val, void* udata) {
+	user_callback_function* callback_info = (user_callback_function*)udata;
+	as_record* record = NULL;
+	bool more = true;
 	zval retval;
-	ZVAL_NULL(&retval);
+
+	/* The end of the scan or query */
 	if (!val) {
 		return false;
 	}
-	as_record* record = as_record_fromval(val);
-	user_callback_function* callback_info = (user_callback_function*)udata;
+	record = as_record_fromval(val);
+
+	pthread_mutex_lock(&callback_info->lock);
+	if (callback_info->stopped || callback_info->err->code != AEROSPIKE_OK) {
+		pthread_mutex_unlock(&callback_info->lock);
+		return false;
+	}
+
+	deliver_pending_log_events();
 
-	pthread_mutex_lock(callback_info->cb_mutex);
+	ZVAL_NULL(&retval);
 	callback_info->callback.retval = &retval;
 
 	if (execute_user_callback(record, callback_info) != AEROSPIKE_OK) {
 		as_error_update(callback_info->err, AEROSPIKE_ERR_PARAM, "Callback raised an error");
-		pthread_mutex_unlock(callback_info->cb_mutex);
-		return false;
+		more = false;
+	} else {
+		if (callback_info->cursor) {
+			as_php_scan_cursor_record(callback_info->cursor, &record->key.digest);
+		}
+		if (Z_TYPE(retval) == IS_FALSE) {
+			callback_info->stopped = true;
+			more = false;
+		}
 	}
+	zval_dtor(&retval);
 
-	if (callback_info->callback.retval &&
-			Z_TYPE_P(callback_info->callback.retval) == IS_FALSE) {
-		pthread_mutex_unlock(callback_info->cb_mutex);
-		return false;
+	pthread_mutex_unlock(&callback_info->lock);
+	return more;
+}
+
+/*
+ * Start stream and run the callback on each of its records. The node threads only queue the
+ * records, the callback always runs on the calling PHP thread.
+ */
+static as_status execute_user_callback_on_queue(as_php_record_stream* stream, user_callback_function* callback_info) {
+	as_record* record = NULL;
+	as_status status = AEROSPIKE_OK;
+	zval retval;
+
+	if (as_php_record_stream_start(stream, callback_info->err) != AEROSPIKE_OK) {
+		return callback_info->err->code;
 	}
 
-	zval_dtor(&retval);
-	pthread_mutex_unlock(callback_info->cb_mutex);
-	return true;
+	while ((record = (as_record*)as_php_record_stream_next(stream, callback_info->err))) {
+		/* The node threads keep logging while a long scan runs */
+		deliver_pending_log_events();
+
+		ZVAL_NULL(&retval);
+		callback_info->callback.retval = &retval;
+
+		status = execute_user_callback(record, callback_info);
+		if (status == AEROSPIKE_OK && callback_info->cursor) {
+			as_php_scan_cursor_record(callback_info->cursor, &record->key.digest);
+		}
+		as_record_destroy(record);
+
+		if (status != AEROSPIKE_OK) {
+			as_error_update(callback_info->err, AEROSPIKE_ERR_PARAM, "Callback raised an error");
+			zval_dtor(&retval);
+			break;
+		}
+
+		if (Z_TYPE(retval) == IS_FALSE) {
+			callback_info->stopped = true;
+			break;
+		}
+		zval_dtor(&retval);
+	}
+
+	as_php_record_stream_stop(stream);
+	deliver_pending_log_events();
+	return callback_info->err->code;
 }